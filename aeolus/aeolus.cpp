@@ -186,6 +186,18 @@ void Aeolus::allNotesOff(int)
             _keymap[i] = 0x80;
       }
 
+//---------------------------------------------------------
+//   waitReady
+//    wait for the rank generators; the ranks are installed
+//    by the next process() call
+//---------------------------------------------------------
+
+void Aeolus::waitReady()
+      {
+      if (model)
+            model->wait_ranks();
+      }
+
 //---------------------------------------------------------
 //   getPatchInfo
 //---------------------------------------------------------
@@ -125,6 +125,7 @@ class Aeolus : public Synthesizer {
       virtual void allNotesOff(int /*channel*/);
 
       virtual SynthesizerGui* gui();
+      virtual void waitReady();
 
       friend class Model;
       };
@@ -132,6 +132,95 @@ void Asection::process (float vol, float *W, float *X, float *Y, float *R)
             }
 
       gr = vol * _apar [REFLECT].fval();
+
+      // the diffusers are longer than a period: collect the
+      // reflections for the whole period, then diffuse them
+      float a0[PERIOD], a1[PERIOD], a2[PERIOD], a3[PERIOD];
+      const float* r[16];
+      for (int i = 0; i < 16; i++)
+            r[i] = _base + _offs[i];
+      for (int i = 0; i < PERIOD; i++) {
+            a0[i] = r[1][i] + r[5][i] + r[11][i] + r[15][i] + 1e-20f;
+            a1[i] = r[0][i] + r[4][i] + r[10][i] + r[14][i] + 1e-20f;
+            a2[i] = r[2][i] + r[6][i] +  r[8][i] + r[12][i] + 2e-20f;
+            a3[i] = r[3][i] + r[7][i] +  r[9][i] + r[13][i] + 2e-20f;
+            }
+      _dif0.process (PERIOD, a0);
+      _dif1.process (PERIOD, a1);
+      _dif2.process (PERIOD, a2);
+      _dif3.process (PERIOD, a3);
+
+      for (int i = 0; i < PERIOD; i++) {
+            float t0 = a0[i];
+            float t1 = a1[i];
+            float t2 = a2[i];
+            float t3 = a3[i];
+            s = t0 + t1 + t2 + t3;
+            _sw += 0.5f * (s - _sw);
+            _sx += 0.5f * (0.4f * (t0 + t3) + 0.6f * (t2 + t1) - _sx);
+            _sy += 0.5f * (0.9f * (t0 - t3) + 0.8f * (t2 - t1) - _sy);
+            W [i] += gr * _sw;
+            x [i] += gr * _sx;
+            y [i] += gr * _sy;
+            }
+
+      g = 6.283184f * _apar [AZIMUTH].fval();
+      gx1 = cosf (g);
+      gy1 = sinf (g);
+      for (int i = 0; i < PERIOD; i++) {
+            X [i] += gx1 * x [i] + gy1 * y [i];
+            Y [i] += gx1 * y [i] - gy1 * x [i];
+            }
+      _offs0 = (_offs0 + PERIOD) & (N - 1);
+      for (int i = 0; i < 16; i++)
+            _offs [i] = ((_offs [i] + PERIOD) & (N - 1)) + (i >> 2) * N;
+      p = _base + _offs0;
+      memset(p + 0 * N, 0, PERIOD * sizeof(float));
+      memset(p + 1 * N, 0, PERIOD * sizeof(float));
+      memset(p + 2 * N, 0, PERIOD * sizeof(float));
+      memset(p + 3 * N, 0, PERIOD * sizeof(float));
+      }
+
+//---------------------------------------------------------
+//   processReference
+//    per sample implementation of process(), kept as
+//    reference for the block diffusers
+//---------------------------------------------------------
+
+void Asection::processReference (float vol, float *W, float *X, float *Y, float *R)
+      {
+      float x[PERIOD];
+      float y[PERIOD];
+
+      float gw = vol * _apar [DIRECT].fval();
+      float g = 0.45f * _apar [STWIDTH].fval();
+      float s = 0.5f + g * (1 - g);
+      float d = g - 0.5f;
+      float gx1 = gw * (s - d);
+      float gy1 = gw * (s + d);
+      g = 0.25f * _apar [STWIDTH].fval();
+      s = 0.5f + g * (1 - g);
+      d = g - 0.5f;
+      float gx2 = gw * (s - d);
+      float gy2 = gw * (s + d);
+      float* p = _base + _offs0;
+      float gr = 0.5f * _apar [REVERB].fval();
+
+      for (int i = 0; i < PERIOD; i++) {
+            float t0 = p [0 * N];
+            float t1 = p [1 * N];
+            float t2 = p [2 * N];
+            float t3 = p [3 * N];
+            p++;
+            s = t0 + t1 + t2 + t3;
+            R [i] += gr * s;
+            W [i] += gw * s;
+            x [i] = gx1 * (t3 + t0) + gx2 * (t2 + t1);
+            y [i] = gy1 * (t3 - t0) + gy2 * (t2 - t1);
+            }
+
+      gr = vol * _apar [REFLECT].fval();
+
       p = _base;
 
       for (int i = 0; i < PERIOD; i++) {
@@ -51,6 +51,23 @@ class Diffuser {
                   _i = 0;
             return x;
             }
+      // block version, requires n <= _size
+      void process(int n, float* x) {
+            while (n) {
+                  int m = qMin(n, _size - _i);
+                  float* d = _data + _i;
+                  for (int k = 0; k < m; ++k) {
+                        float w = x[k] - _c * d[k];
+                        x[k] = d[k] + _c * w;
+                        d[k] = w;
+                        }
+                  x  += m;
+                  n  -= m;
+                  _i += m;
+                  if (_i == _size)
+                        _i = 0;
+                  }
+            }
       };
 
 //---------------------------------------------------------
@@ -81,6 +98,7 @@ class Asection {
       SyntiParameter *get_apar () { return _apar; }
       void set_size (float size);
       void process (float vol, float *W, float *X, float *Y, float *R);
+      void processReference (float vol, float *W, float *X, float *Y, float *R);
 
       static float _refl [16];
       };
@@ -142,6 +142,9 @@ void Aeolus::process(unsigned nframes, float* out, float*, float*)
       {
       float gain = 1.0;
 
+      for (int d = 0; d < _ndivis; d++)
+            _divisp[d]->install_ranks();
+
       for (int n = 0; n < NNOTES; n++) {
             int m = _keymap[n];
             if (m & 128) {
@@ -36,12 +36,25 @@ Division::Division (Asection *asect, float fsam)
     _s (0.0f),
     _m (0.0f)
       {
-      for (int i = 0; i < NRANKS; i++)
-            _ranks [i] = 0;
+      for (int i = 0; i < NRANKS; i++) {
+            _ranks [i]   = 0;
+            _pmask [i]   = 0;
+            _ppan [i]    = 0;
+            _pdel [i]    = 0;
+            _pending [i] = 0;
+            _pgen [i]    = 0;
+            }
+      _rhead = 0;
+      _rtail = 0;
       }
 
 Division::~Division()
       {
+      free_ranks ();
+      for (int i = 0; i < NRANKS; i++) {
+            delete _ranks [i];
+            delete _pending [i].exchange (0);
+            }
       }
 
 //---------------------------------------------------------
@@ -51,8 +64,10 @@ Division::~Division()
 void Division::process()
       {
       memset (_buff, 0, NCHANN * PERIOD * sizeof (float));
-      for (int i = 0; i < _nrank; i++)
-            _ranks [i]->play (1);
+      for (int i = 0; i < _nrank; i++) {
+            if (_ranks [i])
+                  _ranks [i]->play (1);
+            }
 
       float g = _swel;
       if (_trem) {
@@ -98,8 +113,19 @@ void Division::set_rank (int ind, Rankwave *W, int pan, int del)
     Rankwave *C;
 
     C = _ranks [ind];
-    if (C) { W->_nmask = C->_cmask; delete C; }
-    else W->_nmask = 0;
+    if (C) {
+        W->_nmask = C->_cmask;
+        // called from the audio thread: the replaced rank is
+        // deleted by free_ranks() on a rank generator thread
+        int h = _rhead.load (std::memory_order_relaxed);
+        int n = (h + 1) % NRETIRED;
+        if (n != _rtail.load (std::memory_order_acquire)) {
+            _retired [h] = C;
+            _rhead.store (n, std::memory_order_release);
+        }
+        else delete C;      // not reached: the ring is drained before every post_rank()
+    }
+    else W->_nmask = _pmask [ind];
     W->_cmask = 0;
     _ranks [ind] = W;
     del = (int)(1e-3f * del * _fsam / PERIOD);
@@ -109,6 +135,60 @@ void Division::set_rank (int ind, Rankwave *W, int pan, int del)
 }
 
 
+//---------------------------------------------------------
+//   post_rank
+//    Called by a rank generator thread when a rank is ready.
+//    The rank is installed by the audio thread in
+//    install_ranks(). Results of outdated requests are
+//    dropped.
+//---------------------------------------------------------
+
+void Division::post_rank (int ind, Rankwave *W, int pan, int del, int gen)
+      {
+      free_ranks ();
+      if (gen != _pgen [ind]) {
+            delete W;
+            return;
+            }
+      _ppan [ind] = pan;
+      _pdel [ind] = del;
+      delete _pending [ind].exchange (W, std::memory_order_acq_rel);
+      }
+
+//---------------------------------------------------------
+//   free_ranks
+//    delete the ranks replaced by install_ranks(); never
+//    called from the audio thread
+//---------------------------------------------------------
+
+void Division::free_ranks ()
+      {
+      QMutexLocker locker (&_rlock);
+      int t = _rtail.load (std::memory_order_relaxed);
+      int h = _rhead.load (std::memory_order_acquire);
+      while (t != h) {
+            delete _retired [t];
+            t = (t + 1) % NRETIRED;
+            }
+      _rtail.store (t, std::memory_order_release);
+      }
+
+//---------------------------------------------------------
+//   install_ranks
+//    swap finished ranks in; called from the audio thread
+//---------------------------------------------------------
+
+void Division::install_ranks ()
+      {
+      for (int r = 0; r < NRANKS; r++) {
+            if (!_pending [r].load (std::memory_order_relaxed))
+                  continue;
+            Rankwave* W = _pending [r].exchange (0, std::memory_order_acq_rel);
+            if (W)
+                  set_rank (r, W, _ppan [r], _pdel [r]);
+            }
+      }
+
 //---------------------------------------------------------
 //   update
 //---------------------------------------------------------
@@ -117,6 +197,8 @@ void Division::update (int note, int mask)
       {
       for (int r = 0; r < _nrank; r++) {
             Rankwave* W = _ranks [r];
+            if (!W)
+                  continue;
             if (W->_cmask & 0x7f) {
                   if (mask & W->_cmask)
                         W->note_on (note + 36);
@@ -130,6 +212,8 @@ void Division::update (unsigned char *keys)
       {
       for (int r = 0; r < _nrank; r++) {
             Rankwave* W = _ranks [r];
+            if (!W)
+                  continue;
 
             if ((W->_cmask ^ W->_nmask) & 0x7f) {
                   int m = W->_nmask & 127;
@@ -163,10 +247,11 @@ void Division::set_div_mask (int bits)
 
     bits &= 127;
     _dmask |= bits;
-    for (r = 0; r < _nrank; r++)
+    for (r = 0; r < NRANKS; r++)
     {
 	W = _ranks [r];
-        if (W->_nmask & 128) W->_nmask |= bits;
+        if (!W) { if (_pmask [r] & 128) _pmask [r] |= bits; }
+        else if (W->_nmask & 128) W->_nmask |= bits;
     }
 }
 
@@ -178,10 +263,11 @@ void Division::clr_div_mask (int bits)
 
     bits &= 127;
     _dmask &= ~bits;
-    for (r = 0; r < _nrank; r++)
+    for (r = 0; r < NRANKS; r++)
     {
 	W = _ranks [r];
-        if (W->_nmask & 128) W->_nmask &= ~bits;
+        if (!W) { if (_pmask [r] & 128) _pmask [r] &= ~bits; }
+        else if (W->_nmask & 128) W->_nmask &= ~bits;
     }
 }
 
@@ -192,7 +278,10 @@ void Division::set_rank_mask (int ind, int bits)
 
       if (bits == 128)
             bits |= _dmask;
-      W->_nmask |= bits;
+      if (W)
+            W->_nmask |= bits;
+      else
+            _pmask [ind] |= bits;
       }
 
 
@@ -202,6 +291,9 @@ void Division::clr_rank_mask (int ind, int bits)
 
       if (bits == 128)
             bits |= _dmask;
-      W->_nmask &= ~bits;
+      if (W)
+            W->_nmask &= ~bits;
+      else
+            _pmask [ind] &= ~bits;
       }
 
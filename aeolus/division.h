@@ -20,6 +20,8 @@
 #ifndef __DIVISION_H
 #define __DIVISION_H
 
+#include <atomic>
+
 #include "asection.h"
 #include "rankwave.h"
 
@@ -31,6 +33,16 @@ class Division
       {
       Asection  *_asect;
       Rankwave  *_ranks [NRANKS];
+      int        _pmask [NRANKS];       // rank masks of ranks not generated yet
+      int        _ppan [NRANKS];
+      int        _pdel [NRANKS];
+      std::atomic<Rankwave*> _pending [NRANKS];  // generated, not yet installed
+      std::atomic<int>       _pgen [NRANKS];     // generation of the last request
+      enum { NRETIRED = 4 * NRANKS };
+      Rankwave  *_retired [NRETIRED];   // replaced ranks, deleted by free_ranks()
+      std::atomic<int> _rhead;          // written by the audio thread only
+      std::atomic<int> _rtail;          // written by free_ranks() only
+      QMutex     _rlock;                // serializes free_ranks()
       int        _nrank;
       int        _dmask;
       int        _trem;
@@ -48,6 +60,11 @@ class Division
       ~Division ();
 
       void set_rank (int ind, Rankwave *W, int pan, int del);
+      void set_rank_generation (int ind, int gen) { _pgen [ind] = gen; }
+      int  rank_generation (int ind) const        { return _pgen [ind]; }
+      void post_rank (int ind, Rankwave *W, int pan, int del, int gen);
+      void install_ranks ();
+      void free_ranks ();
       void set_swell (float stat)   { _swel = 0.2 + 0.8 * stat * stat; }
       void set_tfreq (float freq)   { _w = 6.283184f * PERIOD * freq / _fsam; }
       void set_tmodd (float modd)   { _m = modd; }
@@ -80,6 +80,17 @@ Model::Model (Aeolus* a,
       _waves = waves;
       memset (_midimap, 0, 16 * sizeof (uint16_t));
       memset (_preset, 0, NBANK * NPRES * sizeof (Preset *));
+      _pool = new QThreadPool;
+      }
+
+//---------------------------------------------------------
+//   ~Model
+//---------------------------------------------------------
+
+Model::~Model()
+      {
+      _pool->waitForDone();
+      delete _pool;
       }
 
 //---------------------------------------------------------
@@ -106,7 +117,6 @@ void Model::init()
 
       init_iface();
       init_ranks(MT_LOAD_RANK);
-      init_ranks(MT_SAVE_RANK);
       }
 
 //---------------------------------------------------------
@@ -156,6 +166,47 @@ void Model::init_iface()
       set_mconf (0, _chconf[0]._bits);
       }
 
+//---------------------------------------------------------
+//   RankJob
+//    Load a rank from the wave cache or generate it,
+//    then hand it over to the division. Runs on the
+//    rank generator thread pool.
+//---------------------------------------------------------
+
+class RankJob : public QRunnable {
+      M_def_rank* _m;
+      Division* _division;
+      int _gen;
+
+   public:
+      RankJob(M_def_rank* m, Division* d, int gen) : _m(m), _division(d), _gen(gen) {}
+      ~RankJob() { delete _m; }
+      virtual void run();
+      };
+
+void RankJob::run()
+      {
+      M_def_rank* M = _m;
+      if (_division->rank_generation(M->_rank) != _gen)     // superseded by a newer request
+            return;
+      Rankwave* W = new Rankwave (M->_sdef->_n0, M->_sdef->_n1);
+      if (W->load (M->_path, M->_sdef, M->_fsamp, M->_fbase, M->_scale)) {
+            // every rank gets its own random sequence; the ranks are
+            // generated concurrently and in no particular order
+            uint32_t seed = (uint32_t)(time (0) ^ ((M->_divis * NRANKS + M->_rank + 1) * 0x9e3779b9u));
+            W->gen_waves (M->_sdef, M->_fsamp, M->_fbase, M->_scale, seed ? seed : 1);
+            W->save (M->_path, M->_sdef, M->_fsamp, M->_fbase, M->_scale);
+            }
+      _division->post_rank (M->_rank, W, M->_sdef->_pan, M->_sdef->_del, _gen);
+      }
+
+//---------------------------------------------------------
+//   init_ranks
+//    Start (re)generation of all ranks. The ranks are
+//    swapped into the divisions one by one as they become
+//    ready.
+//---------------------------------------------------------
+
 void Model::init_ranks (int comm)
       {
       _count++;
@@ -179,10 +230,7 @@ void Model::proc_rank (int g, int i, int comm)
             int r = (I->_action0 >>  8) & 255;
             Rank* R = _divis [d]._ranks + r;
             if (comm == MT_SAVE_RANK) {
-                  if (R->_wave->modif ()) {
-                        R->_wave->save(_waves, R->_sdef, _aeolus->_fsamp,
-                           _fbase, scales[_itemp]._data);
-                        }
+                  // generated waves are saved by the rank generator
                   }
             else if (R->_count != _count) {
                   R->_count = _count;
@@ -195,17 +243,14 @@ void Model::proc_rank (int g, int i, int comm)
                   M->_fbase = _fbase;
                   M->_scale = scales [_itemp]._data;
                   M->_sdef  = R->_sdef;
-                  M->_wave  = R->_wave;
+                  M->_wave  = 0;
                   M->_path  = _waves;
 
 //WS                  send_event(TO_IFACE, new M_ifc_ifelm (MT_IFC_ELATT, M->_group, M->_ifelm));
 
-                  M->_wave = new Rankwave (M->_sdef->_n0, M->_sdef->_n1);
-                  if (M->_wave->load (M->_path, M->_sdef, M->_fsamp, M->_fbase, M->_scale))
-                        M->_wave->gen_waves (M->_sdef, M->_fsamp, M->_fbase, M->_scale);
-
-                  _aeolus->_divisp [M->_divis]->set_rank (M->_rank, M->_wave,  M->_sdef->_pan, M->_sdef->_del);
-                  _divis [M->_divis]._ranks [M->_rank]._wave = M->_wave;
+                  Division* D = _aeolus->_divisp [M->_divis];
+                  D->set_rank_generation (M->_rank, _count);
+                  _pool->start (new RankJob (M, D, _count));
                   }
             }
       }
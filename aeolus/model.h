@@ -165,6 +165,7 @@ class Model
       int             _sc_group; // stop control group number
       Chconf          _chconf [8];
       Preset*         _preset [NBANK][NPRES];
+      QThreadPool*    _pool;      // rank generators
 
       void init_audio();
       void init_iface();
@@ -191,11 +192,12 @@ class Model
       Model (Aeolus* aeolus, uint16_t* midimap, const char* stops,
          const char* instr, const char* waves);
 
-      virtual ~Model() {}
+      virtual ~Model();
 
       void set_ifelm (int g, int i, int m);
       void clr_group (int g);
       void init ();
+      void wait_ranks ()            { _pool->waitForDone(); }
       };
 
 #endif
@@ -24,18 +24,6 @@ extern float exp2ap (float);
 
 
 Rngen   Pipewave::_rgen;
-float  *Pipewave::_arg = 0;
-float  *Pipewave::_att = 0;
-
-void Pipewave::initstatic(float fsamp)
-      {
-      if (_arg)
-            return;
-      int k = (int)(fsamp);
-      _arg  = new float [k];
-      k     = (int)(0.5f * fsamp);
-      _att  = new float [k];
-      }
 
 //---------------------------------------------------------
 //   play
@@ -179,7 +167,14 @@ void Pipewave::play()
 }
 
 
-void Pipewave::genwave (Addsynth *D, int n, float fsamp, float fpipe)
+//---------------------------------------------------------
+//   genwave
+//    arg, att and rgen are owned by the caller so that
+//    several ranks can be generated concurrently
+//---------------------------------------------------------
+
+void Pipewave::genwave (Addsynth *D, int n, float fsamp, float fpipe,
+   float *arg, float *att, Rngen *rgen)
 {
     int    h, i, k, nc;
     float  f0, f1, f, m, t, v, v0;
@@ -193,7 +188,7 @@ void Pipewave::genwave (Addsynth *D, int n, float fsamp, float fpipe)
     _l0 = (int)(fsamp * m + 0.5);
     _l0 = (_l0 + PERIOD - 1) & ~(PERIOD - 1);
 
-    f1 = (fpipe + D->_n_off.vi (n) + D->_n_ran.vi (n) * (2 * _rgen.urand () - 1)) / fsamp;
+    f1 = (fpipe + D->_n_off.vi (n) + D->_n_ran.vi (n) * (2 * rgen->urand () - 1)) / fsamp;
     f0 = f1 * exp2ap (D->_n_atd.vi (n) / 1200.0f);
 
     for (h = N_HARM - 1; h >= 0; h--)
@@ -230,14 +225,14 @@ void Pipewave::genwave (Addsynth *D, int n, float fsamp, float fpipe)
     k = (int)(fsamp * D->_n_att.vi (n) + 0.5);
     for (i = 0; i <= _l0; i++)
     {
-        _arg [i] = t - floorf (t + 0.5);
+        arg [i] = t - floorf (t + 0.5);
 	t += (i < k) ? (((k - i) * f0 + i * f1) / k) : f1;
     }
 
     for (i = 1; i < _l1; i++)
     {
-	t = _arg [_l0]+ (float) i * nc / _l1;
-        _arg [i + _l0] = t - floorf (t + 0.5);
+	t = arg [_l0]+ (float) i * nc / _l1;
+        arg [i + _l0] = t - floorf (t + 0.5);
     }
 
     v0 = exp2ap (0.1661 * D->_n_vol.vi (n));
@@ -247,16 +242,16 @@ void Pipewave::genwave (Addsynth *D, int n, float fsamp, float fpipe)
         v = D->_h_lev.vi (h, n);
         if (v < -80.0) continue;
 
-        v = v0 * exp2ap (0.1661 * (v + D->_h_ran.vi (h, n) * (2 * _rgen.urand () - 1)));
+        v = v0 * exp2ap (0.1661 * (v + D->_h_ran.vi (h, n) * (2 * rgen->urand () - 1)));
         k = (int)(fsamp * D->_h_att.vi (h, n) + 0.5);
-        attgain (k, D->_h_atp.vi (h, n));
+        attgain (k, D->_h_atp.vi (h, n), att);
 
         for (i = 0; i < _l0 + _l1; i++)
         {
-	    t = _arg [i] * (h + 1);
+	    t = arg [i] * (h + 1);
             t -= floorf (t);
             m = v * sinf (2 * M_PI * t);
-            if (i < k) m *= _att [i];
+            if (i < k) m *= att [i];
             _p0 [i] += m;
         }
     }
@@ -307,7 +302,7 @@ void Pipewave::looplen (float f, float fsamp, int lmax, int *aa, int *bb)
 }
 
 
-void Pipewave::attgain (int n, float p)
+void Pipewave::attgain (int n, float p, float *att)
 {
     int    i, j, k;
     float  d, m, w, x, y, z;
@@ -327,7 +322,7 @@ void Pipewave::attgain (int n, float p)
         while (j < k)
 	{
             m = (double) j / n;
-            _att [j++] = (1.0 - m) * z + m;
+            att [j++] = (1.0 - m) * z + m;
             z += d;
 	}
     }
@@ -398,15 +393,28 @@ Rankwave::~Rankwave (void)
 }
 
 
-void Rankwave::gen_waves (Addsynth *D, float fsamp, float fbase, float *scale)
+//---------------------------------------------------------
+//   gen_waves
+//    seed must differ between ranks, or all ranks get the
+//    same random detune and levels
+//---------------------------------------------------------
+
+void Rankwave::gen_waves (Addsynth *D, float fsamp, float fbase, float *scale, uint32_t seed)
 {
-    Pipewave::initstatic (fsamp);
+    float *arg = new float [(int)(fsamp)];
+    float *att = new float [(int)(0.5f * fsamp)];
+    Rngen  rgen;
+
+    rgen.init (seed);
 
     fbase *=  D->_fn / (D->_fd * scale [9]);
     for (int i = _n0; i <= _n1; i++)
     {
-	_pipes [i - _n0].genwave (D, i - _n0, fsamp, ldexpf (fbase * scale [i % 12], i / 12 - 5));
+	_pipes [i - _n0].genwave (D, i - _n0, fsamp, ldexpf (fbase * scale [i % 12], i / 12 - 5),
+           arg, att, &rgen);
     }
+    delete[] arg;
+    delete[] att;
     _modif = true;
 }
 
@@ -446,6 +454,32 @@ void Rankwave::play (int shift)
 }
 
 
+//---------------------------------------------------------
+//   wavefile
+//    The cache file name is derived from the stop file name
+//    and a hash of the stop definition, sample rate, tuning
+//    and temperament, so waves for several tunings can be
+//    kept side by side.
+//---------------------------------------------------------
+
+void Rankwave::wavefile (char *name, const char *path, Addsynth *D, float fsamp, float fbase, float *scale)
+{
+    QCryptographicHash h (QCryptographicHash::Md5);
+    h.addData ((const char *) &D->_n0, (const char *) &D->_pan - (const char *) &D->_n0);
+    h.addData (&D->_pan, 1);
+    h.addData ((const char *) &D->_del, sizeof (D->_del));
+    h.addData ((const char *) &fsamp, sizeof (float));
+    h.addData ((const char *) &fbase, sizeof (float));
+    h.addData ((const char *) scale, 12 * sizeof (float));
+    QByteArray key = h.result ().toHex ().left (16);
+
+    char *p;
+    sprintf (name, "%s/%s", path, D->_filename);
+    if ((p = strrchr (name, '.'))) *p = 0;
+    sprintf (name + strlen (name), "-%s.ae1", key.constData ());
+}
+
+
 int Rankwave::save (const char *path, Addsynth *D, float fsamp, float fbase, float *scale)
 {
     FILE      *F;
@@ -453,16 +487,18 @@ int Rankwave::save (const char *path, Addsynth *D, float fsamp, float fbase, flo
     int        i;
     char       name [1024];
     char       data [64];
-    char      *p;
 
-    sprintf (name, "%s/%s", path, D->_filename);
-    if ((p = strrchr (name, '.'))) strcpy (p, ".ae1");
-    else strcat (name, ".ae1");
+    char       temp [1040];
 
-    F = fopen (name, "wb");
+    // write to a temporary file first: the waves may be read by
+    // another rank generator while this one is still writing
+    wavefile (name, path, D, fsamp, fbase, scale);
+    sprintf (temp, "%s.%p", name, (void *) this);
+
+    F = fopen (temp, "wb");
     if (F == NULL)
     {
-	fprintf (stderr, "Can't open waveform file '%s' for writing\n", name);
+	fprintf (stderr, "Can't open waveform file '%s' for writing\n", temp);
         return 1;
     }
 
@@ -488,6 +524,9 @@ int Rankwave::save (const char *path, Addsynth *D, float fsamp, float fbase, flo
     for (i = _n0, P = _pipes; i <= _n1; i++, P++) P->save (F);
 
     fclose (F);
+    QFile::remove (name);
+    if (!QFile::rename (temp, name))
+        QFile::remove (temp);
 
     _modif = false;
     return 0;
@@ -501,12 +540,9 @@ int Rankwave::load (const char *path, Addsynth *D, float fsamp, float fbase, flo
     int        i;
     char       name [1024];
     char       data [64];
-    char      *p;
     float      f;
 
-    sprintf (name, "%s/%s", path, D->_filename);
-    if ((p = strrchr (name, '.'))) strcpy (p, ".ae1");
-    else strcat (name, ".ae1");
+    wavefile (name, path, D, fsamp, fbase, scale);
 
     F = fopen (name, "rb");
     if (F == NULL)
@@ -17,6 +17,9 @@
 // -----------------------------------------------------------------------
 
 #include <math.h>
+#ifdef __SSE__
+#include <xmmintrin.h>
+#endif
 #include "zita.h"
 
 namespace Ms {
@@ -284,6 +287,55 @@ void Vdelay::fini ()
       _line = 0;
       }
 
+//---------------------------------------------------------
+//   Delay block read/write
+//---------------------------------------------------------
+
+void Delay::read (int n, float* out) const
+      {
+      int m = qMin(n, _size - _i);
+      memcpy (out, _line + _i, m * sizeof (float));
+      if (m < n)
+            memcpy (out + m, _line, (n - m) * sizeof (float));
+      }
+
+void Delay::write (int n, const float* in)
+      {
+      int m = qMin(n, _size - _i);
+      memcpy (_line + _i, in, m * sizeof (float));
+      if (m < n)
+            memcpy (_line, in + m, (n - m) * sizeof (float));
+      _i += n;
+      if (_i >= _size)
+            _i -= _size;
+      }
+
+//---------------------------------------------------------
+//   Vdelay block read/write
+//---------------------------------------------------------
+
+void Vdelay::read (int n, float* out)
+      {
+      int m = qMin(n, _size - _ir);
+      memcpy (out, _line + _ir, m * sizeof (float));
+      if (m < n)
+            memcpy (out + m, _line, (n - m) * sizeof (float));
+      _ir += n;
+      if (_ir >= _size)
+            _ir -= _size;
+      }
+
+void Vdelay::write (int n, const float* in)
+      {
+      int m = qMin(n, _size - _iw);
+      memcpy (_line + _iw, in, m * sizeof (float));
+      if (m < n)
+            memcpy (_line, in + m, (n - m) * sizeof (float));
+      _iw += n;
+      if (_iw >= _size)
+            _iw -= _size;
+      }
+
 void Vdelay::set_delay (int del)
       {
       _ir = _iw - del;
@@ -422,6 +474,190 @@ void ZitaReverb::process (int nfram, float* inp, float* out)
       {
       prepare(2048);
 
+      for (int i = 0; i < nfram; i += BLOCK) {
+            int n = qMin(int(BLOCK), nfram - i);
+            processBlock(n, inp + i * 2, out + i * 2);
+            }
+      _pareq1.process (nfram, out);
+      _pareq2.process (nfram, out);
+
+      for (int i = 0; i < nfram; i++) {
+            *out++ += _g0 * *inp++;
+            *out++ += _g0 * *inp++;
+            _g0 += _d0;
+            }
+      }
+
+//---------------------------------------------------------
+//   hadamard
+//    8 point Hadamard transform; works on floats and,
+//    with SSE, on four frames at once
+//---------------------------------------------------------
+
+template <typename T> static inline void hadamard(T* x)
+      {
+      T t;
+      t = x[0] - x[1]; x[0] = x[0] + x[1]; x[1] = t;
+      t = x[2] - x[3]; x[2] = x[2] + x[3]; x[3] = t;
+      t = x[4] - x[5]; x[4] = x[4] + x[5]; x[5] = t;
+      t = x[6] - x[7]; x[6] = x[6] + x[7]; x[7] = t;
+      t = x[0] - x[2]; x[0] = x[0] + x[2]; x[2] = t;
+      t = x[1] - x[3]; x[1] = x[1] + x[3]; x[3] = t;
+      t = x[4] - x[6]; x[4] = x[4] + x[6]; x[6] = t;
+      t = x[5] - x[7]; x[5] = x[5] + x[7]; x[7] = t;
+      t = x[0] - x[4]; x[0] = x[0] + x[4]; x[4] = t;
+      t = x[1] - x[5]; x[1] = x[1] + x[5]; x[5] = t;
+      t = x[2] - x[6]; x[2] = x[2] + x[6]; x[6] = t;
+      t = x[3] - x[7]; x[3] = x[3] + x[7]; x[7] = t;
+      }
+
+//---------------------------------------------------------
+//   processBlock
+//    Run the feedback delay network on n <= BLOCK frames.
+//    Every delay line is longer than a block, so each
+//    stage can run over the whole block before the next
+//    one. The lines are kept in separate arrays (x[line][frame])
+//    so that the delays and diffusers work on contiguous
+//    memory and the mixing matrix on vectors of frames.
+//    The result matches processReference() up to float
+//    rounding.
+//---------------------------------------------------------
+
+void ZitaReverb::processBlock(int n, const float* inp, float* out)
+      {
+      float t0[BLOCK], t1[BLOCK], g1[BLOCK];
+      float x[8][BLOCK];
+      const float g = sqrtf (0.125f);
+
+      for (int k = 0; k < n; ++k) {
+            t0[k] = inp[k * 2];
+            t1[k] = inp[k * 2 + 1];
+            }
+      _vdelay0.write (n, t0);
+      _vdelay1.write (n, t1);
+      _vdelay0.read (n, t0);
+      _vdelay1.read (n, t1);
+      for (int k = 0; k < n; ++k) {
+            t0[k] *= 0.3f;
+            t1[k] *= 0.3f;
+            }
+
+      for (int i = 0; i < 8; ++i) {
+            float* xi = x[i];
+            const float* t = i < 4 ? t0 : t1;
+            _delay[i].read (n, xi);
+            if (i & 2) {
+                  for (int k = 0; k < n; ++k)
+                        xi[k] -= t[k];
+                  }
+            else {
+                  for (int k = 0; k < n; ++k)
+                        xi[k] += t[k];
+                  }
+            _diff1[i].process (n, xi);
+            }
+
+      for (int k = 0; k < n; ++k) {
+            _g1 += _d1;
+            g1[k] = _g1;
+            }
+
+      // The damping filters are recursive in time, so they
+      // run side by side over the eight lines instead.
+
+      float gmf[8], glo[8], wlo[8], whi[8], slo[8], shi[8];
+      for (int i = 0; i < 8; ++i) {
+            gmf[i] = _filt1[i]._gmf;
+            glo[i] = _filt1[i]._glo;
+            wlo[i] = _filt1[i]._wlo;
+            whi[i] = _filt1[i]._whi;
+            slo[i] = _filt1[i]._slo;
+            shi[i] = _filt1[i]._shi;
+            }
+
+      int k = 0;
+#ifdef __SSE__
+      const __m128 vg    = _mm_set1_ps (g);
+      const __m128 noise = _mm_set1_ps (1e-10f);
+      __m128 vgmf[2], vglo[2], vwlo[2], vwhi[2], vslo[2], vshi[2];
+      for (int h = 0; h < 2; ++h) {
+            vgmf[h] = _mm_loadu_ps (gmf + h * 4);
+            vglo[h] = _mm_loadu_ps (glo + h * 4);
+            vwlo[h] = _mm_loadu_ps (wlo + h * 4);
+            vwhi[h] = _mm_loadu_ps (whi + h * 4);
+            vslo[h] = _mm_loadu_ps (slo + h * 4);
+            vshi[h] = _mm_loadu_ps (shi + h * 4);
+            }
+      for (; k + 4 <= n; k += 4) {
+            // v[line] holds four consecutive frames
+            __m128 v[8];
+            for (int i = 0; i < 8; ++i)
+                  v[i] = _mm_loadu_ps (x[i] + k);
+            hadamard (v);
+
+            float a[4], b[4];
+            _mm_storeu_ps (a, v[1]);
+            _mm_storeu_ps (b, v[2]);
+            for (int m = 0; m < 4; ++m) {
+                  out[(k + m) * 2]     = g1[k + m] * (a[m] + b[m]);
+                  out[(k + m) * 2 + 1] = g1[k + m] * (a[m] - b[m]);
+                  }
+
+            // transpose to frame order: v[m] lines 0-3, v[m+4] lines 4-7 of frame k+m
+            _MM_TRANSPOSE4_PS (v[0], v[1], v[2], v[3]);
+            _MM_TRANSPOSE4_PS (v[4], v[5], v[6], v[7]);
+            for (int m = 0; m < 4; ++m) {
+                  for (int h = 0; h < 2; ++h) {
+                        __m128 y = _mm_mul_ps (vg, v[m + h * 4]);
+                        vslo[h]  = _mm_add_ps (vslo[h], _mm_add_ps (_mm_mul_ps (vwlo[h], _mm_sub_ps (y, vslo[h])), noise));
+                        y        = _mm_add_ps (y, _mm_mul_ps (vglo[h], vslo[h]));
+                        vshi[h]  = _mm_add_ps (vshi[h], _mm_mul_ps (vwhi[h], _mm_sub_ps (y, vshi[h])));
+                        v[m + h * 4] = _mm_mul_ps (vgmf[h], vshi[h]);
+                        }
+                  }
+            _MM_TRANSPOSE4_PS (v[0], v[1], v[2], v[3]);
+            _MM_TRANSPOSE4_PS (v[4], v[5], v[6], v[7]);
+            for (int i = 0; i < 8; ++i)
+                  _mm_storeu_ps (x[i] + k, v[i]);
+            }
+      for (int h = 0; h < 2; ++h) {
+            _mm_storeu_ps (slo + h * 4, vslo[h]);
+            _mm_storeu_ps (shi + h * 4, vshi[h]);
+            }
+#endif
+      for (; k < n; ++k) {
+            float v[8];
+            for (int i = 0; i < 8; ++i)
+                  v[i] = x[i][k];
+            hadamard (v);
+            out[k * 2]     = g1[k] * (v[1] + v[2]);
+            out[k * 2 + 1] = g1[k] * (v[1] - v[2]);
+            for (int i = 0; i < 8; ++i) {
+                  float y = g * v[i];
+                  slo[i] += wlo[i] * (y - slo[i]) + 1e-10f;
+                  y      += glo[i] * slo[i];
+                  shi[i] += whi[i] * (y - shi[i]);
+                  x[i][k] = gmf[i] * shi[i];
+                  }
+            }
+
+      for (int i = 0; i < 8; ++i) {
+            _filt1[i]._slo = slo[i];
+            _filt1[i]._shi = shi[i];
+            _delay[i].write (n, x[i]);
+            }
+      }
+
+//---------------------------------------------------------
+//   processReference
+//    sample by sample implementation of process(), kept
+//    as reference for the block implementation
+//---------------------------------------------------------
+
+void ZitaReverb::processReference (int nfram, float* inp, float* out)
+      {
+      prepare(2048);
+
       float t, g, x0, x1, x2, x3, x4, x5, x6, x7;
       g = sqrtf (0.125f);
 
@@ -103,6 +103,26 @@ class Diff1
                   _i = 0;
             return z + _c * x;
             }
+      // block version, requires n <= _size: there is no
+      // dependency between the samples of one block
+      void process(int n, float* data) {
+            while (n) {
+                  int m    = qMin(n, _size - _i);
+                  float* l = _line + _i;
+                  for (int k = 0; k < m; ++k) {
+                        float x = data[k];
+                        float z = l[k];
+                        x -= _c * z;
+                        l[k] = x;
+                        data[k] = z + _c * x;
+                        }
+                  data += m;
+                  n    -= m;
+                  _i   += m;
+                  if (_i == _size)
+                        _i = 0;
+                  }
+            }
       };
 
 //---------------------------------------------------------
@@ -153,6 +173,10 @@ class Delay
             if (_i == _size)
                   _i = 0;
             }
+      // block read/write, n <= _size; read() must be called
+      // before write() for the same block
+      void read (int n, float* out) const;
+      void write (int n, const float* in);
       int     _i;
       int     _size;
       float  *_line;
@@ -185,6 +209,8 @@ class Vdelay
             if (_iw == _size)
                   _iw = 0;
             }
+      void read (int n, float* out);
+      void write (int n, const float* in);
       int     _ir;
       int     _iw;
       int     _size;
@@ -231,7 +257,10 @@ class ZitaReverb : public Effect
       static float _tdiff1 [8];
       static float _tdelay [8];
 
+      enum { BLOCK = 64 };    // must not exceed the shortest delay line
+
       void prepare(int n);
+      void processBlock(int n, const float* inp, float* out);
 
    public:
       ZitaReverb() : Effect() {}
@@ -241,6 +270,7 @@ class ZitaReverb : public Effect
       void fini();
 
       virtual void process(int n, float* inp, float* out);
+      void processReference(int n, float* inp, float* out);
 
       void set_delay(float v) { _ipdel = v; _cntA1++; }
       float delay() const     { return _ipdel; }
@@ -71,6 +71,7 @@ static const Mod defaultMod[] = {
 Fluid::Fluid()
    : Synthesizer()
       {
+      _stolenVoices = 0;
       }
 
 //---------------------------------------------------------
@@ -96,6 +97,9 @@ void Fluid::init(float sampleRate)
             _tuning[i] = i * 100.0;
       _masterTuning = 440.0;
 
+      freeVoices.reserve(512);
+      activeVoices.reserve(512);
+      voiceHeap.reserve(512);
       for (int i = 0; i < 512; i++)
             freeVoices.append(new Voice(this));
       }
@@ -125,8 +129,35 @@ Fluid::~Fluid()
 
 void Fluid::freeVoice(Voice* v)
       {
-      if (activeVoices.removeOne(v))
-            freeVoices.append(v);
+      int idx = v->activeIdx;
+      if (idx < 0)
+            return;
+      //
+      // move the last active voice into the free slot to keep
+      // activeVoices contiguous
+      //
+      Voice* last = activeVoices.last();
+      activeVoices[idx] = last;
+      last->activeIdx   = idx;
+      activeVoices.pop_back();
+      v->activeIdx = -1;
+      voiceHeap.remove(v);
+      freeVoices.append(v);
+      }
+
+//---------------------------------------------------------
+//   updateVoicePriority
+//    called by a voice whenever its state changes in a way
+//    which affects its stealing priority (envelope stage,
+//    noteoff, sustain)
+//---------------------------------------------------------
+
+void Fluid::updateVoicePriority(Voice* v)
+      {
+      if (v->heapIdx < 0)
+            return;
+      v->updateStealPriority();
+      voiceHeap.update(v);
       }
 
 //---------------------------------------------------------
@@ -232,7 +263,9 @@ void Fluid::allNotesOff(int chan)
 
 void Fluid::allSoundsOff(int chan)
       {
-      foreach(Voice* v, activeVoices) {
+      // iterate backwards: off() moves the last voice into the freed slot
+      for (int i = activeVoices.size() - 1; i >= 0; --i) {
+            Voice* v = activeVoices[i];
             if (chan == -1 || v->chan == chan)
                   v->off();
             }
@@ -247,8 +280,8 @@ void Fluid::allSoundsOff(int chan)
 
 void Fluid::system_reset()
       {
-      foreach(Voice* v, activeVoices)
-            v->off();
+      for (int i = activeVoices.size() - 1; i >= 0; --i)
+            activeVoices[i]->off();
       foreach(Channel* c, channel)
             c->reset();
       }
@@ -443,8 +476,10 @@ void Fluid::program_reset()
 void Fluid::process(unsigned len, float* out, float* effect1, float* effect2)
       {
       if (mutex.tryLock()) {
-            foreach (Voice* v, activeVoices)
-                  v->write(len, out, effect1, effect2);
+            // iterate backwards: a finished voice removes itself by
+            // moving the last (already processed) voice into its slot
+            for (int i = activeVoices.size() - 1; i >= 0; --i)
+                  activeVoices[i]->write(len, out, effect1, effect2);
             }
       mutex.unlock();
       }
@@ -452,70 +487,90 @@ void Fluid::process(unsigned len, float* out, float* effect1, float* effect2)
 /*
  * fluid_synth_free_voice_by_kill
  *
- * selects a voice for killing. the selection algorithm is a refinement
- * of the algorithm previously in fluid_synth_alloc_voice.
+ * selects a voice for killing. The voices are kept in a heap ordered
+ * by the priority computed in Voice::updateStealPriority(), so the
+ * least important voice is always at the top.
  */
 
 void Fluid::free_voice_by_kill()
       {
-      float best_prio = 999999.;
-      float this_voice_prio;
-      Voice* best_voice = 0;
-
-      foreach(Voice* v, activeVoices) {
-            /* Determine, how 'important' a voice is.
-             * Start with an arbitrary number */
-            this_voice_prio = 10000.;
-
-            /* Is this voice on the drum channel?
-             * Then it is very important.
-             * Also, forget about the released-note condition:
-             * Typically, drum notes are triggered only very briefly, they run most
-             * of the time in release phase.
-             */
-            if (v->chan == 9) {
-                  this_voice_prio += 4000;
+      Voice* v = voiceHeap.top();
+      if (v) {
+            v->off();
+            ++_stolenVoices;
+            }
+      }
 
-                  }
-            else if (v->RELEASED()) {
-                  /* The key for this voice has been released. Consider it much less important
-                  * than a voice, which is still held.
-                  */
-                  this_voice_prio -= 2000.;
-                  }
+//---------------------------------------------------------
+//   VoiceHeap
+//---------------------------------------------------------
 
-            if (v->SUSTAINED()) {
-              /* The sustain pedal is held down on this channel.
-               * Consider it less important than non-sustained channels.
-               * This decision is somehow subjective. But usually the sustain pedal
-               * is used to play 'more-voices-than-fingers', so it shouldn't hurt
-               * if we kill one voice.
-               */
-                  this_voice_prio -= 1000;
-                  }
+void VoiceHeap::swap(int i, int k)
+      {
+      Voice* v = heap[i];
+      heap[i]  = heap[k];
+      heap[k]  = v;
+      heap[i]->heapIdx = i;
+      heap[k]->heapIdx = k;
+      }
 
-            /* We are not enthusiastic about releasing voices, which have just been started.
-             * Otherwise hitting a chord may result in killing notes belonging to that very same
-             * chord.
-             * So subtract the age of the voice from the priority - an older voice is just a little
-             * bit less important than a younger voice.
-             * This is a number between roughly 0 and 100.*/
+void VoiceHeap::up(int i)
+      {
+      while (i > 0) {
+            int parent = (i - 1) / 2;
+            if (heap[parent]->stealPriority <= heap[i]->stealPriority)
+                  break;
+            swap(i, parent);
+            i = parent;
+            }
+      }
 
-            this_voice_prio -= (noteid - v->get_id());
+void VoiceHeap::down(int i)
+      {
+      int n = heap.size();
+      for (;;) {
+            int l        = 2 * i + 1;
+            int r        = l + 1;
+            int smallest = i;
+            if (l < n && heap[l]->stealPriority < heap[smallest]->stealPriority)
+                  smallest = l;
+            if (r < n && heap[r]->stealPriority < heap[smallest]->stealPriority)
+                  smallest = r;
+            if (smallest == i)
+                  break;
+            swap(i, smallest);
+            i = smallest;
+            }
+      }
 
-            /* take a rough estimate of loudness into account. Louder voices are more important. */
-            if (v->volenv_section != FLUID_VOICE_ENVATTACK) {
-                  this_voice_prio += v->volenv_val * 1000.;
-                  }
+void VoiceHeap::push(Voice* v)
+      {
+      v->heapIdx = heap.size();
+      heap.append(v);
+      up(v->heapIdx);
+      }
 
-            /* check if this voice has less priority than the previous candidate. */
-            if (this_voice_prio < best_prio) {
-                  best_voice = v;
-                  best_prio = this_voice_prio;
-                  }
+void VoiceHeap::remove(Voice* v)
+      {
+      int i = v->heapIdx;
+      if (i < 0)
+            return;
+      int last = heap.size() - 1;
+      if (i != last) {
+            swap(i, last);
+            heap.pop_back();
+            update(heap[i]);
             }
-      if (best_voice)
-            best_voice->off();
+      else
+            heap.pop_back();
+      v->heapIdx = -1;
+      }
+
+void VoiceHeap::update(Voice* v)
+      {
+      int i = v->heapIdx;
+      up(i);
+      down(v->heapIdx);
       }
 
 //---------------------------------------------------------
@@ -535,13 +590,17 @@ Voice* Fluid::alloc_voice(unsigned id, Sample* sample, int chan, int key, int ve
             return 0;
             }
 
-      Voice* v = freeVoices.takeLast();
+      Voice* v = freeVoices.last();
+      freeVoices.pop_back();
+      v->activeIdx = activeVoices.size();
       activeVoices.append(v);
 
       if (chan >= 0)
             c = channel[chan];
 
       v->init(sample, c, key, vel, id, vt);
+      v->updateStealPriority();
+      voiceHeap.push(v);
 
       /* add the default modulators to the synthesis process. */
       for (unsigned i = 0; i < sizeof(defaultMod)/sizeof(*defaultMod); ++i)
@@ -651,8 +710,8 @@ bool Fluid::loadSoundFonts(const QStringList& sl)
             return true;
             }
       mutex.lock();
-      foreach(Voice* v, activeVoices)
-            v->off();
+      for (int i = activeVoices.size() - 1; i >= 0; --i)
+            activeVoices[i]->off();
       foreach(Channel* c, channel)
             c->reset();
       foreach (SFont* sf, sfonts)
@@ -290,6 +290,29 @@ enum {
       FLUID_GROUP  = 0,
       };
 
+//---------------------------------------------------------
+//   VoiceHeap
+//    binary min-heap of the active voices ordered by their
+//    stealing priority; top() is the voice to kill first
+//    when the polyphony is exhausted
+//---------------------------------------------------------
+
+class VoiceHeap {
+      QVector<Voice*> heap;
+
+      void swap(int i, int k);
+      void up(int i);
+      void down(int i);
+
+   public:
+      void reserve(int n)        { heap.reserve(n); }
+      void push(Voice*);
+      void remove(Voice*);
+      void update(Voice*);
+      Voice* top() const         { return heap.isEmpty() ? 0 : heap[0]; }
+      int size() const           { return heap.size(); }
+      };
+
 //---------------------------------------------------------
 //   Fluid
 //---------------------------------------------------------
@@ -299,8 +322,10 @@ class Fluid : public Synthesizer {
       QList<BankOffset*> bank_offsets;    // the offsets of the soundfont banks
       QList<MidiPatch*> patches;
 
-      QList<Voice*> freeVoices;           // unused synthesis processes
-      QList<Voice*> activeVoices;         // active synthesis processes
+      QVector<Voice*> freeVoices;         // unused synthesis processes
+      QVector<Voice*> activeVoices;       // active synthesis processes
+      VoiceHeap voiceHeap;                // active voices ordered by stealing priority
+      int _stolenVoices;                  // number of voices killed by free_voice_by_kill()
       QString _error;                     // last error message
 
       static bool initialized;
@@ -404,6 +429,7 @@ class Fluid : public Synthesizer {
       void get_pitch_bend(int chan, int* ppitch_bend);
 
       void freeVoice(Voice* v);
+      void updateVoicePriority(Voice* v);
 
       double getPitch(int k) const   { return _tuning[k]; }
       float ct2hz_real(float cents)  { return powf(2.0f, (cents - 6900.0f) / 1200.0f) * _masterTuning; }
@@ -417,6 +443,8 @@ class Fluid : public Synthesizer {
       QString error() const { return _error; }
 
       virtual SynthesizerGui* gui();
+      virtual int activeVoiceCount() const  { return activeVoices.size(); }
+      virtual int stolenVoiceCount() const  { return _stolenVoices; }
 
       static QFileInfoList sfFiles();
 
@@ -63,6 +63,9 @@ Voice::Voice(Fluid* f)
       vel     = 0;
       channel = 0;
       sample  = 0;
+      activeIdx     = -1;
+      heapIdx       = -1;
+      stealPriority = 0.0;
 
       /* The 'sustain' and 'finished' segments of the volume / modulation
        * envelope are constant. They are never affected by any modulator
@@ -227,6 +230,7 @@ void Voice::write(unsigned n, float* out, float* reverb, float* chorus)
 
       /******************* vol env **********************/
 
+      int section = volenv_section;
       env_data = &volenv_data[volenv_section];
 
       /* skip to the next section of the envelope if necessary */
@@ -259,6 +263,8 @@ void Voice::write(unsigned n, float* out, float* reverb, float* chorus)
             off();
             return;
             }
+      if (volenv_section != section)
+            _fluid->updateVoicePriority(this);
 
       fluid_check_fpe ("voice_write vol env");
 
@@ -1284,6 +1290,57 @@ void Voice::noteoff()
             modenv_section = FLUID_VOICE_ENVRELEASE;
             modenv_count = 0;
             }
+      _fluid->updateVoicePriority(this);
+      }
+
+//---------------------------------------------------------
+//   updateStealPriority
+//    Determine, how 'important' a voice is. The voice with
+//    the lowest priority is killed first if there is no
+//    free voice left.
+//---------------------------------------------------------
+
+void Voice::updateStealPriority()
+      {
+      /* Start with an arbitrary number */
+      double prio = 10000.0;
+
+      /* Is this voice on the drum channel?
+       * Then it is very important.
+       * Also, forget about the released-note condition:
+       * Typically, drum notes are triggered only very briefly, they run most
+       * of the time in release phase.
+       */
+      if (chan == 9)
+            prio += 4000.0;
+      else if (RELEASED()) {
+            /* The key for this voice has been released. Consider it much less important
+             * than a voice, which is still held.
+             */
+            prio -= 2000.0;
+            }
+
+      if (SUSTAINED()) {
+            /* The sustain pedal is held down on this channel.
+             * Consider it less important than non-sustained channels.
+             */
+            prio -= 1000.0;
+            }
+
+      /* An older voice is just a little bit less important than a younger voice.
+       * The age is relative to the current note id which is the same for
+       * all voices, so the id alone gives the same ordering.
+       */
+      prio += id;
+
+      /* take a rough estimate of loudness into account. Louder voices are more important.
+       * The value is sampled when the priority is updated (envelope stage changes,
+       * noteoff, sustain), not continuously.
+       */
+      if (volenv_section != FLUID_VOICE_ENVATTACK)
+            prio += volenv_val * 1000.0;
+
+      stealPriority = prio;
       }
 
 /*
@@ -1324,6 +1381,8 @@ void Voice::kill_excl()
       /* Speed up the modulation envelope */
       gen_set(GEN_MODENVRELEASE, -200);
       update_param(GEN_MODENVRELEASE);
+
+      _fluid->updateVoicePriority(this);
       }
 
 //---------------------------------------------------------
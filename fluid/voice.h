@@ -187,6 +187,11 @@ class Voice
 	int debug;
 	double ref;
 
+	/* voice stealing */
+	int activeIdx;                  /* index in Fluid::activeVoices, -1 if free */
+	int heapIdx;                    /* index in Fluid::voiceHeap, -1 if free */
+	double stealPriority;           /* the lowest priority voice is killed first */
+
    public:
       Voice(Fluid*);
       Channel* get_channel() const    { return channel; }
@@ -215,6 +220,7 @@ class Voice
       void check_sample_sanity();
       void noteoff();
       void kill_excl();
+      void updateStealPriority();
       int calculate_hold_decay_frames(int gen_base, int gen_key2base, int is_decay);
 
       /* A voice is 'ON', if it has not yet received a noteoff
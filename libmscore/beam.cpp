@@ -937,17 +937,16 @@ static void initBeamMetrics()
 
 //---------------------------------------------------------
 //   beamMetric1
-//    table driven
+//    table driven; scores may be laid out concurrently
+//    (batch conversion), so the table is initialized
+//    once by a static initializer and only read afterwards
 //---------------------------------------------------------
 
 static Bm beamMetric1(bool up, char l1, char l2)
       {
-      static int initialized = false;
-      if (!initialized) {
-            initBeamMetrics();
-            initialized = true;
-            }
-      return bMetrics[Bm::key(up, l1, l2)];
+      static const bool initialized = (initBeamMetrics(), true);
+      Q_UNUSED(initialized);
+      return bMetrics.value(Bm::key(up, l1, l2));
       }
 
 //---------------------------------------------------------
@@ -834,84 +834,90 @@ void Chord::readNote(XmlReader& e)
 void Chord::read(XmlReader& e)
       {
       while (e.readNextStartElement()) {
-            const QStringRef& tag(e.name());
-
-            if (tag == "Note") {
-                  Note* note = new Note(score());
-                  // the note needs to know the properties of the track it belongs to
-                  note->setTrack(track());
-                  note->setChord(this);
-                  note->read(e);
-                  add(note);
-                  }
-            else if (tag == "appoggiatura") {
-                  _noteType = NOTE_APPOGGIATURA;
-                  e.readNext();
-                  }
-            else if (tag == "acciaccatura") {
-                  _noteType = NOTE_ACCIACCATURA;
-                  e.readNext();
-                  }
-            else if (tag == "grace4") {
-                  _noteType = NOTE_GRACE4;
-                  e.readNext();
-                  }
-            else if (tag == "grace16") {
-                  _noteType = NOTE_GRACE16;
-                  e.readNext();
-                  }
-            else if (tag == "grace32") {
-                  _noteType = NOTE_GRACE32;
-                  e.readNext();
-                  }
-            else if (tag == "StemDirection") {
-                  QString val(e.readElementText());
-                  if (val == "up")
-                        _stemDirection = MScore::UP;
-                  else if (val == "down")
-                        _stemDirection = MScore::DOWN;
-                  else
-                        _stemDirection = MScore::Direction(val.toInt());
-                  }
-            else if (tag == "noStem")
-                  _noStem = e.readInt();
-            else if (tag == "Arpeggio") {
-                  _arpeggio = new Arpeggio(score());
-                  _arpeggio->setTrack(track());
-                  _arpeggio->read(e);
-                  _arpeggio->setParent(this);
-                  }
-            else if (tag == "Glissando") {
-                  _glissando = new Glissando(score());
-                  _glissando->setTrack(track());
-                  _glissando->read(e);
-                  _glissando->setParent(this);
-                  }
-            else if (tag == "Tremolo") {
-                  _tremolo = new Tremolo(score());
-                  _tremolo->setTrack(track());
-                  _tremolo->read(e);
-                  _tremolo->setParent(this);
-                  }
-            else if (tag == "tickOffset")       // obsolete
-                  ;
-            else if (tag == "Stem") {
-                  _stem = new Stem(score());
-                  _stem->read(e);
-                  add(_stem);
-                  }
-            else if (tag == "Hook") {
-                  _hook = new Hook(score());
-                  _hook->read(e);
-                  add(_hook);
-                  }
-            else if (tag == "ChordLine") {
-                  ChordLine* cl = new ChordLine(score());
-                  cl->read(e);
-                  add(cl);
+            switch (e.token()) {
+                  case XmlTag::Note: {
+                        Note* note = new Note(score());
+                        // the note needs to know the properties of the track it belongs to
+                        note->setTrack(track());
+                        note->setChord(this);
+                        note->read(e);
+                        add(note);
+                        }
+                        break;
+                  case XmlTag::appoggiatura:
+                        _noteType = NOTE_APPOGGIATURA;
+                        e.readNext();
+                        break;
+                  case XmlTag::acciaccatura:
+                        _noteType = NOTE_ACCIACCATURA;
+                        e.readNext();
+                        break;
+                  case XmlTag::grace4:
+                        _noteType = NOTE_GRACE4;
+                        e.readNext();
+                        break;
+                  case XmlTag::grace16:
+                        _noteType = NOTE_GRACE16;
+                        e.readNext();
+                        break;
+                  case XmlTag::grace32:
+                        _noteType = NOTE_GRACE32;
+                        e.readNext();
+                        break;
+                  case XmlTag::StemDirection: {
+                        QString val(e.readElementText());
+                        if (val == "up")
+                              _stemDirection = MScore::UP;
+                        else if (val == "down")
+                              _stemDirection = MScore::DOWN;
+                        else
+                              _stemDirection = MScore::Direction(val.toInt());
+                        }
+                        break;
+                  case XmlTag::noStem:
+                        _noStem = e.readInt();
+                        break;
+                  case XmlTag::Arpeggio:
+                        _arpeggio = new Arpeggio(score());
+                        _arpeggio->setTrack(track());
+                        _arpeggio->read(e);
+                        _arpeggio->setParent(this);
+                        break;
+                  case XmlTag::Glissando:
+                        _glissando = new Glissando(score());
+                        _glissando->setTrack(track());
+                        _glissando->read(e);
+                        _glissando->setParent(this);
+                        break;
+                  case XmlTag::Tremolo:
+                        _tremolo = new Tremolo(score());
+                        _tremolo->setTrack(track());
+                        _tremolo->read(e);
+                        _tremolo->setParent(this);
+                        break;
+                  case XmlTag::tickOffset:      // obsolete
+                        break;
+                  case XmlTag::Stem:
+                        _stem = new Stem(score());
+                        _stem->read(e);
+                        add(_stem);
+                        break;
+                  case XmlTag::Hook:
+                        _hook = new Hook(score());
+                        _hook->read(e);
+                        add(_hook);
+                        break;
+                  case XmlTag::ChordLine: {
+                        ChordLine* cl = new ChordLine(score());
+                        cl->read(e);
+                        add(cl);
+                        }
+                        break;
+                  default:
+                        if (!ChordRest::readProperties(e))
+                              e.unknown();
+                        break;
                   }
-            else if (!ChordRest::readProperties(e))
-                  e.unknown();
             }
       if (score()->mscVersion() <= 114) { // #19988
             Note * n = upNote();
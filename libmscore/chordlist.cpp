@@ -627,12 +627,11 @@ bool ChordList::read(const QString& name)
       QFile f(path);
       if (!f.open(QIODevice::ReadOnly)) {
             QString s = QT_TRANSLATE_NOOP("file", "cannot open chord description:\n%1\n%2");
-            MScore::lastError = s.arg(f.fileName()).arg(f.errorString());
+            MScore::setLastError(s.arg(f.fileName()).arg(f.errorString()));
             qDebug("ChordList::read failed: <%s>", qPrintable(path));
             return false;
             }
       XmlReader e(&f);
-      docName = f.fileName();
 
       while (e.readNextStartElement()) {
             if (e.name() == "museScore") {
@@ -664,7 +663,7 @@ bool ChordList::write(const QString& name)
 
       if (!f.open(QIODevice::WriteOnly)) {
             QString s = QT_TRANSLATE_NOOP("file", "Open Chord Description\n%1\nfailed: %2");
-            MScore::lastError = s.arg(f.fileName()).arg(f.errorString());
+            MScore::setLastError(s.arg(f.fileName()).arg(f.errorString()));
             return false;
             }
 
@@ -676,7 +675,7 @@ bool ChordList::write(const QString& name)
       xml.etag();
       if (f.error() != QFile::NoError) {
             QString s = QT_TRANSLATE_NOOP("file", "Write Chord Description failed: %1");
-            MScore::lastError = s.arg(f.errorString());
+            MScore::setLastError(s.arg(f.errorString()));
             }
       return true;
       }
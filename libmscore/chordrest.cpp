@@ -226,128 +226,140 @@ bool ChordRest::readProperties(XmlReader& e)
       {
       if (DurationElement::readProperties(e))
             return true;
-      const QStringRef& tag(e.name());
-
-      if (tag == "BeamMode") {
-            QString val(e.readElementText());
-            BeamMode bm = BeamMode::AUTO;
-            if (val == "auto")
-                  bm = BeamMode::AUTO;
-            else if (val == "begin")
-                  bm = BeamMode::BEGIN;
-            else if (val == "mid")
-                  bm = BeamMode::MID;
-            else if (val == "end")
-                  bm = BeamMode::END;
-            else if (val == "no")
-                  bm = BeamMode::NONE;
-            else if (val == "begin32")
-                  bm = BeamMode::BEGIN32;
-            else if (val == "begin64")
-                  bm = BeamMode::BEGIN64;
-            else
-                  bm = BeamMode(val.toInt());
-            _beamMode = BeamMode(bm);
-            }
-      else if (tag == "Attribute" || tag == "Articulation") {     // obsolete: "Attribute"
-            Articulation* atr = new Articulation(score());
-            atr->read(e);
-            add(atr);
-            }
-      else if (tag == "leadingSpace") {
-            qDebug("ChordRest: leadingSpace obsolete"); // _extraLeadingSpace = Spatium(val.toDouble());
-            e.skipCurrentElement();
-            }
-      else if (tag == "trailingSpace") {
-            qDebug("ChordRest: trailingSpace obsolete"); // _extraTrailingSpace = Spatium(val.toDouble());
-            e.skipCurrentElement();
-            }
-      else if (tag == "Beam") {
-            int id = e.readInt();
-            Beam* beam = e.findBeam(id);
-            if (beam)
-                  beam->add(this);        // also calls this->setBeam(beam)
-            else
-                  qDebug("Beam id %d not found", id);
-            }
-      else if (tag == "small")
-            _small = e.readInt();
-      else if (tag == "Slur") {
-            int id = e.intAttribute("number");
-            QString type(e.attribute("type"));
-            Slur* slur = static_cast<Slur*>(e.findSpanner(id));
-            if (!slur)
-                  qDebug("ChordRest::read(): Slur id %d not found", id);
-            else {
-                  if (type == "start") {
-                        slur->setStartElement(this);
-                        addSlurFor(slur);
-                        }
-                  else if (type == "stop") {
-                        slur->setEndElement(this);
-                        addSlurBack(slur);
-                        }
+
+      switch (e.token()) {
+            case XmlTag::BeamMode: {
+                  QString val(e.readElementText());
+                  BeamMode bm = BeamMode::AUTO;
+                  if (val == "auto")
+                        bm = BeamMode::AUTO;
+                  else if (val == "begin")
+                        bm = BeamMode::BEGIN;
+                  else if (val == "mid")
+                        bm = BeamMode::MID;
+                  else if (val == "end")
+                        bm = BeamMode::END;
+                  else if (val == "no")
+                        bm = BeamMode::NONE;
+                  else if (val == "begin32")
+                        bm = BeamMode::BEGIN32;
+                  else if (val == "begin64")
+                        bm = BeamMode::BEGIN64;
                   else
-                        qDebug("ChordRest::read(): unknown Slur type <%s>", qPrintable(type));
+                        bm = BeamMode(val.toInt());
+                  _beamMode = BeamMode(bm);
                   }
-            e.readNext();
-            }
-      else if (tag == "durationType") {
-            setDurationType(e.readElementText());
-            if (actualDurationType().type() != TDuration::V_MEASURE) {
-                  if ((type() == REST) &&
-                              // for backward compatibility, convert V_WHOLE rests to V_MEASURE
-                              // if long enough to fill a measure.
-                              // OTOH, freshly created (un-initialized) rests have numerator == 0 (< 4/4)
-                              // (see Fraction() constructor in fraction.h; this happens for instance
-                              // when pasting selection from clipboard): they should not be converted
-                              duration().numerator() != 0 &&
-                              // rest durations are initialized to full measure duration when
-                              // created upon reading the <Rest> tag (see Measure::read() )
-                              // so a V_WHOLE rest in a measure of 4/4 or less => V_MEASURE
-                              (actualDurationType()==TDuration::V_WHOLE && duration() <= Fraction(4, 4)) ) {
-                        // old pre 2.0 scores: convert
-                        setDurationType(TDuration::V_MEASURE);
-                        }
-                  else  // not from old score: set duration fraction from duration type
-                        setDuration(actualDurationType().fraction());
+                  break;
+            case XmlTag::Attribute:             // obsolete
+            case XmlTag::Articulation: {
+                  Articulation* atr = new Articulation(score());
+                  atr->read(e);
+                  add(atr);
                   }
-            else {
-                  if (score()->mscVersion() < 115) {
-                        SigEvent event = score()->sigmap()->timesig(e.tick());
-                        setDuration(event.timesig());
+                  break;
+            case XmlTag::leadingSpace:
+                  qDebug("ChordRest: leadingSpace obsolete"); // _extraLeadingSpace = Spatium(val.toDouble());
+                  e.skipCurrentElement();
+                  break;
+            case XmlTag::trailingSpace:
+                  qDebug("ChordRest: trailingSpace obsolete"); // _extraTrailingSpace = Spatium(val.toDouble());
+                  e.skipCurrentElement();
+                  break;
+            case XmlTag::Beam: {
+                  int id = e.readInt();
+                  Beam* beam = e.findBeam(id);
+                  if (beam)
+                        beam->add(this);        // also calls this->setBeam(beam)
+                  else
+                        qDebug("Beam id %d not found", id);
+                  }
+                  break;
+            case XmlTag::small_:
+                  _small = e.readInt();
+                  break;
+            case XmlTag::Slur: {
+                  int id = e.intAttribute("number");
+                  QString type(e.attribute("type"));
+                  Slur* slur = static_cast<Slur*>(e.findSpanner(id));
+                  if (!slur)
+                        qDebug("ChordRest::read(): Slur id %d not found", id);
+                  else {
+                        if (type == "start") {
+                              slur->setStartElement(this);
+                              addSlurFor(slur);
+                              }
+                        else if (type == "stop") {
+                              slur->setEndElement(this);
+                              addSlurBack(slur);
+                              }
+                        else
+                              qDebug("ChordRest::read(): unknown Slur type <%s>", qPrintable(type));
                         }
+                  e.readNext();
                   }
-            }
-      else if (tag == "duration")
-            setDuration(e.readFraction());
-      else if (tag == "ticklen") {      // obsolete (version < 1.12)
-            int mticks = score()->sigmap()->timesig(e.tick()).timesig().ticks();
-            int i = e.readInt();
-            if (i == 0)
-                  i = mticks;
-            if ((type() == REST) && (mticks == i)) {
-                  setDurationType(TDuration::V_MEASURE);
-                  setDuration(Fraction::fromTicks(i));
+                  break;
+            case XmlTag::durationType:
+                  setDurationType(e.readElementText());
+                  if (actualDurationType().type() != TDuration::V_MEASURE) {
+                        if ((type() == REST) &&
+                                    // for backward compatibility, convert V_WHOLE rests to V_MEASURE
+                                    // if long enough to fill a measure.
+                                    // OTOH, freshly created (un-initialized) rests have numerator == 0 (< 4/4)
+                                    // (see Fraction() constructor in fraction.h; this happens for instance
+                                    // when pasting selection from clipboard): they should not be converted
+                                    duration().numerator() != 0 &&
+                                    // rest durations are initialized to full measure duration when
+                                    // created upon reading the <Rest> tag (see Measure::read() )
+                                    // so a V_WHOLE rest in a measure of 4/4 or less => V_MEASURE
+                                    (actualDurationType()==TDuration::V_WHOLE && duration() <= Fraction(4, 4)) ) {
+                              // old pre 2.0 scores: convert
+                              setDurationType(TDuration::V_MEASURE);
+                              }
+                        else  // not from old score: set duration fraction from duration type
+                              setDuration(actualDurationType().fraction());
+                        }
+                  else {
+                        if (score()->mscVersion() < 115) {
+                              SigEvent event = score()->sigmap()->timesig(e.tick());
+                              setDuration(event.timesig());
+                              }
+                        }
+                  break;
+            case XmlTag::duration:
+                  setDuration(e.readFraction());
+                  break;
+            case XmlTag::ticklen: {       // obsolete (version < 1.12)
+                  int mticks = score()->sigmap()->timesig(e.tick()).timesig().ticks();
+                  int i = e.readInt();
+                  if (i == 0)
+                        i = mticks;
+                  if ((type() == REST) && (mticks == i)) {
+                        setDurationType(TDuration::V_MEASURE);
+                        setDuration(Fraction::fromTicks(i));
+                        }
+                  else {
+                        Fraction f = Fraction::fromTicks(i);
+                        setDuration(f);
+                        setDurationType(TDuration(f));
+                        }
                   }
-            else {
-                  Fraction f = Fraction::fromTicks(i);
-                  setDuration(f);
-                  setDurationType(TDuration(f));
+                  break;
+            case XmlTag::dots:
+                  setDots(e.readInt());
+                  break;
+            case XmlTag::move:
+                  _staffMove = e.readInt();
+                  break;
+            case XmlTag::Lyrics: /*|| tag == "FiguredBass"*/ {
+                  Element* element = Element::name2Element(e.name(), score());
+                  element->setTrack(e.track());
+                  element->read(e);
+                  add(element);
                   }
+                  break;
+            default:
+                  return false;
             }
-      else if (tag == "dots")
-            setDots(e.readInt());
-      else if (tag == "move")
-            _staffMove = e.readInt();
-      else if (tag == "Lyrics" /*|| tag == "FiguredBass"*/) {
-            Element* element = Element::name2Element(tag, score());
-            element->setTrack(e.track());
-            element->read(e);
-            add(element);
-            }
-      else
-            return false;
       return true;
       }
 
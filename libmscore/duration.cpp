@@ -78,8 +78,7 @@ bool DurationElement::readProperties(XmlReader& e)
       {
       if (Element::readProperties(e))
             return true;
-      const QStringRef& tag(e.name());
-      if (tag == "Tuplet") {
+      if (e.token() == XmlTag::Tuplet) {
             // setTuplet(0);
             int i = e.readInt();
             Tuplet* t = e.findTuplet(i);
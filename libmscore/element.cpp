@@ -665,67 +665,79 @@ void Element::writeProperties(Xml& xml) const
 
 bool Element::readProperties(XmlReader& e)
       {
-      const QStringRef& tag(e.name());
-
-      if (tag == "color")
-            _color = e.readColor();
-      else if (tag == "visible")
-            _visible = e.readInt();
-      else if (tag == "selected")
-            _selected = e.readInt();
-      else if (tag == "userOff")
-            _userOff = e.readPoint();
-      else if (tag == "lid") {
-            int id = e.readInt();
-            _links = score()->links().value(id);
-            if (!_links) {
-                  if (score()->parentScore())   // DEBUG
-                        qDebug("---link %d not found (%d)\n", id, score()->links().size());
-                  _links = new LinkedElements(score(), id);
-                  score()->links().insert(id, _links);
-                  }
+      switch (e.token()) {
+            case XmlTag::color:
+                  _color = e.readColor();
+                  break;
+            case XmlTag::visible:
+                  _visible = e.readInt();
+                  break;
+            case XmlTag::selected:
+                  _selected = e.readInt();
+                  break;
+            case XmlTag::userOff:
+                  _userOff = e.readPoint();
+                  break;
+            case XmlTag::lid: {
+                  int id = e.readInt();
+                  _links = score()->links().value(id);
+                  if (!_links) {
+                        if (score()->parentScore())   // DEBUG
+                              qDebug("---link %d not found (%d)\n", id, score()->links().size());
+                        _links = new LinkedElements(score(), id);
+                        score()->links().insert(id, _links);
+                        }
 #ifndef NDEBUG
-            else {
-                  foreach(Element* ee, *_links) {
-                        if (ee->type() != type()) {
-                              qFatal("link %s(%d) type mismatch %s linked to %s",
-                                 ee->name(), id, ee->name(), name());
+                  else {
+                        foreach(Element* ee, *_links) {
+                              if (ee->type() != type()) {
+                                    qFatal("link %s(%d) type mismatch %s linked to %s",
+                                       ee->name(), id, ee->name(), name());
+                                    }
                               }
                         }
-                  }
 #endif
-            _links->append(this);
-            }
-      else if (tag == "tick") {
-            int val = e.readInt();
-            if (type() != SYMBOL)   // hack for 1.2
-                  e.setTick(score()->fileDivision(val));
-            }
-      else if (tag == "offset") {         // ??obsolete -> used for volta
-            qreal _spatium = spatium();
-            QPointF pt(e.readPoint() * _spatium);
-            setUserOff(pt);
-            // _readPos = QPointF();
-            }
-      else if (tag == "pos")
-            _readPos = e.readPoint() * spatium();
-      else if (tag == "voice")
-            setTrack((_track/VOICES)*VOICES + e.readInt());
-      else if (tag == "track")
-            setTrack(e.readInt());
-      else if (tag == "tag") {
-            QString val(e.readElementText());
-            for (int i = 1; i < MAX_TAGS; i++) {
-                  if (score()->layerTags()[i] == val) {
-                        _tag = 1 << i;
-                        break;
+                  _links->append(this);
+                  }
+                  break;
+            case XmlTag::tick: {
+                  int val = e.readInt();
+                  if (type() != SYMBOL)   // hack for 1.2
+                        e.setTick(score()->fileDivision(val));
+                  }
+                  break;
+            case XmlTag::offset: {        // ??obsolete -> used for volta
+                  qreal _spatium = spatium();
+                  QPointF pt(e.readPoint() * _spatium);
+                  setUserOff(pt);
+                  // _readPos = QPointF();
+                  }
+                  break;
+            case XmlTag::pos:
+                  _readPos = e.readPoint() * spatium();
+                  break;
+            case XmlTag::voice:
+                  setTrack((_track/VOICES)*VOICES + e.readInt());
+                  break;
+            case XmlTag::track:
+                  setTrack(e.readInt());
+                  break;
+            case XmlTag::tag: {
+                  QString val(e.readElementText());
+                  for (int i = 1; i < MAX_TAGS; i++) {
+                        if (score()->layerTags()[i] == val) {
+                              _tag = 1 << i;
+                              break;
+                              }
                         }
                   }
+                  break;
+            case XmlTag::placement:
+                  _placement = Placement(Ms::getProperty(P_PLACEMENT, e).toInt());
+                  break;
+            default:
+                  return false;
             }
-      else if (tag == "placement")
-            _placement = Placement(Ms::getProperty(P_PLACEMENT, e).toInt());
-      else
-            return false;
       return true;
       }
 
@@ -1528,7 +1528,7 @@ bool FiguredBass::readConfigFile(const QString& fileName)
       QFile f(path);
       if (!f.open(QIODevice::ReadOnly)) {
             QString s = QT_TRANSLATE_NOOP("file", "cannot open figured bass description:\n%1\n%2");
-            MScore::lastError = s.arg(f.fileName()).arg(f.errorString());
+            MScore::setLastError(s.arg(f.fileName()).arg(f.errorString()));
 qDebug("FiguredBass::read failed: <%s>\n", qPrintable(path));
             return false;
             }
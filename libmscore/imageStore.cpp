@@ -11,6 +11,7 @@
 //=============================================================================
 
 #include <QtCore/QCryptographicHash>
+#include <QtCore/QMutex>
 #include "imageStore.h"
 #include "score.h"
 #include "image.h"
@@ -19,6 +20,11 @@ namespace Ms {
 
 ImageStore imageStore;  // the global image store
 
+// scores are loaded, saved and deleted concurrently by batch
+// jobs; the store and the references of its items are only
+// touched with storeMutex locked
+static QMutex storeMutex;
+
 //---------------------------------------------------------
 //   ImageStoreItem
 //---------------------------------------------------------
@@ -35,6 +41,7 @@ ImageStoreItem::ImageStoreItem(const QString& p)
 
 void ImageStoreItem::dereference(Image* image)
       {
+      QMutexLocker locker(&storeMutex);
       _references.removeOne(image);
       }
 
@@ -45,6 +52,7 @@ void ImageStoreItem::dereference(Image* image)
 
 void ImageStoreItem::reference(Image* image)
       {
+      QMutexLocker locker(&storeMutex);
       _references.append(image);
       }
 
@@ -54,6 +62,17 @@ void ImageStoreItem::reference(Image* image)
 //---------------------------------------------------------
 
 bool ImageStoreItem::isUsed(Score* score) const
+      {
+      QMutexLocker locker(&storeMutex);
+      return usedBy(score);
+      }
+
+//---------------------------------------------------------
+//   usedBy
+//    isUsed() for callers which hold storeMutex
+//---------------------------------------------------------
+
+bool ImageStoreItem::usedBy(Score* score) const
       {
       foreach(Image* image, _references) {
             if (image->score() == score)
@@ -145,6 +164,7 @@ static void dumpHash(const QByteArray& _hash)
 
 ImageStoreItem* ImageStore::getImage(const QString& path) const
       {
+      QMutexLocker locker(&storeMutex);
       QString s = QFileInfo(path).baseName();
       if (s.size() != 32) {
             //
@@ -179,6 +199,7 @@ ImageStoreItem* ImageStore::add(const QString& path, const QByteArray& ba)
       QCryptographicHash h(QCryptographicHash::Md4);
       h.addData(ba);
       QByteArray hash = h.result();
+      QMutexLocker locker(&storeMutex);
       foreach(ImageStoreItem* item, *this) {
             if (item->hash() == hash)
                   return item;
@@ -189,5 +210,21 @@ ImageStoreItem* ImageStore::add(const QString& path, const QByteArray& ba)
       return item;
       }
 
+//---------------------------------------------------------
+//   usedItems
+//    return the items used by score
+//---------------------------------------------------------
+
+QList<ImageStoreItem*> ImageStore::usedItems(Score* score) const
+      {
+      QMutexLocker locker(&storeMutex);
+      QList<ImageStoreItem*> il;
+      foreach(ImageStoreItem* item, *this) {
+            if (item->usedBy(score))
+                  il.append(item);
+            }
+      return il;
+      }
+
 }
 
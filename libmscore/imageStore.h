@@ -39,6 +39,7 @@ class ImageStoreItem {
       bool loaded() const              { return !_buffer.isEmpty();   }
       void setPath(const QString& val);
       bool isUsed(Score*) const;
+      bool usedBy(Score*) const;
       void load();
       QString hashName() const;
       const QByteArray& hash() const   { return _hash; }
@@ -54,6 +55,7 @@ class ImageStore : public QList<ImageStoreItem*>  {
    public:
       ImageStoreItem* getImage(const QString& path) const;
       ImageStoreItem* add(const QString& path, const QByteArray&);
+      QList<ImageStoreItem*> usedItems(Score*) const;
       };
 
 extern ImageStore imageStore;       // this is the global imageStore
@@ -546,6 +546,7 @@ void Score::doLayout()
 //      qDebug("doLayout");
       {
       QWriteLocker locker(&_layoutLock);
+      ++_layoutGeneration;
 
       _symIdx = 0;
       if (_style.valueSt(ST_MusicalSymbolFont) == "Gonville")
@@ -2397,6 +2398,7 @@ void Score::doLayoutSystems()
       {
       /*--*/ {
             QWriteLocker locker(&_layoutLock);
+            ++_layoutGeneration;
             foreach(System* system, _systems)
                   system->layout2();
             layoutPages();
@@ -2416,6 +2418,7 @@ void Score::doLayoutPages()
       {
       /*--*/ {
             QWriteLocker locker(&_layoutLock);
+            ++_layoutGeneration;
             layoutPages();
             rebuildBspTree();
             _updateAll = true;
@@ -1895,7 +1895,7 @@ void Measure::read(XmlReader& e, int staffIdx)
       qreal _spatium = spatium();
       bool irregular;
 
-      e.tuplets().clear();
+      e.clearTuplets();
 
       for (int n = staves.size(); n <= staffIdx; ++n) {
             Staff* staff = score()->staff(n);
@@ -1933,11 +1933,11 @@ void Measure::read(XmlReader& e, int staffIdx)
       Fraction timeStretch(staff->timeStretch(tick()));
 
       while (e.readNextStartElement()) {
-            const QStringRef& tag(e.name());
+            XmlTag tag = e.token();
 
-            if (tag == "tick")
+            if (tag == XmlTag::tick)
                   e.setTick(e.readInt());
-            else if (tag == "BarLine") {
+            else if (tag == XmlTag::BarLine) {
                   BarLine* barLine = new BarLine(score());
                   barLine->setTrack(e.track());
                   barLine->read(e);
@@ -1957,7 +1957,7 @@ void Measure::read(XmlReader& e, int staffIdx)
                         }
                   segment->add(barLine);
                   }
-            else if (tag == "Chord") {
+            else if (tag == XmlTag::Chord) {
                   Chord* chord = new Chord(score());
                   chord->setTrack(e.track());
                   chord->read(e);
@@ -2036,7 +2036,7 @@ void Measure::read(XmlReader& e, int staffIdx)
                         }
                   segment->add(chord);
                   }
-            else if (tag == "Rest") {
+            else if (tag == XmlTag::Rest) {
                   Rest* rest = new Rest(score());
                   rest->setDurationType(TDuration::V_MEASURE);
                   rest->setDuration(timesig()/timeStretch);
@@ -2051,7 +2051,7 @@ void Measure::read(XmlReader& e, int staffIdx)
 
                   e.setTick(e.tick() + ts.ticks());
                   }
-            else if (tag == "Note") {                 // obsolete
+            else if (tag == XmlTag::Note) {                 // obsolete
                   Chord* chord = new Chord(score());
                   chord->setTrack(e.track());
                   chord->readNote(e);
@@ -2061,14 +2061,14 @@ void Measure::read(XmlReader& e, int staffIdx)
                   Fraction ts(timeStretch * chord->globalDuration());
                   e.setTick(e.tick() + ts.ticks());
                   }
-            else if (tag == "Breath") {
+            else if (tag == XmlTag::Breath) {
                   Breath* breath = new Breath(score());
                   breath->setTrack(e.track());
                   breath->read(e);
                   segment = getSegment(Segment::SegBreath, e.tick());
                   segment->add(breath);
                   }
-            else if (tag == "endSpanner") {
+            else if (tag == XmlTag::endSpanner) {
                   int id = e.attribute("id").toInt();
                   Spanner* spanner = score()->findSpanner(id);
                   if (spanner) {
@@ -2098,16 +2098,16 @@ void Measure::read(XmlReader& e, int staffIdx)
                         qDebug("Measure::read(): cannot find spanner %d", id);
                   e.readNext();
                   }
-            else if (tag == "HairPin"
-               || tag == "Pedal"
-               || tag == "Ottava"
-               || tag == "Trill"
-               || tag == "TextLine"
-               || tag == "Volta") {
-                  Spanner* sp = static_cast<Spanner*>(Element::name2Element(tag, score()));
-                  e.addSpanner(sp);
+            else if (tag == XmlTag::HairPin
+               || tag == XmlTag::Pedal
+               || tag == XmlTag::Ottava
+               || tag == XmlTag::Trill
+               || tag == XmlTag::TextLine
+               || tag == XmlTag::Volta) {
+                  Spanner* sp = static_cast<Spanner*>(Element::name2Element(e.name(), score()));
                   sp->setTrack(staffIdx * VOICES);
                   sp->read(e);
+                  e.addSpanner(sp);
                   segment = getSegment(Segment::SegChordRest, e.tick());
                   if (sp->anchor() == Spanner::ANCHOR_SEGMENT) {
                         sp->setStartElement(segment);
@@ -2118,7 +2118,7 @@ void Measure::read(XmlReader& e, int staffIdx)
                         add(sp);
                         }
                   }
-            else if (tag == "RepeatMeasure") {
+            else if (tag == XmlTag::RepeatMeasure) {
                   RepeatMeasure* rm = new RepeatMeasure(score());
                   rm->setTrack(e.track());
                   rm->read(e);
@@ -2126,7 +2126,7 @@ void Measure::read(XmlReader& e, int staffIdx)
                   segment->add(rm);
                   e.setTick(e.tick() + ticks());
                   }
-            else if (tag == "Clef") {
+            else if (tag == XmlTag::Clef) {
                   Clef* clef = new Clef(score());
                   clef->setTrack(e.track());
                   clef->read(e);
@@ -2153,7 +2153,7 @@ void Measure::read(XmlReader& e, int staffIdx)
                         }
                   segment->add(clef);
                   }
-            else if (tag == "TimeSig") {
+            else if (tag == XmlTag::TimeSig) {
                   TimeSig* ts = new TimeSig(score());
                   ts->setTrack(e.track());
                   ts->read(e);
@@ -2178,7 +2178,7 @@ void Measure::read(XmlReader& e, int staffIdx)
                               }
                         }
                   }
-            else if (tag == "KeySig") {
+            else if (tag == XmlTag::KeySig) {
                   KeySig* ks = new KeySig(score());
                   ks->setTrack(e.track());
                   ks->read(e);
@@ -2187,8 +2187,8 @@ void Measure::read(XmlReader& e, int staffIdx)
                   segment->add(ks);
                   staff->setKey(tick, ks->keySigEvent());
                   }
-            else if (tag == "Lyrics") {       // obsolete, keep for compatibility with version 114
-                  Element* element = Element::name2Element(tag, score());
+            else if (tag == XmlTag::Lyrics) {       // obsolete, keep for compatibility with version 114
+                  Element* element = Element::name2Element(e.name(), score());
                   element->setTrack(e.track());
                   element->read(e);
                   segment       = getSegment(Segment::SegChordRest, e.tick());
@@ -2198,7 +2198,7 @@ void Measure::read(XmlReader& e, int staffIdx)
                   else
                         cr->add(element);
                   }
-            else if (tag == "Text") {
+            else if (tag == XmlTag::Text) {
                   Text* t = new Text(score());
                   t->setTrack(e.track());
                   t->read(e);
@@ -2214,7 +2214,7 @@ void Measure::read(XmlReader& e, int staffIdx)
             //----------------------------------------------------
             // Annotation
 
-            else if (tag == "Dynamic") {
+            else if (tag == XmlTag::Dynamic) {
                   Dynamic* dyn = new Dynamic(score());
                   dyn->setTrack(e.track());
                   dyn->read(e);
@@ -2223,25 +2223,25 @@ void Measure::read(XmlReader& e, int staffIdx)
                   segment = getSegment(Segment::SegChordRest, e.tick());
                   segment->add(dyn);
                   }
-            else if (tag == "Harmony"
-               || tag == "FretDiagram"
-               || tag == "Symbol"
-               || tag == "Tempo"
-               || tag == "StaffText"
-               || tag == "RehearsalMark"
-               || tag == "InstrumentChange"
-               || tag == "Marker"
-               || tag == "Jump"
-               || tag == "StaffState"
-               || tag == "FiguredBass"
+            else if (tag == XmlTag::Harmony
+               || tag == XmlTag::FretDiagram
+               || tag == XmlTag::Symbol
+               || tag == XmlTag::Tempo
+               || tag == XmlTag::StaffText
+               || tag == XmlTag::RehearsalMark
+               || tag == XmlTag::InstrumentChange
+               || tag == XmlTag::Marker
+               || tag == XmlTag::Jump
+               || tag == XmlTag::StaffState
+               || tag == XmlTag::FiguredBass
                ) {
-                  Element* el = Element::name2Element(tag, score());
+                  Element* el = Element::name2Element(e.name(), score());
                   el->setTrack(e.track());
                   el->read(e);
                   segment = getSegment(Segment::SegChordRest, e.tick());
                   segment->add(el);
                   }
-            else if (tag == "Image") {
+            else if (tag == XmlTag::Image) {
                   Image* image = new Image(score());
                   image->setTrack(e.track());
                   image->read(e);
@@ -2250,24 +2250,24 @@ void Measure::read(XmlReader& e, int staffIdx)
                   }
 
             //----------------------------------------------------
-            else if (tag == "stretch")
+            else if (tag == XmlTag::stretch)
                   _userStretch = e.readDouble();
-            else if (tag == "LayoutBreak") {
+            else if (tag == XmlTag::LayoutBreak) {
                   LayoutBreak* lb = new LayoutBreak(score());
                   lb->read(e);
                   add(lb);
                   }
-            else if (tag == "noOffset")
+            else if (tag == XmlTag::noOffset)
                   _noOffset = e.readInt();
-            else if (tag == "irregular") {
+            else if (tag == XmlTag::irregular) {
                   _irregular = true;
                   e.readNext();
                   }
-            else if (tag == "breakMultiMeasureRest") {
+            else if (tag == XmlTag::breakMultiMeasureRest) {
                   _breakMultiMeasureRest = true;
                   e.readNext();
                   }
-            else if (tag == "Tuplet") {
+            else if (tag == XmlTag::Tuplet) {
                   Tuplet* tuplet = new Tuplet(score());
                   tuplet->setTrack(e.track());
                   tuplet->setTick(e.tick());
@@ -2275,21 +2275,21 @@ void Measure::read(XmlReader& e, int staffIdx)
                   tuplet->read(e);
                   e.addTuplet(tuplet);
                   }
-            else if (tag == "startRepeat") {
+            else if (tag == XmlTag::startRepeat) {
                   _repeatFlags |= RepeatStart;
                   e.readNext();
                   }
-            else if (tag == "endRepeat") {
+            else if (tag == XmlTag::endRepeat) {
                   _repeatCount = e.readInt();
                   _repeatFlags |= RepeatEnd;
                   }
-            else if (tag == "Slur") {
+            else if (tag == XmlTag::Slur) {
                   Slur* slur = new Slur(score());
                   slur->setTrack(e.track());
                   slur->read(e);
                   e.addSpanner(slur);
                   }
-            else if (tag == "vspacer" || tag == "vspacerDown") {
+            else if (tag == XmlTag::vspacer || tag == XmlTag::vspacerDown) {
                   if (staves[staffIdx]->_vspacerDown == 0) {
                         Spacer* spacer = new Spacer(score());
                         spacer->setSpacerType(SPACER_DOWN);
@@ -2298,7 +2298,7 @@ void Measure::read(XmlReader& e, int staffIdx)
                         }
                   staves[staffIdx]->_vspacerDown->setGap(e.readDouble() * _spatium);
                   }
-            else if (tag == "vspacer" || tag == "vspacerUp") {
+            else if (tag == XmlTag::vspacer || tag == XmlTag::vspacerUp) {
                   if (staves[staffIdx]->_vspacerUp == 0) {
                         Spacer* spacer = new Spacer(score());
                         spacer->setSpacerType(SPACER_UP);
@@ -2307,20 +2307,20 @@ void Measure::read(XmlReader& e, int staffIdx)
                         }
                   staves[staffIdx]->_vspacerUp->setGap(e.readDouble() * _spatium);
                   }
-            else if (tag == "visible")
+            else if (tag == XmlTag::visible)
                   staves[staffIdx]->_visible = e.readInt();
-            else if (tag == "slashStyle")
+            else if (tag == XmlTag::slashStyle)
                   staves[staffIdx]->_slashStyle = e.readInt();
-            else if (tag == "Beam") {
+            else if (tag == XmlTag::Beam) {
                   Beam* beam = new Beam(score());
                   beam->setTrack(e.track());
                   beam->read(e);
                   beam->setParent(0);
                   e.addBeam(beam);
                   }
-            else if (tag == "Segment")
+            else if (tag == XmlTag::Segment)
                   segment->read(e);
-            else if (tag == "MeasureNumber") {
+            else if (tag == XmlTag::MeasureNumber) {
                   Text* noText = new Text(score());
                   noText->read(e);
                   noText->setFlag(ELEMENT_ON_STAFF, true);
@@ -28,11 +28,14 @@
 
 namespace Ms {
 
+static QThreadStorage<QString> lastErrors;      // scores are loaded concurrently by batch jobs
+
 qreal MScore::PDPI = 1200;
 qreal MScore::DPI  = 1200;
 qreal MScore::DPMM;
 bool  MScore::debugMode;
 bool  MScore::testMode = false;
+bool  MScore::symbolGlyphCache = true;
 
 MStyle* MScore::_defaultStyle;
 MStyle* MScore::_baseStyle;
@@ -52,7 +55,6 @@ bool    MScore::panPlayback;
 qreal   MScore::nudgeStep;
 int     MScore::defaultPlayDuration;
 QString MScore::partStyle;
-QString MScore::lastError;
 bool    MScore::layoutDebug = false;
 int     MScore::division    = 480;
 int     MScore::sampleRate  = 44100;
@@ -126,8 +128,6 @@ void MScore::init()
       panPlayback         = true;
       partStyle           = "";
 
-      lastError           = "";
-
       layoutBreakColor    = Qt::gray;
       bgColor.setRgb(0x76, 0x76, 0x6e);
 
@@ -198,5 +198,25 @@ void MScore::setDefaultStyle(MStyle* s)
       _defaultStyle = s;
       }
 
+//---------------------------------------------------------
+//   lastError
+//    the error of the last failed file operation of the
+//    calling thread
+//---------------------------------------------------------
+
+QString MScore::lastError()
+      {
+      return lastErrors.localData();
+      }
+
+//---------------------------------------------------------
+//   setLastError
+//---------------------------------------------------------
+
+void MScore::setLastError(const QString& s)
+      {
+      lastErrors.setLocalData(s);
+      }
+
 }
 
@@ -382,7 +382,8 @@ class MScore : public QObject {
       static qreal nudgeStep;
       static int defaultPlayDuration;
       static QString partStyle;
-      static QString lastError;
+      static QString lastError();
+      static void setLastError(const QString&);
       static bool layoutDebug;
 
       static int division;
@@ -395,6 +396,7 @@ class MScore : public QObject {
       static qreal DPMM;
       static bool debugMode;
       static bool testMode;
+      static bool symbolGlyphCache;       // draw symbols from cached glyph runs on raster devices
       };
 
 static const int HEAD_TYPES = 4;
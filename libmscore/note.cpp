@@ -724,212 +724,242 @@ void Note::read(XmlReader& e)
             _tpc = e.intAttribute("tpc");
 
       while (e.readNextStartElement()) {
-            const QStringRef& tag(e.name());
-            if (tag == "pitch")
-                  _pitch = e.readInt();
-            else if (tag == "tpc")
-                  _tpc = e.readInt();
-            else if (tag == "small")
-                  setSmall(e.readInt());
-            else if (tag == "mirror")
-                  setProperty(P_MIRROR_HEAD, Ms::getProperty(P_MIRROR_HEAD, e));
-            else if (tag == "dotPosition")
-                  setProperty(P_DOT_POSITION, Ms::getProperty(P_DOT_POSITION, e));
-            else if (tag == "onTimeOffset")
-                  e.skipCurrentElement(); // TODO setOnTimeUserOffset(val.toInt());
-            else if (tag == "offTimeOffset")
-                  e.skipCurrentElement(); // TODO setOffTimeUserOffset(val.toInt());
-            else if (tag == "head")
-                  setProperty(P_HEAD_GROUP, Ms::getProperty(P_HEAD_GROUP, e));
-            else if (tag == "velocity")
-                  setVeloOffset(e.readInt());
-            else if (tag == "tuning")
-                  setTuning(e.readDouble());
-            else if (tag == "fret")
-                  setFret(e.readInt());
-            else if (tag == "string")
-                  setString(e.readInt());
-            else if (tag == "ghost")
-                  setGhost(e.readInt());
-            else if (tag == "headType")
-                  setProperty(P_HEAD_TYPE, Ms::getProperty(P_HEAD_TYPE, e));
-            else if (tag == "veloType")
-                  setProperty(P_VELO_TYPE, Ms::getProperty(P_VELO_TYPE, e));
-            else if (tag == "line")
-                  _line = e.readInt();
-            else if (tag == "Tie") {
-                  _tieFor = new Tie(score());
-                  _tieFor->setTrack(track());
-                  _tieFor->read(e);
-                  _tieFor->setStartNote(this);
-                  }
-            else if (tag == "Fingering" || tag == "Text") {       // Text is obsolete
-                  Fingering* f = new Fingering(score());
-                  f->setTextStyleType(TEXT_STYLE_FINGERING);
-                  f->read(e);
-                  add(f);
-                  }
-            else if (tag == "Symbol") {
-                  Symbol* s = new Symbol(score());
-                  s->setTrack(track());
-                  s->read(e);
-                  add(s);
-                  }
-            else if (tag == "Image") {
-                  Image* image = new Image(score());
-                  image->setTrack(track());
-                  image->read(e);
-                  add(image);
-                  }
-            else if (tag == "userAccidental") {
-                  QString val(e.readElementText());
-                  bool ok;
-                  int k = val.toInt(&ok);
-                  if (ok) {
+            switch (e.token()) {
+                  case XmlTag::pitch:
+                        _pitch = e.readInt();
+                        break;
+                  case XmlTag::tpc:
+                        _tpc = e.readInt();
+                        break;
+                  case XmlTag::small_:
+                        setSmall(e.readInt());
+                        break;
+                  case XmlTag::mirror:
+                        setProperty(P_MIRROR_HEAD, Ms::getProperty(P_MIRROR_HEAD, e));
+                        break;
+                  case XmlTag::dotPosition:
+                        setProperty(P_DOT_POSITION, Ms::getProperty(P_DOT_POSITION, e));
+                        break;
+                  case XmlTag::onTimeOffset:
+                        e.skipCurrentElement(); // TODO setOnTimeUserOffset(val.toInt());
+                        break;
+                  case XmlTag::offTimeOffset:
+                        e.skipCurrentElement(); // TODO setOffTimeUserOffset(val.toInt());
+                        break;
+                  case XmlTag::head:
+                        setProperty(P_HEAD_GROUP, Ms::getProperty(P_HEAD_GROUP, e));
+                        break;
+                  case XmlTag::velocity:
+                        setVeloOffset(e.readInt());
+                        break;
+                  case XmlTag::tuning:
+                        setTuning(e.readDouble());
+                        break;
+                  case XmlTag::fret:
+                        setFret(e.readInt());
+                        break;
+                  case XmlTag::string:
+                        setString(e.readInt());
+                        break;
+                  case XmlTag::ghost:
+                        setGhost(e.readInt());
+                        break;
+                  case XmlTag::headType:
+                        setProperty(P_HEAD_TYPE, Ms::getProperty(P_HEAD_TYPE, e));
+                        break;
+                  case XmlTag::veloType:
+                        setProperty(P_VELO_TYPE, Ms::getProperty(P_VELO_TYPE, e));
+                        break;
+                  case XmlTag::line:
+                        _line = e.readInt();
+                        break;
+                  case XmlTag::Tie:
+                        _tieFor = new Tie(score());
+                        _tieFor->setTrack(track());
+                        _tieFor->read(e);
+                        _tieFor->setStartNote(this);
+                        break;
+                  case XmlTag::Fingering:
+                  case XmlTag::Text: {          // Text is obsolete
+                        Fingering* f = new Fingering(score());
+                        f->setTextStyleType(TEXT_STYLE_FINGERING);
+                        f->read(e);
+                        add(f);
+                        }
+                        break;
+                  case XmlTag::Symbol: {
+                        Symbol* s = new Symbol(score());
+                        s->setTrack(track());
+                        s->read(e);
+                        add(s);
+                        }
+                        break;
+                  case XmlTag::Image: {
+                        Image* image = new Image(score());
+                        image->setTrack(track());
+                        image->read(e);
+                        add(image);
+                        }
+                        break;
+                  case XmlTag::userAccidental: {
+                        QString val(e.readElementText());
+                        bool ok;
+                        int k = val.toInt(&ok);
+                        if (ok) {
+                              // on older scores, a note could have both a <userAccidental> tag and an <Accidental> tag
+                              // if a userAccidental has some other property set (like for instance offset)
+                              // only costruct a new accidental, if the other tag has not been read yet
+                              // (<userAccidental> tag is only used in older scores: no need to check the score mscVersion)
+                              if (!hasAccidental) {
+                                    _accidental = new Accidental(score());
+                                    _accidental->setParent(this);
+                                    }
+                              // TODO: for backward compatibility
+                              bool bracket = k & 0x8000;
+                              k &= 0xfff;
+                              Accidental::AccidentalType at = Accidental::ACC_NONE;
+                              switch(k) {
+                                    case 0: at = Accidental::ACC_NONE; break;
+                                    case 1:
+                                    case 11: at = Accidental::ACC_SHARP; break;
+                                    case 2:
+                                    case 12: at = Accidental::ACC_FLAT; break;
+                                    case 3:
+                                    case 13: at = Accidental::ACC_SHARP2; break;
+                                    case 4:
+                                    case 14: at = Accidental::ACC_FLAT2; break;
+                                    case 5:
+                                    case 15: at = Accidental::ACC_NATURAL; break;
+
+                                    case 6:  at = Accidental::ACC_SHARP; bracket = true; break;
+                                    case 7:  at = Accidental::ACC_FLAT; bracket = true; break;
+                                    case 8:  at = Accidental::ACC_SHARP2; bracket = true; break;
+                                    case 9:  at = Accidental::ACC_FLAT2; bracket = true; break;
+                                    case 10: at = Accidental::ACC_NATURAL; bracket = true; break;
+
+                                    case 16: at = Accidental::ACC_FLAT_SLASH; break;
+                                    case 17: at = Accidental::ACC_FLAT_SLASH2; break;
+                                    case 18: at = Accidental::ACC_MIRRORED_FLAT2; break;
+                                    case 19: at = Accidental::ACC_MIRRORED_FLAT; break;
+                                    case 20: at = Accidental::ACC_MIRRIRED_FLAT_SLASH; break;
+                                    case 21: at = Accidental::ACC_FLAT_FLAT_SLASH; break;
+
+                                    case 22: at = Accidental::ACC_SHARP_SLASH; break;
+                                    case 23: at = Accidental::ACC_SHARP_SLASH2; break;
+                                    case 24: at = Accidental::ACC_SHARP_SLASH3; break;
+                                    case 25: at = Accidental::ACC_SHARP_SLASH4; break;
+
+                                    case 26: at = Accidental::ACC_SHARP_ARROW_UP; break;
+                                    case 27: at = Accidental::ACC_SHARP_ARROW_DOWN; break;
+                                    case 28: at = Accidental::ACC_SHARP_ARROW_BOTH; break;
+                                    case 29: at = Accidental::ACC_FLAT_ARROW_UP; break;
+                                    case 30: at = Accidental::ACC_FLAT_ARROW_DOWN; break;
+                                    case 31: at = Accidental::ACC_FLAT_ARROW_BOTH; break;
+                                    case 32: at = Accidental::ACC_NATURAL_ARROW_UP; break;
+                                    case 33: at = Accidental::ACC_NATURAL_ARROW_DOWN; break;
+                                    case 34: at = Accidental::ACC_NATURAL_ARROW_BOTH; break;
+                                    }
+                              _accidental->setAccidentalType(at);
+                              _accidental->setHasBracket(bracket);
+                              _accidental->setRole(Accidental::ACC_USER);
+                              hasAccidental = true;   // we now have an accidental
+                              }
+                        }
+                        break;
+                  case XmlTag::Accidental: {
                         // on older scores, a note could have both a <userAccidental> tag and an <Accidental> tag
                         // if a userAccidental has some other property set (like for instance offset)
-                        // only costruct a new accidental, if the other tag has not been read yet
-                        // (<userAccidental> tag is only used in older scores: no need to check the score mscVersion)
-                        if (!hasAccidental) {
-                              _accidental = new Accidental(score());
-                              _accidental->setParent(this);
+                        Accidental* a;
+                        if (hasAccidental)            // if the other tag has already been read,
+                              a = _accidental;        // re-use the accidental it constructed
+                        else
+                              a = new Accidental(score());
+                        // the accidental needs to know the properties of the
+                        // track it belongs to (??)
+                        a->setTrack(track());
+                        a->read(e);
+                        if (!hasAccidental)           // only the new accidental, if it has been added previously
+                              add(a);
+                        if (score()->mscVersion() < 117)
+                              hasAccidental = true;   // we now have an accidental
+                        }
+                        break;
+                  case XmlTag::move:            // obsolete
+                        chord()->setStaffMove(e.readInt());
+                        break;
+                  case XmlTag::Bend: {
+                        Bend* b = new Bend(score());
+                        b->setTrack(track());
+                        b->read(e);
+                        add(b);
+                        }
+                        break;
+                  case XmlTag::NoteDot: {
+                        NoteDot* dot = new NoteDot(score());
+                        dot->read(e);
+                        for (int i = 0; i < 3; ++i) {
+                              if (_dots[i] == 0) {
+                                    dot->setIdx(i);
+                                    add(dot);
+                                    dot = 0;
+                                    break;
+                                    }
                               }
-                        // TODO: for backward compatibility
-                        bool bracket = k & 0x8000;
-                        k &= 0xfff;
-                        Accidental::AccidentalType at = Accidental::ACC_NONE;
-                        switch(k) {
-                              case 0: at = Accidental::ACC_NONE; break;
-                              case 1:
-                              case 11: at = Accidental::ACC_SHARP; break;
-                              case 2:
-                              case 12: at = Accidental::ACC_FLAT; break;
-                              case 3:
-                              case 13: at = Accidental::ACC_SHARP2; break;
-                              case 4:
-                              case 14: at = Accidental::ACC_FLAT2; break;
-                              case 5:
-                              case 15: at = Accidental::ACC_NATURAL; break;
-
-                              case 6:  at = Accidental::ACC_SHARP; bracket = true; break;
-                              case 7:  at = Accidental::ACC_FLAT; bracket = true; break;
-                              case 8:  at = Accidental::ACC_SHARP2; bracket = true; break;
-                              case 9:  at = Accidental::ACC_FLAT2; bracket = true; break;
-                              case 10: at = Accidental::ACC_NATURAL; bracket = true; break;
-
-                              case 16: at = Accidental::ACC_FLAT_SLASH; break;
-                              case 17: at = Accidental::ACC_FLAT_SLASH2; break;
-                              case 18: at = Accidental::ACC_MIRRORED_FLAT2; break;
-                              case 19: at = Accidental::ACC_MIRRORED_FLAT; break;
-                              case 20: at = Accidental::ACC_MIRRIRED_FLAT_SLASH; break;
-                              case 21: at = Accidental::ACC_FLAT_FLAT_SLASH; break;
-
-                              case 22: at = Accidental::ACC_SHARP_SLASH; break;
-                              case 23: at = Accidental::ACC_SHARP_SLASH2; break;
-                              case 24: at = Accidental::ACC_SHARP_SLASH3; break;
-                              case 25: at = Accidental::ACC_SHARP_SLASH4; break;
-
-                              case 26: at = Accidental::ACC_SHARP_ARROW_UP; break;
-                              case 27: at = Accidental::ACC_SHARP_ARROW_DOWN; break;
-                              case 28: at = Accidental::ACC_SHARP_ARROW_BOTH; break;
-                              case 29: at = Accidental::ACC_FLAT_ARROW_UP; break;
-                              case 30: at = Accidental::ACC_FLAT_ARROW_DOWN; break;
-                              case 31: at = Accidental::ACC_FLAT_ARROW_BOTH; break;
-                              case 32: at = Accidental::ACC_NATURAL_ARROW_UP; break;
-                              case 33: at = Accidental::ACC_NATURAL_ARROW_DOWN; break;
-                              case 34: at = Accidental::ACC_NATURAL_ARROW_BOTH; break;
+                        if (dot) {
+                              qDebug("Note: too many dots\n");
+                              delete dot;
                               }
-                        _accidental->setAccidentalType(at);
-                        _accidental->setHasBracket(bracket);
-                        _accidental->setRole(Accidental::ACC_USER);
-                        hasAccidental = true;   // we now have an accidental
                         }
-                  }
-            else if (tag == "Accidental") {
-                  // on older scores, a note could have both a <userAccidental> tag and an <Accidental> tag
-                  // if a userAccidental has some other property set (like for instance offset)
-                  Accidental* a;
-                  if (hasAccidental)            // if the other tag has already been read,
-                        a = _accidental;        // re-use the accidental it constructed
-                  else
-                        a = new Accidental(score());
-                  // the accidental needs to know the properties of the
-                  // track it belongs to (??)
-                  a->setTrack(track());
-                  a->read(e);
-                  if (!hasAccidental)           // only the new accidental, if it has been added previously
-                        add(a);
-                  if (score()->mscVersion() < 117)
-                        hasAccidental = true;   // we now have an accidental
-                  }
-            else if (tag == "move")             // obsolete
-                  chord()->setStaffMove(e.readInt());
-            else if (tag == "Bend") {
-                  Bend* b = new Bend(score());
-                  b->setTrack(track());
-                  b->read(e);
-                  add(b);
-                  }
-            else if (tag == "NoteDot") {
-                  NoteDot* dot = new NoteDot(score());
-                  dot->read(e);
-                  for (int i = 0; i < 3; ++i) {
-                        if (_dots[i] == 0) {
-                              dot->setIdx(i);
-                              add(dot);
-                              dot = 0;
-                              break;
+                        break;
+                  case XmlTag::Events:
+                        while (e.readNextStartElement()) {
+                              if (e.token() == XmlTag::Event) {
+                                    NoteEvent ne;
+                                    ne.read(e);
+                                    _playEvents.append(ne);
+                                    }
+                              else
+                                    e.unknown();
                               }
-                        }
-                  if (dot) {
-                        qDebug("Note: too many dots\n");
-                        delete dot;
-                        }
-                  }
-            else if (tag == "Events") {
-                  while (e.readNextStartElement()) {
-                        const QStringRef& tag(e.name());
-                        if (tag == "Event") {
-                              NoteEvent ne;
-                              ne.read(e);
-                              _playEvents.append(ne);
+                        if (chord())
+                              chord()->setUserPlayEvents(true);
+                        break;
+                  case XmlTag::endSpanner: {
+                        int id = e.intAttribute("id");
+                        Spanner* e = score()->findSpanner(id);
+                        if (e) {
+                              e->setEndElement(this);
+                              addSpannerBack(e);
                               }
                         else
-                              e.unknown();
+                              qDebug("Note::read(): cannot find spanner %d", id);
                         }
-                  if (chord())
-                        chord()->setUserPlayEvents(true);
-                  }
-            else if (tag == "endSpanner") {
-                  int id = e.intAttribute("id");
-                  Spanner* e = score()->findSpanner(id);
-                  if (e) {
-                        e->setEndElement(this);
-                        addSpannerBack(e);
+                        break;
+                  case XmlTag::TextLine: {
+                        Spanner* sp = static_cast<Spanner*>(Element::name2Element(e.name(), score()));
+                        sp->setTrack(track());
+                        sp->read(e);
+                        sp->setAnchor(Spanner::ANCHOR_NOTE);
+                        sp->setStartElement(this);
+                        addSpannerFor(sp);
+                        sp->setParent(this);
+                        e.addSpanner(sp);
                         }
-                  else
-                        qDebug("Note::read(): cannot find spanner %d", id);
-                  }
-            else if (tag == "TextLine") {
-                  Spanner* sp = static_cast<Spanner*>(Element::name2Element(tag, score()));
-                  sp->setTrack(track());
-                  sp->read(e);
-                  sp->setAnchor(Spanner::ANCHOR_NOTE);
-                  sp->setStartElement(this);
-                  addSpannerFor(sp);
-                  sp->setParent(this);
-                  e.addSpanner(sp);
+                        break;
+                  case XmlTag::onTimeType:      // obsolete
+                        e.skipCurrentElement(); // _onTimeType = readValueType(e);
+                        break;
+                  case XmlTag::offTimeType:     // obsolete
+                        e.skipCurrentElement(); // _offTimeType = readValueType(e);
+                        break;
+                  case XmlTag::tick:            // bad input file
+                        e.skipCurrentElement();
+                        break;
+                  default:
+                        if (!Element::readProperties(e))
+                              e.unknown();
+                        break;
                   }
-            else if (tag == "onTimeType")                   // obsolete
-                  e.skipCurrentElement(); // _onTimeType = readValueType(e);
-            else if (tag == "offTimeType")                  // obsolete
-                  e.skipCurrentElement(); // _offTimeType = readValueType(e);
-            else if (tag == "tick")                         // bad input file
-                  e.skipCurrentElement();
-            else if (Element::readProperties(e))
-                  ;
-            else
-                  e.unknown();
             }
       // ensure sane values:
       _pitch = restrict(_pitch, 0, 127);
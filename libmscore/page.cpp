@@ -129,7 +129,8 @@ Page::Page(Score* s)
    : Element(s),
    _no(0)
       {
-      bspTreeValid = false;
+      bspTreeValid     = false;
+      displayListValid = false;
       }
 
 Page::~Page()
@@ -882,6 +883,26 @@ QList<const Element*> Page::elements()
       return el;
       }
 
+//---------------------------------------------------------
+//   displayList
+//    the visible elements in paint order; built on first
+//    use after a layout, as the bsp tree. Elements can be
+//    moved by edits without a relayout, so their positions
+//    are taken at paint time. Pages can be prepared
+//    concurrently.
+//---------------------------------------------------------
+
+const QVector<const Element*>& Page::displayList()
+      {
+      if (!displayListValid) {
+            QList<const Element*> el = elements();
+            qStableSort(el.begin(), el.end(), elementLessThan);
+            _displayList = el.toVector();
+            displayListValid = true;
+            }
+      return _displayList;
+      }
+
 //---------------------------------------------------------
 //   tm
 //---------------------------------------------------------
@@ -129,6 +129,8 @@ class Page : public Element {
       void doRebuildBspTree();
 #endif
       bool bspTreeValid;
+      QVector<const Element*> _displayList;
+      bool displayListValid;
 
       QString replaceTextMacros(const QString&) const;
       void drawStyledHeaderFooter(QPainter*, int area, const QPointF&, const QString&) const;
@@ -160,13 +162,14 @@ class Page : public Element {
 
       QList<Element*> items(const QRectF& r);
       QList<Element*> items(const QPointF& p);
-      void rebuildBspTree()   { bspTreeValid = false; }
+      void rebuildBspTree()   { bspTreeValid = false; displayListValid = false; }
       QPointF pagePos() const { return QPointF(); }     ///< position in page coordinates
       QList<System*> searchSystem(const QPointF& pos) const;
       Measure* searchMeasure(const QPointF& p) const;
       MeasureBase* pos2measure(const QPointF&, int* staffIdx, int* pitch,
          Segment**, QPointF* offset) const;
       QList<const Element*> elements();         ///< list of visible elements
+      const QVector<const Element*>& displayList();
       };
 
 extern const PaperSize paperSizes[];
@@ -226,7 +226,7 @@ static int inflate(Bytef *dest, ulong *destLen, const Bytef *source, ulong sourc
     return err;
 }
 
-static int deflate (Bytef *dest, ulong *destLen, const Bytef *source, ulong sourceLen)
+static int deflate (Bytef *dest, ulong *destLen, const Bytef *source, ulong sourceLen, int level)
 {
     z_stream stream;
     int err;
@@ -241,7 +241,7 @@ static int deflate (Bytef *dest, ulong *destLen, const Bytef *source, ulong sour
     stream.zfree = (free_func)0;
     stream.opaque = (voidpf)0;
 
-    err = deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+    err = deflateInit2(&stream, level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
     if (err != Z_OK) return err;
 
     err = deflate(&stream, Z_FINISH);
@@ -255,6 +255,73 @@ static int deflate (Bytef *dest, ulong *destLen, const Bytef *source, ulong sour
     return err;
 }
 
+/*
+    Large entries are split into chunks which are compressed
+    independently, pigz style: every chunk but the last ends with a
+    sync flush, so the concatenation is one valid raw deflate stream,
+    and every chunk is primed with the last 32k of the data before it,
+    so the compression ratio stays close to a single deflate call.
+*/
+enum { DeflateChunkSize = 128 * 1024, DeflateDictSize = 32 * 1024 };
+
+struct DeflateChunk
+{
+    const QByteArray *contents;
+    int offset;
+    int length;
+    bool last;
+    int level;
+    QByteArray data;
+    uint crc;
+    int result;
+};
+
+static void deflateChunk(DeflateChunk &c)
+{
+    const Bytef *source = (const Bytef *)c.contents->constData();
+    c.crc = ::crc32(::crc32(0, 0, 0), source + c.offset, c.length);
+
+    if (c.offset == 0 && c.last) {
+        // the whole entry in one call, same output as before chunking
+        ulong len = c.length;
+        // shamelessly copied form zlib
+        len += (len >> 12) + (len >> 14) + 11;
+        do {
+            c.data.resize(len);
+            c.result = deflate((uchar*)c.data.data(), &len, source, c.length, c.level);
+            if (c.result == Z_OK)
+                c.data.resize(len);
+            else if (c.result == Z_BUF_ERROR)
+                len *= 2;
+        } while (c.result == Z_BUF_ERROR);
+        return;
+    }
+
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+    c.result = deflateInit2(&stream, c.level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+    if (c.result != Z_OK)
+        return;
+    if (c.offset > 0) {
+        int dictSize = qMin(c.offset, int(DeflateDictSize));
+        deflateSetDictionary(&stream, source + c.offset - dictSize, dictSize);
+    }
+    // room for the sync flush marker and the stream end
+    c.data.resize(deflateBound(&stream, c.length) + 16);
+    stream.next_in = (Bytef*)source + c.offset;
+    stream.avail_in = c.length;
+    stream.next_out = (Bytef*)c.data.data();
+    stream.avail_out = c.data.size();
+
+    int err = deflate(&stream, c.last ? Z_FINISH : Z_SYNC_FLUSH);
+    if (c.last)
+        c.result = err == Z_STREAM_END ? Z_OK : (err == Z_OK ? Z_BUF_ERROR : err);
+    else
+        c.result = (err == Z_OK && stream.avail_in == 0 && stream.avail_out > 0) ? Z_OK : Z_BUF_ERROR;
+    c.data.resize(stream.total_out);
+    deflateEnd(&stream);
+}
+
 static QFile::Permissions modeToPermissions(quint32 mode)
 {
     QFile::Permissions ret;
@@ -452,17 +519,29 @@ public:
         : QZipPrivate(device, ownDev),
         status(QZipWriter::NoError),
         permissions(QFile::ReadOwner | QFile::WriteOwner),
-        compressionPolicy(QZipWriter::AlwaysCompress)
+        compressionPolicy(QZipWriter::AlwaysCompress),
+        compressionLevel(Z_DEFAULT_COMPRESSION)
     {
     }
 
     QZipWriter::Status status;
     QFile::Permissions permissions;
     QZipWriter::CompressionPolicy compressionPolicy;
+    int compressionLevel;
 
     enum EntryType { Directory, File, Symlink };
 
+    // entries are compressed concurrently and written on close()
+    struct PendingEntry
+    {
+        FileHeader header;
+        QByteArray contents;
+        bool compress;
+    };
+    QList<PendingEntry> pending;
+
     void addEntry(EntryType type, const QString &fileName, const QByteArray &contents);
+    void writePending();
 };
 
 LocalFileHeader CentralFileHeader::toLocalHeader() const
@@ -584,7 +663,6 @@ void QZipWriterPrivate::addEntry(EntryType type, const QString &fileName, const
         status = QZipWriter::FileOpenError;
         return;
     }
-    device->seek(start_of_directory);
 
     // don't compress small files
     QZipWriter::CompressionPolicy compression = compressionPolicy;
@@ -595,45 +673,19 @@ void QZipWriterPrivate::addEntry(EntryType type, const QString &fileName, const
             compression = QZipWriter::AlwaysCompress;
     }
 
-    FileHeader header;
+    PendingEntry entry;
+    entry.contents = contents;
+    entry.compress = compression == QZipWriter::AlwaysCompress;
+    FileHeader &header = entry.header;
     memset(&header.h, 0, sizeof(CentralFileHeader));
     writeUInt(header.h.signature, 0x02014b50);
 
     writeUShort(header.h.version_needed, 0x14);
     writeUInt(header.h.uncompressed_size, contents.length());
     writeMSDosDate(header.h.last_mod_file, QDateTime::currentDateTime());
-    QByteArray data = contents;
-    if (compression == QZipWriter::AlwaysCompress) {
+    if (entry.compress)
         writeUShort(header.h.compression_method, 8);
 
-       ulong len = contents.length();
-        // shamelessly copied form zlib
-        len += (len >> 12) + (len >> 14) + 11;
-        int res;
-        do {
-            data.resize(len);
-            res = deflate((uchar*)data.data(), &len, (const uchar*)contents.constData(), contents.length());
-
-            switch (res) {
-            case Z_OK:
-                data.resize(len);
-                break;
-            case Z_MEM_ERROR:
-                qWarning("QZip: Z_MEM_ERROR: Not enough memory to compress file, skipping");
-                data.resize(0);
-                break;
-            case Z_BUF_ERROR:
-                len *= 2;
-                break;
-            }
-        } while (res == Z_BUF_ERROR);
-    }
-// TODO add a check if data.length() > contents.length().  Then try to store the original and revert the compression method to be uncompressed
-    writeUInt(header.h.compressed_size, data.length());
-    uint crc_32 = ::crc32(0, 0, 0);
-    crc_32 = ::crc32(crc_32, (const uchar *)contents.constData(), contents.length());
-    writeUInt(header.h.crc_32, crc_32);
-
     header.file_name = fileName.toLocal8Bit();
     if (header.file_name.size() > 0xffff) {
         qWarning("QZip: Filename too long, chopping it to 65535 characters");
@@ -652,16 +704,85 @@ void QZipWriterPrivate::addEntry(EntryType type, const QString &fileName, const
         case Symlink: mode |= S_IFLNK; break;
     }
     writeUInt(header.h.external_file_attributes, mode << 16);
-    writeUInt(header.h.offset_local_header, start_of_directory);
 
+    pending.append(entry);
+}
+
+/*
+    Compresses all pending entries, chunks of all entries at once on
+    the global thread pool, and writes them in the order they were
+    added.
+*/
+void QZipWriterPrivate::writePending()
+{
+    if (pending.isEmpty())
+        return;
+
+    QList<DeflateChunk> chunks;
+    QVector<int> firstChunk(pending.size(), 0);
+    QVector<int> endChunk(pending.size(), 0);
+    for (int i = 0; i < pending.size(); ++i) {
+        const PendingEntry &entry = pending.at(i);
+        if (!entry.compress)
+            continue;
+        firstChunk[i] = chunks.size();
+        int size = entry.contents.size();
+        int offset = 0;
+        do {
+            DeflateChunk c;
+            c.contents = &entry.contents;
+            c.offset = offset;
+            c.length = qMin(int(DeflateChunkSize), size - offset);
+            c.last = offset + c.length == size;
+            c.level = compressionLevel;
+            c.crc = 0;
+            c.result = Z_OK;
+            chunks.append(c);
+            offset += c.length;
+        } while (offset < size);
+        endChunk[i] = chunks.size();
+    }
+    if (chunks.size() > 1)
+        QtConcurrent::blockingMap(chunks, deflateChunk);
+    else if (chunks.size() == 1)
+        deflateChunk(chunks.first());
+
+    device->seek(start_of_directory);
+    for (int i = 0; i < pending.size(); ++i) {
+        PendingEntry &entry = pending[i];
+        FileHeader &header = entry.header;
+        QByteArray data;
+        uint crc_32 = ::crc32(0, 0, 0);
+        if (entry.compress) {
+            for (int k = firstChunk[i]; k < endChunk[i]; ++k) {
+                const DeflateChunk &c = chunks.at(k);
+                if (c.result != Z_OK) {
+                    qWarning("QZip: error %d: cannot compress file, skipping", c.result);
+                    data.resize(0);
+                    break;
+                }
+                data += c.data;
+                crc_32 = ::crc32_combine(crc_32, c.crc, c.length);
+            }
+        }
+        else {
+            data = entry.contents;
+            crc_32 = ::crc32(crc_32, (const uchar *)data.constData(), data.length());
+        }
+// TODO add a check if data.length() > contents.length().  Then try to store the original and revert the compression method to be uncompressed
+        writeUInt(header.h.compressed_size, data.length());
+        writeUInt(header.h.crc_32, crc_32);
+        writeUInt(header.h.offset_local_header, start_of_directory);
 
-    fileHeaders.append(header);
+        fileHeaders.append(header);
 
-    LocalFileHeader h = header.h.toLocalHeader();
-    device->write((const char *)&h, sizeof(LocalFileHeader));
-    device->write(header.file_name);
-    device->write(data);
-    start_of_directory = device->pos();
+        LocalFileHeader h = header.h.toLocalHeader();
+        device->write((const char *)&h, sizeof(LocalFileHeader));
+        device->write(header.file_name);
+        device->write(data);
+        start_of_directory = device->pos();
+    }
+    pending.clear();
     dirtyFileTree = true;
 }
 
@@ -1137,6 +1258,27 @@ QZipWriter::CompressionPolicy QZipWriter::compressionPolicy() const
     return d->compressionPolicy;
 }
 
+/*!
+    Sets the zlib compression \a level (1 fastest .. 9 best, -1 zlib default)
+    used for compressed files. Store-only archives are written with the
+    NeverCompress policy.
+
+    \sa setCompressionPolicy()
+*/
+void QZipWriter::setCompressionLevel(int level)
+{
+    d->compressionLevel = level;
+}
+
+/*!
+    Returns the compression level.
+    \sa setCompressionLevel()
+*/
+int QZipWriter::compressionLevel() const
+{
+    return d->compressionLevel;
+}
+
 /*!
     Sets the permissions that will be used for newly added files.
 
@@ -1235,6 +1377,7 @@ void QZipWriter::close()
         return;
     }
 
+    d->writePending();
     //qDebug("QZip::close writing directory, %d entries", d->fileHeaders.size());
     d->device->seek(d->start_of_directory);
     // write new directory
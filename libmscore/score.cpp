@@ -307,6 +307,7 @@ void Score::init()
 
       _updateAll      = true;
       _layoutAll      = true;
+      _layoutGeneration = 0;
       layoutFlags     = 0;
       _undoRedo       = false;
       _playNote       = false;
@@ -699,6 +700,7 @@ void Score::setShowInvisible(bool v)
       {
       _showInvisible = v;
       _updateAll     = true;
+      rebuildBspTree();       // invisible elements are scanned only if shown
       end();
       }
 
@@ -182,6 +182,24 @@ struct Position {
       QPointF pos;
       };
 
+//---------------------------------------------------------
+//   MsczContents
+//    snapshot of everything that goes into a .mscz file;
+//    collected from the score on the gui thread, write()
+//    does the compression and may run in any thread
+//---------------------------------------------------------
+
+struct MsczContents {
+      QString rootName;                               // name of the .mscx entry
+      QByteArray container;                           // META-INF/container.xml
+      QList<QPair<QString, QByteArray> > pictures;
+      QList<QImage> omrPages;                         // encoded as png by write()
+      QByteArray audio;
+      QByteArray score;
+
+      void write(QIODevice*, int compressionLevel = -1) const;
+      };
+
 //---------------------------------------------------------
 //   LayoutFlag bits
 //---------------------------------------------------------
@@ -300,6 +318,7 @@ class Score : public QObject {
 
       bool _updateAll;
       bool _layoutAll;        ///< do a complete relayout
+      int _layoutGeneration;  ///< incremented on every layout
 
       bool _undoRedo;         ///< true if in processing a undo/redo
       bool _playNote;         ///< play selected note after command
@@ -599,9 +618,12 @@ class Score : public QObject {
       void saveFile(QIODevice* f, bool msczFormat, bool onlySelection = false);
       void saveCompressedFile(QFileInfo&, bool onlySelection);
       void saveCompressedFile(QIODevice*, QFileInfo&, bool onlySelection);
+      MsczContents msczContents(QFileInfo&, bool onlySelection);
       bool exportFile();
 
       void print(QPainter* printer, int page);
+      void print(QPainter* printer, const QVector<const Element*>& dl);
+      QList<Element*> printElements(int page);
       ChordRest* getSelectedChordRest() const;
       void getSelectedChordRest2(ChordRest** cr1, ChordRest** cr2) const;
 
@@ -896,6 +918,7 @@ class Score : public QObject {
       void setLayoutMode(LayoutMode lm);
 
       QReadWriteLock* layoutLock() { return &_layoutLock; }
+      int layoutGeneration() const { return _layoutGeneration; }
       void doLayoutSystems();
       void doLayoutPages();
       Tuplet* searchTuplet(XmlReader& e, int id);
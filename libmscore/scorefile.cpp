@@ -257,7 +257,7 @@ bool Score::saveFile()
       QString suffix = info.suffix();
       if (info.exists() && !info.isWritable()) {
             QString s = QT_TRANSLATE_NOOP("file", "The following file is locked: \n%1 \n\nTry saving to a different location.");
-            MScore::lastError = s.arg(info.filePath());
+            MScore::setLastError(s.arg(info.filePath()));
             return false;
             }
 
@@ -272,7 +272,7 @@ bool Score::saveFile()
                         saveCompressedFile(info, false);
                   }
             catch (QString s) {
-                  MScore::lastError = s;
+                  MScore::setLastError(s);
                   return false;
                   }
             undo()->setClean();
@@ -288,8 +288,8 @@ bool Score::saveFile()
       QString tempName = info.filePath() + QString(".temp");
       QFile temp(tempName);
       if (!temp.open(QIODevice::WriteOnly)) {
-            MScore::lastError = QT_TRANSLATE_NOOP("file", "Open Temp File\n")
-               + tempName + QT_TRANSLATE_NOOP("file", "\nfailed: ") + QString(strerror(errno));
+            MScore::setLastError(QT_TRANSLATE_NOOP("file", "Open Temp File\n")
+               + tempName + QT_TRANSLATE_NOOP("file", "\nfailed: ") + QString(strerror(errno)));
             return false;
             }
       try {
@@ -299,12 +299,12 @@ bool Score::saveFile()
                   saveCompressedFile(&temp, info, false);
             }
       catch (QString s) {
-            MScore::lastError = s;
+            MScore::setLastError(s);
             return false;
             }
       if (temp.error() != QFile::NoError) {
-            MScore::lastError = QT_TRANSLATE_NOOP("file",
-               "MuseScore: Save File failed: ") + temp.errorString();
+            MScore::setLastError(QT_TRANSLATE_NOOP("file",
+               "MuseScore: Save File failed: ") + temp.errorString());
             temp.close();
             return false;
             }
@@ -345,10 +345,10 @@ bool Score::saveFile()
       // rename temp name into file name
       //
       if (!QFile::rename(tempName, name)) {
-            MScore::lastError = QT_TRANSLATE_NOOP("file", "renaming temp. file <")
+            MScore::setLastError(QT_TRANSLATE_NOOP("file", "renaming temp. file <")
                + tempName + QT_TRANSLATE_NOOP("file", "> to <") + name
                + QT_TRANSLATE_NOOP("file", "> failed:\n")
-               + QString(strerror(errno));
+               + QString(strerror(errno)));
             return false;
             }
       // make file readable by all
@@ -384,67 +384,97 @@ void Score::saveCompressedFile(QFileInfo& info, bool onlySelection)
 
 void Score::saveCompressedFile(QIODevice* f, QFileInfo& info, bool onlySelection)
       {
-      QZipWriter uz(f);
+      msczContents(info, onlySelection).write(f);
+      }
+
+//---------------------------------------------------------
+//   msczContents
+//    serialize the score into memory; images and audio
+//    are implicitly shared, not copied
+//---------------------------------------------------------
 
-      QString fn = info.completeBaseName() + ".mscx";
+MsczContents Score::msczContents(QFileInfo& info, bool onlySelection)
+      {
+      MsczContents mc;
+      mc.rootName = info.completeBaseName() + ".mscx";
       QBuffer cbuf;
       cbuf.open(QIODevice::ReadWrite);
       Xml xml(&cbuf);
       xml << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
       xml.stag("container");
       xml.stag("rootfiles");
-      xml.stag(QString("rootfile full-path=\"%1\"").arg(Xml::xmlString(fn)));
+      xml.stag(QString("rootfile full-path=\"%1\"").arg(Xml::xmlString(mc.rootName)));
       xml.etag();
-      foreach(ImageStoreItem* ip, imageStore) {
-            if (!ip->isUsed(this))
-                  continue;
+      foreach(ImageStoreItem* ip, imageStore.usedItems(this)) {
             QString path = QString("Pictures/") + ip->hashName();
             xml.tag("file", path);
             }
 
       xml.etag();
       xml.etag();
-      cbuf.seek(0);
-      uz.addDirectory("META-INF");
-      uz.addFile("META-INF/container.xml", cbuf.data());
+      mc.container = cbuf.data();
 
-      // save images
-      uz.addDirectory("Pictures");
-      foreach(ImageStoreItem* ip, imageStore) {
-            if (!ip->isUsed(this))
-                  continue;
+      foreach(ImageStoreItem* ip, imageStore.usedItems(this)) {
             QString path = QString("Pictures/") + ip->hashName();
-            uz.addFile(path, ip->buffer());
+            mc.pictures.append(qMakePair(path, ip->buffer()));
             }
 #ifdef OMR
-      //
-      // save OMR page images
-      //
       if (_omr) {
             int n = _omr->numPages();
-            for (int i = 0; i < n; ++i) {
-                  QString path = QString("OmrPages/page%1.png").arg(i+1);
-                  QBuffer cbuf;
-                  OmrPage* page = _omr->page(i);
-                  const QImage& image = page->image();
-                  if (!image.save(&cbuf, "PNG"))
-                        throw(QString("save file: cannot save image (%1x%2)").arg(image.width()).arg(image.height()));
-                  uz.addFile(path, cbuf.data());
-                  cbuf.close();
-                  }
+            for (int i = 0; i < n; ++i)
+                  mc.omrPages.append(_omr->page(i)->image());
             }
 #endif
-      //
-      // save audio
-      //
       if (_audio)
-            uz.addFile("audio.ogg", _audio->data());
+            mc.audio = _audio->data();
 
       QBuffer dbuf;
       dbuf.open(QIODevice::ReadWrite);
       saveFile(&dbuf, true, onlySelection);
-      dbuf.seek(0);
-      uz.addFile(fn, dbuf.data());
+      mc.score = dbuf.data();
+      return mc;
+      }
+
+//---------------------------------------------------------
+//   write
+//    compressionLevel is the zlib level, 0 stores the
+//    entries uncompressed
+//    throws QString on error
+//---------------------------------------------------------
+
+void MsczContents::write(QIODevice* f, int compressionLevel) const
+      {
+      QZipWriter uz(f);
+      if (compressionLevel == 0)
+            uz.setCompressionPolicy(QZipWriter::NeverCompress);
+      else
+            uz.setCompressionLevel(compressionLevel);
+      uz.addDirectory("META-INF");
+      uz.addFile("META-INF/container.xml", container);
+
+      // save images
+      uz.addDirectory("Pictures");
+      for (const auto& p : pictures)
+            uz.addFile(p.first, p.second);
+      //
+      // save OMR page images
+      //
+      for (int i = 0; i < omrPages.size(); ++i) {
+            QString path = QString("OmrPages/page%1.png").arg(i+1);
+            QBuffer cbuf;
+            const QImage& image = omrPages[i];
+            if (!image.save(&cbuf, "PNG"))
+                  throw(QString("save file: cannot save image (%1x%2)").arg(image.width()).arg(image.height()));
+            uz.addFile(path, cbuf.data());
+            cbuf.close();
+            }
+      //
+      // save audio
+      //
+      if (!audio.isNull())
+            uz.addFile("audio.ogg", audio);
+
+      uz.addFile(rootName, score);
       uz.close();
       }
 
@@ -482,7 +512,7 @@ bool Score::loadStyle(const QString& fn)
                   return true;
                   }
             }
-      MScore::lastError = strerror(errno);
+      MScore::setLastError(strerror(errno));
       return false;
       }
 
@@ -499,9 +529,9 @@ bool Score::saveStyle(const QString& name)
             info.setFile(info.filePath() + ext);
       QFile f(info.filePath());
       if (!f.open(QIODevice::WriteOnly)) {
-            MScore::lastError = QT_TRANSLATE_NOOP("file", "Open Style File\n")
+            MScore::setLastError(QT_TRANSLATE_NOOP("file", "Open Style File\n")
                + f.fileName() + QT_TRANSLATE_NOOP("file", "\nfailed: ")
-               + QString(strerror(errno));
+               + QString(strerror(errno)));
             return false;
             }
 
@@ -511,8 +541,8 @@ bool Score::saveStyle(const QString& name)
       _style.save(xml, false);     // save complete style
       xml.etag();
       if (f.error() != QFile::NoError) {
-            MScore::lastError = QT_TRANSLATE_NOOP("file", "Write Style failed: ")
-               + f.errorString();
+            MScore::setLastError(QT_TRANSLATE_NOOP("file", "Write Style failed: ")
+               + f.errorString());
             return false;
             }
       return true;
@@ -560,7 +590,7 @@ Score::FileError Score::loadCompressedMsc(QString name, bool ignoreVersionError)
       QZipReader uz(name);
       if (!uz.exists()) {
             qDebug("loadCompressedMsc: <%s> not found\n", qPrintable(name));
-            MScore::lastError = QT_TRANSLATE_NOOP("file", "file not found");
+            MScore::setLastError(QT_TRANSLATE_NOOP("file", "file not found"));
             return FILE_NOT_FOUND;
             }
       QByteArray cbuf = uz.fileData("META-INF/container.xml");
@@ -643,7 +673,7 @@ Score::FileError Score::loadMsc(QString name, bool ignoreVersionError)
 
       QFile f(name);
       if (!f.open(QIODevice::ReadOnly)) {
-            MScore::lastError = f.errorString();
+            MScore::setLastError(f.errorString());
             return FILE_OPEN_ERROR;
             }
 
@@ -1071,14 +1101,33 @@ bool Score::read(XmlReader& e)
 
 void Score::print(QPainter* painter, int pageNo)
       {
-      _printing  = true;
-      Page* page = pages().at(pageNo);
-      QRectF fr  = page->abbox();
+      print(painter, pages().at(pageNo)->displayList());
+      }
+
+//---------------------------------------------------------
+//   printElements
+//    return the elements of page pageNo in paint order;
+//    touches only the page, so pages can be collected
+//    concurrently
+//---------------------------------------------------------
+
+QList<Element*> Score::printElements(int pageNo)
+      {
+      QList<Element*> ell;
+      foreach(const Element* e, pages().at(pageNo)->displayList())
+            ell.append(const_cast<Element*>(e));
+      return ell;
+      }
 
-      QList<Element*> ell = page->items(fr);
-      qStableSort(ell.begin(), ell.end(), elementLessThan);
-      foreach(const Element* e, ell) {
-            e->itemDiscovered = 0;
+//---------------------------------------------------------
+//   print
+//    paint the display list of a page
+//---------------------------------------------------------
+
+void Score::print(QPainter* painter, const QVector<const Element*>& dl)
+      {
+      _printing  = true;
+      foreach(const Element* e, dl) {
             if (!e->visible())
                   continue;
             painter->save();
@@ -983,7 +983,7 @@ bool StaffTypeTablature::readConfigFile(const QString& fileName)
 
       if (!fi.exists() || !f.open(QIODevice::ReadOnly)) {
             QString s = QT_TRANSLATE_NOOP("file", "cannot open tablature font description:\n%1\n%2");
-            MScore::lastError = s.arg(f.fileName()).arg(f.errorString());
+            MScore::setLastError(s.arg(f.fileName()).arg(f.errorString()));
 qDebug("StaffTypeTablature::readConfigFile failed: <%s>\n", qPrintable(path));
             return false;
             }
@@ -352,6 +352,95 @@ void Sym::genGlyphs(const QFont& font)
       }
 #endif
 
+#else
+//---------------------------------------------------------
+//   SymGlyphCache
+//    shaped glyph runs of all symbols drawn so far; raw
+//    fonts belong to the font engines of the thread which
+//    created them, so every thread has its own cache
+//---------------------------------------------------------
+
+struct SymGlyphCache {
+      QRawFont rawFonts[4];
+      QHash<int, QGlyphRun> runs;         // key: font id, code
+      };
+
+static QThreadStorage<SymGlyphCache*> symGlyphCache;
+
+//---------------------------------------------------------
+//   cachedGlyphRun
+//    return the glyph run of the symbol, shaped once per
+//    thread
+//---------------------------------------------------------
+
+const QGlyphRun* Sym::cachedGlyphRun() const
+      {
+      if (!symGlyphCache.hasLocalData())
+            symGlyphCache.setLocalData(new SymGlyphCache);
+      SymGlyphCache* cache = symGlyphCache.localData();
+      int key = (fontId << 24) | _code;
+      QHash<int, QGlyphRun>::const_iterator i = cache->runs.constFind(key);
+      if (i != cache->runs.constEnd())
+            return &i.value();
+
+      QRawFont& rfont = cache->rawFonts[fontId];
+      if (!rfont.isValid())
+            rfont = QRawFont::fromFont(fontId2font(fontId));
+      QVector<quint32> idx = rfont.glyphIndexesForString(toString());
+      QVector<QPointF> adv = rfont.advancesForGlyphIndexes(idx);
+      QVector<QPointF> pos(idx.size());
+      for (int k = 1; k < idx.size(); ++k)
+            pos[k] = pos[k-1] + adv[k-1];
+      QGlyphRun run;
+      run.setRawFont(rfont);
+      run.setGlyphIndexes(idx);
+      run.setPositions(pos);
+      return &cache->runs.insert(key, run).value();
+      }
+
+//---------------------------------------------------------
+//   glyphRun
+//    return the cached glyph run of the symbol if it can
+//    be used for painter, 0 otherwise; vector and printer
+//    devices get real text
+//---------------------------------------------------------
+
+const QGlyphRun* Sym::glyphRun(QPainter* painter) const
+      {
+      if (!MScore::symbolGlyphCache || painter->paintEngine()->type() != QPaintEngine::Raster)
+            return 0;
+      return cachedGlyphRun();
+      }
+
+//---------------------------------------------------------
+//   glyphRun
+//    return the glyph run of n repeated symbols; the
+//    symbols are spaced by the advance of the glyphs as
+//    in drawText(), not by the bounding box width
+//---------------------------------------------------------
+
+QGlyphRun Sym::glyphRun(int n) const
+      {
+      const QGlyphRun* run = cachedGlyphRun();
+      QVector<quint32> idx = run->glyphIndexes();
+      QVector<QPointF> pos = run->positions();
+      QGlyphRun nglyphs(*run);
+      if (idx.isEmpty())
+            return nglyphs;
+      QPointF advance = pos.last() + run->rawFont().advancesForGlyphIndexes(idx.mid(idx.size() - 1))[0];
+      QVector<quint32> indexes;
+      QVector<QPointF> positions;
+      for (int i = 0; i < n; ++i) {
+            indexes += idx;
+            for (int k = 0; k < pos.size(); ++k)
+                  positions.append(pos[k] + advance * i);
+            }
+      nglyphs.setGlyphIndexes(indexes);
+      nglyphs.setPositions(positions);
+      return nglyphs;
+      }
+#endif
+
 //---------------------------------------------------------
 //   Sym
 //---------------------------------------------------------
@@ -404,8 +493,13 @@ void Sym::draw(QPainter* painter, qreal mag, const QPointF& pos) const
 #ifdef USE_GLYPHS
       painter->drawGlyphRun(pos * imag, glyphs);
 #else
-      painter->setFont(font());
-      painter->drawText(pos * imag, toString());
+      const QGlyphRun* run = glyphRun(painter);
+      if (run)
+            painter->drawGlyphRun(pos * imag, *run);
+      else {
+            painter->setFont(font());
+            painter->drawText(pos * imag, toString());
+            }
 #endif
       painter->scale(imag, imag);
       }
@@ -421,8 +515,13 @@ void Sym::draw(QPainter* painter, qreal mag) const
 #ifdef USE_GLYPHS
       painter->drawGlyphRun(QPointF(), glyphs);
 #else
-      painter->setFont(font());
-      painter->drawText(QPointF(), toString());
+      const QGlyphRun* run = glyphRun(painter);
+      if (run)
+            painter->drawGlyphRun(QPointF(), *run);
+      else {
+            painter->setFont(font());
+            painter->drawText(QPointF(), toString());
+            }
 #endif
       painter->scale(imag, imag);
       }
@@ -469,8 +568,12 @@ void Sym::draw(QPainter* painter, qreal mag, const QPointF& pos, int n) const
 #ifdef USE_GLYPHS
       painter->drawGlyphRun(pos * imag, nglyphs);
 #else
-      painter->setFont(font());
-      painter->drawText(pos * imag, QString(n, _code));
+      if (glyphRun(painter))
+            painter->drawGlyphRun(pos * imag, glyphRun(n));  // one run for the whole repetition
+      else {
+            painter->setFont(font());
+            painter->drawText(pos * imag, QString(n, _code));
+            }
 #endif
       painter->scale(imag, imag);
       }
@@ -314,6 +314,9 @@ class Sym {
 #ifdef USE_GLYPHS
       QGlyphRun glyphs;       // cached values
       void genGlyphs(const QFont& font);
+#else
+      const QGlyphRun* cachedGlyphRun() const;
+      const QGlyphRun* glyphRun(QPainter*) const;
 #endif
 
       static QVector<const char*> symNames;
@@ -341,6 +344,9 @@ class Sym {
       QRectF getBbox() const               { return _bbox; }
       QPointF getAttach() const            { return _attach; }
       QString toString() const;
+#ifndef USE_GLYPHS
+      QGlyphRun glyphRun(int n) const;
+#endif
 
       static SymId name2id(const QString& s) { return lnhash.value(s, noSym); }     // return noSym if not found
       static const char* id2name(SymId id)   { return symNames[id];     }
@@ -18,7 +18,84 @@
 
 namespace Ms {
 
-QString docName;
+//---------------------------------------------------------
+//   XmlTagTable
+//    open addressing hash table built once from the
+//    XML_TAGS list; a lookup costs one hash over the
+//    name and usually a single compare
+//---------------------------------------------------------
+
+class XmlTagTable {
+      static const int SIZE = 512;        // power of two, well above 2 * number of tags
+
+      struct Entry {
+            const char* name;
+            int len;
+            XmlTag tag;
+            };
+      Entry table[SIZE];
+
+      static unsigned hash(const QChar* s, int n) {
+            unsigned h = 2166136261u;
+            for (int i = 0; i < n; ++i)
+                  h = (h ^ s[i].unicode()) * 16777619u;
+            return h;
+            }
+      void insert(const char* name, XmlTag tag);
+
+   public:
+      XmlTagTable();
+      XmlTag lookup(const QStringRef&) const;
+      };
+
+XmlTagTable::XmlTagTable()
+      {
+      for (int i = 0; i < SIZE; ++i)
+            table[i].name = 0;
+#define XML_TAG_INSERT(a)      insert(#a, XmlTag::a);
+#define XML_TAG_INSERT_N(a, b) insert(b, XmlTag::a##_);
+      XML_TAGS(XML_TAG_INSERT, XML_TAG_INSERT_N)
+#undef XML_TAG_INSERT
+#undef XML_TAG_INSERT_N
+      }
+
+void XmlTagTable::insert(const char* name, XmlTag tag)
+      {
+      QString s(name);
+      unsigned idx = hash(s.unicode(), s.size()) & (SIZE - 1);
+      while (table[idx].name)
+            idx = (idx + 1) & (SIZE - 1);
+      table[idx].name = name;
+      table[idx].len  = s.size();
+      table[idx].tag  = tag;
+      }
+
+XmlTag XmlTagTable::lookup(const QStringRef& s) const
+      {
+      const QChar* p = s.unicode();
+      const int n    = s.size();
+      for (unsigned idx = hash(p, n) & (SIZE - 1); table[idx].name; idx = (idx + 1) & (SIZE - 1)) {
+            const Entry& e = table[idx];
+            if (e.len != n)
+                  continue;
+            int i = 0;
+            while (i < n && p[i].unicode() == (unsigned char)e.name[i])
+                  ++i;
+            if (i == n)
+                  return e.tag;
+            }
+      return XmlTag::UNKNOWN;
+      }
+
+//---------------------------------------------------------
+//   xmlTag
+//---------------------------------------------------------
+
+XmlTag xmlTag(const QStringRef& name)
+      {
+      static const XmlTagTable table;
+      return table.lookup(name);
+      }
 
 //---------------------------------------------------------
 //   XmlReader
@@ -30,6 +107,7 @@ XmlReader::XmlReader(QFile* d)
       docName = d->fileName();
       _tick  = 0;
       _track = 0;
+      _token = XmlTag::UNKNOWN;
       }
 
 XmlReader::XmlReader(const QByteArray& d)
@@ -37,6 +115,7 @@ XmlReader::XmlReader(const QByteArray& d)
       {
       _tick  = 0;
       _track = 0;
+      _token = XmlTag::UNKNOWN;
       }
 
 XmlReader::XmlReader(QIODevice* d)
@@ -44,6 +123,7 @@ XmlReader::XmlReader(QIODevice* d)
       {
       _tick  = 0;
       _track = 0;
+      _token = XmlTag::UNKNOWN;
       }
 
 XmlReader::XmlReader(const QString& d)
@@ -51,6 +131,7 @@ XmlReader::XmlReader(const QString& d)
       {
       _tick  = 0;
       _track = 0;
+      _token = XmlTag::UNKNOWN;
       }
 
 //---------------------------------------------------------
@@ -212,18 +293,71 @@ void XmlReader::unknown() const
       abort();
       }
 
+//---------------------------------------------------------
+//   addSpanner
+//    the spanner id must be known at this point
+//---------------------------------------------------------
+
+void XmlReader::addSpanner(Spanner* s)
+      {
+      if (!_spannerIndex.contains(s->id()))
+            _spannerIndex.insert(s->id(), _spanner.size());
+      _spanner.append(s);
+      }
+
+//---------------------------------------------------------
+//   removeSpanner
+//---------------------------------------------------------
+
+void XmlReader::removeSpanner(Spanner* s)
+      {
+      int idx = _spannerIndex.value(s->id(), -1);
+      if (idx != -1 && _spanner[idx] == s) {
+            _spanner[idx] = 0;
+            _spannerIndex.remove(s->id());
+            return;
+            }
+      // spanner with duplicate id
+      idx = _spanner.indexOf(s);
+      if (idx != -1)
+            _spanner[idx] = 0;
+      }
+
+//---------------------------------------------------------
+//   spanner
+//    return all spanners which are not removed
+//---------------------------------------------------------
+
+QList<Spanner*> XmlReader::spanner() const
+      {
+      QList<Spanner*> sl;
+      sl.reserve(_spanner.size());
+      for (Spanner* s : _spanner) {
+            if (s)
+                  sl.append(s);
+            }
+      return sl;
+      }
+
 //---------------------------------------------------------
 //   findSpanner
 //---------------------------------------------------------
 
 Spanner* XmlReader::findSpanner(int id) const
       {
-      int n = _spanner.size();
-      for (int i = 0; i < n; ++i) {
-            if (_spanner.at(i)->id() == id)
-                  return _spanner.at(i);
-            }
-      return 0;
+      int idx = _spannerIndex.value(id, -1);
+      return idx == -1 ? 0 : _spanner.at(idx);
+      }
+
+//---------------------------------------------------------
+//   addBeam
+//---------------------------------------------------------
+
+void XmlReader::addBeam(Beam* s)
+      {
+      if (!_beamIndex.contains(s->id()))
+            _beamIndex.insert(s->id(), s);
+      _beams.append(s);
       }
 
 //---------------------------------------------------------
@@ -232,12 +366,7 @@ Spanner* XmlReader::findSpanner(int id) const
 
 Beam* XmlReader::findBeam(int id) const
       {
-      int n = _beams.size();
-      for (int i = 0; i < n; ++i) {
-            if (_beams.at(i)->id() == id)
-                  return _beams.at(i);
-            }
-      return 0;
+      return _beamIndex.value(id, 0);
       }
 
 //---------------------------------------------------------
@@ -246,12 +375,7 @@ Beam* XmlReader::findBeam(int id) const
 
 Tuplet* XmlReader::findTuplet(int id) const
       {
-      int n = _tuplets.size();
-      for (int i = 0; i < n; ++i) {
-            if (_tuplets.at(i)->id() == id)
-                  return _tuplets.at(i);
-            }
-      return 0;
+      return _tupletIndex.value(id, 0);
       }
 
 //---------------------------------------------------------
@@ -267,6 +391,17 @@ void XmlReader::addTuplet(Tuplet* s)
             return;
             }
       _tuplets.append(s);
+      _tupletIndex.insert(s->id(), s);
+      }
+
+//---------------------------------------------------------
+//   clearTuplets
+//---------------------------------------------------------
+
+void XmlReader::clearTuplets()
+      {
+      _tuplets.clear();
+      _tupletIndex.clear();
       }
 
 //---------------------------------------------------------
@@ -25,6 +25,47 @@ class Beam;
 class Tuplet;
 class ClefList;
 
+//---------------------------------------------------------
+//   XmlTag
+//    tokens for the tag names which are dispatched in the
+//    hot read() functions (Measure, Chord, Note, ...);
+//    XmlReader::readNextStartElement() sets the token of
+//    the current element, unknown names map to UNKNOWN
+//---------------------------------------------------------
+
+#define XML_TAGS(X, XN) \
+      X(color) X(visible) X(selected) X(userOff) X(lid) X(tick) \
+      X(offset) X(pos) X(voice) X(track) X(tag) X(placement) \
+      X(Tuplet) X(BeamMode) X(Attribute) X(Articulation) X(leadingSpace) X(trailingSpace) \
+      X(Beam) X(Slur) X(durationType) X(duration) X(ticklen) X(dots) \
+      X(move) X(Lyrics) X(Note) X(appoggiatura) X(acciaccatura) X(grace4) \
+      X(grace16) X(grace32) X(StemDirection) X(noStem) X(Arpeggio) X(Glissando) \
+      X(Tremolo) X(tickOffset) X(Stem) X(Hook) X(ChordLine) X(pitch) \
+      X(tpc) X(mirror) X(dotPosition) X(onTimeOffset) X(offTimeOffset) X(head) \
+      X(velocity) X(tuning) X(fret) X(string) X(ghost) X(headType) \
+      X(veloType) X(line) X(Tie) X(Fingering) X(Text) X(Symbol) \
+      X(Image) X(userAccidental) X(Accidental) X(Bend) X(NoteDot) X(Events) \
+      X(Event) X(endSpanner) X(TextLine) X(onTimeType) X(offTimeType) X(BarLine) \
+      X(Breath) X(Chord) X(Clef) X(Dynamic) X(FiguredBass) X(FretDiagram) \
+      X(HairPin) X(Harmony) X(InstrumentChange) X(Jump) X(KeySig) X(LayoutBreak) \
+      X(MeasureNumber) X(Ottava) X(Pedal) X(RehearsalMark) X(RepeatMeasure) X(Rest) \
+      X(Segment) X(StaffState) X(StaffText) X(Tempo) X(TimeSig) X(Trill) \
+      X(Volta) X(breakMultiMeasureRest) X(endRepeat) X(irregular) X(noOffset) X(slashStyle) \
+      X(startRepeat) X(stretch) X(vspacer) X(vspacerDown) X(vspacerUp) X(Marker) \
+      XN(small, "small")
+
+enum class XmlTag : unsigned short {
+      UNKNOWN,
+#define XML_TAG_ENUM(a)      a,
+#define XML_TAG_ENUM_N(a, b) a##_,
+      XML_TAGS(XML_TAG_ENUM, XML_TAG_ENUM_N)
+#undef XML_TAG_ENUM
+#undef XML_TAG_ENUM_N
+      TAGS
+      };
+
+extern XmlTag xmlTag(const QStringRef&);
+
 //---------------------------------------------------------
 //   XmlReader
 //---------------------------------------------------------
@@ -35,9 +76,13 @@ class XmlReader : public QXmlStreamReader {
       // Score read context (for read optimizations):
       int _tick;
       int _track;
-      QList<Spanner*> _spanner;
+      XmlTag _token;
+      QList<Spanner*> _spanner;            // in read order; removed entries are set to 0
+      QHash<int, int> _spannerIndex;       // spanner id -> index into _spanner
       QList<Beam*>    _beams;
+      QHash<int, Beam*> _beamIndex;
       QList<Tuplet*>  _tuplets;
+      QHash<int, Tuplet*> _tupletIndex;
       QList<ClefList*> _clefListList;      // used reading 1.2 scores
 
    public:
@@ -48,6 +93,16 @@ class XmlReader : public QXmlStreamReader {
 
       void unknown() const;
 
+      bool readNextStartElement() {
+            if (QXmlStreamReader::readNextStartElement()) {
+                  _token = xmlTag(name());
+                  return true;
+                  }
+            _token = XmlTag::UNKNOWN;
+            return false;
+            }
+      XmlTag token() const { return _token; }
+
       void error(int, int);
 
       // attribute helper routines:
@@ -75,19 +130,20 @@ class XmlReader : public QXmlStreamReader {
       void setTick(int val)       { _tick = val; }
       int track() const           { return _track; }
       void setTrack(int val)      { _track = val; }
-      void addSpanner(Spanner* s) { _spanner.append(s); }
+      void addSpanner(Spanner* s);
       void addTuplet(Tuplet* s);
-      void addBeam(Beam* s)       { _beams.append(s); }
-      void removeSpanner(Spanner* s) { _spanner.removeOne(s); }
+      void addBeam(Beam* s);
+      void removeSpanner(Spanner* s);
+      void clearTuplets();
 
       Spanner* findSpanner(int) const;
       Beam* findBeam(int) const;
       Tuplet* findTuplet(int) const;
 
-      QList<Spanner*>& spanner()       { return _spanner; }
-      QList<Tuplet*>& tuplets()        { return _tuplets; }
-      QList<Beam*>& beams()            { return _beams; }
-      QList<ClefList*>& clefListList() { return _clefListList; }
+      QList<Spanner*> spanner() const;
+      const QList<Tuplet*>& tuplets() const { return _tuplets; }
+      const QList<Beam*>& beams() const     { return _beams; }
+      QList<ClefList*>& clefListList()      { return _clefListList; }
       };
 
 //---------------------------------------------------------
@@ -128,6 +184,7 @@ class Xml : public QTextStream {
 
       void stag(const QString&);
       void etag();
+      void pushTag(const QString& s) { stack.append(s); }   // nest without writing the start tag
 
       void tagE(const QString&);
       void tagE(const char* format, ...);
@@ -151,7 +208,6 @@ class Xml : public QTextStream {
       };
 
 extern PlaceText readPlacement(XmlReader&);
-extern QString docName;
 
 }     // namespace Ms
 #endif
@@ -0,0 +1,237 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2013 Werner Schweer and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+//---------------------------------------------------------
+//    batch conversion
+//
+//    mscore -j jobfile
+//
+//    the job file lists one conversion per line:
+//
+//          input;output[;style]
+//
+//    empty lines and lines starting with '#' are ignored,
+//    relative paths are relative to the job file.
+//    Every job gets its own Score; jobs are loaded, laid
+//    out and exported in parallel on the global thread pool
+//    and a status line is written to stdout as soon as a
+//    job is finished.
+//---------------------------------------------------------
+
+#include "musescore.h"
+#include "libmscore/score.h"
+#include "libmscore/style.h"
+#include "libmscore/mscore.h"
+
+namespace Ms {
+
+extern Score::FileError readScore(Score* score, QString name, bool ignoreVersionError);
+
+//---------------------------------------------------------
+//   BatchJob
+//---------------------------------------------------------
+
+struct BatchJob {
+      QString input;
+      QString output;
+      QString style;
+      bool ok;
+      QString error;
+      qint64 loadTime;        // ms
+      qint64 exportTime;      // ms
+      };
+
+static QMutex reportMutex;
+static QMutex serialExportMutex;
+static int jobsDone;
+static int jobsTotal;
+
+//---------------------------------------------------------
+//   fileErrorText
+//---------------------------------------------------------
+
+static QString fileErrorText(Score::FileError error)
+      {
+      switch (error) {
+            case Score::FILE_NO_ERROR:     return "no error";
+            case Score::FILE_NOT_FOUND:    return "file not found";
+            case Score::FILE_OPEN_ERROR:   return "cannot open file";
+            case Score::FILE_BAD_FORMAT:   return "bad format";
+            case Score::FILE_UNKNOWN_TYPE: return "unknown type";
+            case Score::FILE_NO_ROOTFILE:  return "no root file";
+            case Score::FILE_TOO_OLD:      return "file too old";
+            case Score::FILE_TOO_NEW:      return "file too new";
+            case Score::FILE_USER_ABORT:   return "aborted";
+            default:                       return "read error";
+            }
+      }
+
+//---------------------------------------------------------
+//   readJobFile
+//---------------------------------------------------------
+
+static bool readJobFile(const QString& path, const QString& defaultStyle, QList<BatchJob>* jobs)
+      {
+      QFile f(path);
+      if (!f.open(QIODevice::ReadOnly)) {
+            qDebug("batchConvert: cannot open job file <%s>", qPrintable(path));
+            return false;
+            }
+      QDir dir = QFileInfo(path).absoluteDir();
+      QTextStream s(&f);
+      s.setCodec("UTF-8");
+      int lineNumber = 0;
+      while (!s.atEnd()) {
+            QString line = s.readLine().trimmed();
+            ++lineNumber;
+            if (line.isEmpty() || line.startsWith('#'))
+                  continue;
+            QStringList fields = line.split(';');
+            if (fields.size() < 2 || fields.size() > 3) {
+                  qDebug("batchConvert: %s:%d: expected input;output[;style]",
+                     qPrintable(path), lineNumber);
+                  return false;
+                  }
+            BatchJob job;
+            job.input      = dir.absoluteFilePath(fields[0].trimmed());
+            job.output     = dir.absoluteFilePath(fields[1].trimmed());
+            if (fields.size() == 3 && !fields[2].trimmed().isEmpty())
+                  job.style = dir.absoluteFilePath(fields[2].trimmed());
+            else
+                  job.style = defaultStyle;
+            job.ok         = false;
+            job.loadTime   = 0;
+            job.exportTime = 0;
+            jobs->append(job);
+            }
+      return true;
+      }
+
+//---------------------------------------------------------
+//   needsSerialExport
+//    audio export drives its own synthesizer instance and
+//    may report through message boxes; keep it to one
+//    job at a time
+//---------------------------------------------------------
+
+static bool needsSerialExport(const QString& fn)
+      {
+      return fn.endsWith(".wav") || fn.endsWith(".ogg") || fn.endsWith(".flac")
+         || fn.endsWith(".mp3");
+      }
+
+//---------------------------------------------------------
+//   reportJob
+//---------------------------------------------------------
+
+static void reportJob(const BatchJob& job)
+      {
+      QMutexLocker locker(&reportMutex);
+      ++jobsDone;
+      QTextStream out(stdout);
+      out << "[" << jobsDone << "/" << jobsTotal << "] "
+          << (job.ok ? "OK   " : "FAIL ")
+          << job.input << " -> " << job.output
+          << " (load " << job.loadTime << " ms, export " << job.exportTime << " ms)";
+      if (!job.ok)
+            out << ": " << job.error;
+      out << "\n";
+      out.flush();
+      }
+
+//---------------------------------------------------------
+//   runJob
+//---------------------------------------------------------
+
+static void runJob(BatchJob& job)
+      {
+      QElapsedTimer timer;
+      timer.start();
+      Score* score = new Score(MScore::defaultStyle());
+      Score::FileError rv = readScore(score, job.input, false);
+      if (rv != Score::FILE_NO_ERROR) {
+            job.error    = fileErrorText(rv);
+            job.loadTime = timer.elapsed();
+            delete score;
+            reportJob(job);
+            return;
+            }
+      if (!job.style.isEmpty()) {
+            QFile f(job.style);
+            if (f.open(QIODevice::ReadOnly)) {
+                  score->style()->load(&f);
+                  score->doLayout();
+                  }
+            else {
+                  job.error    = QString("cannot open style file %1").arg(job.style);
+                  job.loadTime = timer.elapsed();
+                  delete score;
+                  reportJob(job);
+                  return;
+                  }
+            }
+      job.loadTime = timer.restart();
+
+      if (needsSerialExport(job.output)) {
+            QMutexLocker locker(&serialExportMutex);
+            job.ok = mscore->convertFile(score, job.output);
+            }
+      else
+            job.ok = mscore->convertFile(score, job.output);
+      if (!job.ok)
+            job.error = "export failed";
+      job.exportTime = timer.elapsed();
+      delete score;
+      reportJob(job);
+      }
+
+//---------------------------------------------------------
+//   batchConvert
+//    return true if all jobs succeeded
+//---------------------------------------------------------
+
+bool batchConvert(const QString& jobFile, const QString& defaultStyle)
+      {
+      QList<BatchJob> jobs;
+      if (!readJobFile(jobFile, defaultStyle, &jobs))
+            return false;
+      jobsDone  = 0;
+      jobsTotal = jobs.size();
+
+      QElapsedTimer timer;
+      timer.start();
+      int threads = 1;
+      if (QFontDatabase::supportsThreadedFontRendering()) {
+            threads = QThreadPool::globalInstance()->maxThreadCount();
+            QtConcurrent::map(jobs, runJob).waitForFinished();
+            }
+      else {
+            // text layout needs fonts, which cannot be used
+            // outside the gui thread on this platform
+            for (BatchJob& job : jobs)
+                  runJob(job);
+            }
+
+      int failed = 0;
+      for (const BatchJob& job : jobs) {
+            if (!job.ok)
+                  ++failed;
+            }
+      QTextStream out(stdout);
+      out << jobs.size() - failed << " of " << jobs.size() << " jobs converted in "
+          << timer.elapsed() / 1000.0 << " s using " << threads << " threads\n";
+      out.flush();
+      return failed == 0;
+      }
+
+}
+
@@ -1094,7 +1094,7 @@ Score::FileError importCapXml(Score* score, const QString& name)
       QZipReader uz(name);
       if (!uz.exists()) {
             qDebug("importCapXml: <%s> not found", qPrintable(name));
-            MScore::lastError = QT_TRANSLATE_NOOP("file", "file not found");
+            MScore::setLastError(QT_TRANSLATE_NOOP("file", "file not found"));
             return Score::FILE_NOT_FOUND;
             }
 
@@ -250,6 +250,7 @@ public:
 //---------------------------------------------------------
 
 typedef QHash<const Chord*, const Trill*> TrillHash;
+typedef QList<int> IntVector;
 
 class ExportMusicXml {
       Score* score;
@@ -264,6 +265,8 @@ class ExportMusicXml {
       int tenths;
       TrillHash trillStart;
       TrillHash trillStop;
+      IntVector integers;           // used by calcDivisions()
+      IntVector primes;
 
       int findBracket(const TextLine* tl) const;
       void chord(Chord* chord, int staff, const QList<Lyrics*>* ll, bool useDrumset);
@@ -277,11 +280,16 @@ class ExportMusicXml {
       void unpitch2xml(Note* note, char& c, int& octave);
       void lyrics(const QList<Lyrics*>* ll, const int trk);
       void work(const MeasureBase* measure);
+      bool canDivideBy(int d) const;
+      void divideBy(int d);
+      void addInteger(int len);
       void calcDivMoveToTick(int t);
       void calcDivisions();
       double getTenthsFromInches(double);
       double getTenthsFromDots(double);
       void keysigTimesig(Measure* m, int strack, int etrack);
+      void part(Part* part, int idx, int staffCount);
+      QByteArray writePart(int idx, int staffCount, TextLine const** brackets) const;
 
 public:
       ExportMusicXml(Score* s)
@@ -739,13 +747,9 @@ static void findTrills(Measure* measure, int strack, int etrack, TrillHash& tril
 // helpers for ::calcDivisions
 //---------------------------------------------------------
 
-typedef QList<int> IntVector;
-static IntVector integers;
-static IntVector primes;
-
 // check if all integers can be divided by d
 
-static bool canDivideBy(int d)
+bool ExportMusicXml::canDivideBy(int d) const
       {
       bool res = true;
       for (int i = 0; i < integers.count(); i++) {
@@ -758,14 +762,14 @@ static bool canDivideBy(int d)
 
 // divide all integers by d
 
-static void divideBy(int d)
+void ExportMusicXml::divideBy(int d)
       {
       for (int i = 0; i < integers.count(); i++) {
             integers[i] /= d;
             }
       }
 
-static void addInteger(int len)
+void ExportMusicXml::addInteger(int len)
       {
       if (!integers.contains(len)) {
             integers.append(len);
@@ -3833,6 +3837,463 @@ void ExportMusicXml::keysigTimesig(Measure* m, int strack, int etrack)
             timesig(tsig);
       }
 
+//---------------------------------------------------------
+//   part
+//    write the part element for part number idx,
+//    staffCount is the number of staves in the parts before it
+//---------------------------------------------------------
+
+void ExportMusicXml::part(Part* part, int idx, int staffCount)
+      {
+      tick = 0;
+      xml.stag(QString("part id=\"P%1\"").arg(idx+1));
+
+      int staves = part->nstaves();
+      int strack = score->staffIdx(part) * VOICES;
+      int etrack = strack + staves * VOICES;
+
+      trillStart.clear();
+      trillStop.clear();
+
+      int measureNo = 1;          // number of next regular measure
+      int irregularMeasureNo = 1; // number of next irregular measure
+      int pickupMeasureNo = 1;    // number of next pickup measure
+
+      FigBassMap fbMap;           // pending figure base extends
+
+      for (MeasureBase* mb = score->measures()->first(); mb; mb = mb->next()) {
+            if (mb->type() != Element::MEASURE)
+                  continue;
+            Measure* m = static_cast<Measure*>(mb);
+            const PageFormat* pf = score->pageFormat();
+
+
+            // pickup and other irregular measures need special care
+            QString measureTag = "measure number=";
+            if ((irregularMeasureNo + measureNo) == 2 && m->irregular()) {
+                  measureTag += "\"0\" implicit=\"yes\"";
+                  pickupMeasureNo++;
+                  }
+            else if (m->irregular())
+                  measureTag += QString("\"X%1\" implicit=\"yes\"").arg(irregularMeasureNo++);
+            else
+                  measureTag += QString("\"%1\"").arg(measureNo++);
+            if (preferences.musicxmlExportLayout)
+                  measureTag += QString(" width=\"%1\"").arg(QString::number(m->bbox().width() / MScore::DPMM / millimeters * tenths,'f',2));
+            xml.stag(measureTag);
+
+            // Handle the <print> element.
+            // When exporting layout and all breaks, a <print> with layout informations
+            // is generated for the measure types TopSystem, NewSystem and newPage.
+            // When exporting layout but only manual or no breaks, a <print> with
+            // layout informations is generated only for the measure type TopSystem,
+            // as it is assumed the system layout is broken by the importing application
+            // anyway and is thus useless.
+
+            int currentSystem = NoSystem;
+            Measure* previousMeasure = 0;
+
+            for (MeasureBase* currentMeasureB = m->prev(); currentMeasureB; currentMeasureB = currentMeasureB->prev()) {
+                  if (currentMeasureB->type() == Element::MEASURE) {
+                        previousMeasure = (Measure*) currentMeasureB;
+                        break;
+                        }
+                  }
+
+            if (!previousMeasure)
+                  currentSystem = TopSystem;
+            else if (m->parent()->parent() != previousMeasure->parent()->parent())
+                  currentSystem = NewPage;
+            else if (m->parent() != previousMeasure->parent())
+                  currentSystem = NewSystem;
+
+            bool prevMeasLineBreak = false;
+            bool prevMeasPageBreak = false;
+            if (previousMeasure) {
+                  prevMeasLineBreak = previousMeasure->lineBreak();
+                  prevMeasPageBreak = previousMeasure->pageBreak();
+                  }
+
+            if (currentSystem != NoSystem) {
+
+                  // determine if a new-system or new-page is required
+                  QString newThing; // new-[system|page]="yes" or empty
+                  if (preferences.musicxmlExportBreaks == ALL_BREAKS) {
+                        if (currentSystem == NewSystem)
+                              newThing = " new-system=\"yes\"";
+                        else if (currentSystem == NewPage)
+                              newThing = " new-page=\"yes\"";
+                        }
+                  else if (preferences.musicxmlExportBreaks == MANUAL_BREAKS) {
+                        if (currentSystem == NewSystem && prevMeasLineBreak)
+                              newThing = " new-system=\"yes\"";
+                        else if (currentSystem == NewPage && prevMeasPageBreak)
+                              newThing = " new-page=\"yes\"";
+                        }
+
+                  // determine if layout information is required
+                  bool doLayout = false;
+                  if (preferences.musicxmlExportLayout) {
+                        if (currentSystem == TopSystem
+                            || (preferences.musicxmlExportBreaks == ALL_BREAKS && newThing != "")) {
+                              doLayout = true;
+                              }
+                        }
+
+                  if (doLayout) {
+                        xml.stag(QString("print%1").arg(newThing));
+                        const double pageWidth  = getTenthsFromInches(pf->size().width());
+                        const double lm = getTenthsFromInches(pf->oddLeftMargin());
+                        const double rm = getTenthsFromInches(pf->oddRightMargin());
+                        const double tm = getTenthsFromInches(pf->oddTopMargin());
+
+                        // System Layout
+                        // Put the system print suggestions only for the first part in a score...
+                        if (idx == 0) {
+                              // Find the right margin of the system.
+                              double systemLM = getTenthsFromDots(m->pagePos().x() - m->system()->page()->pagePos().x()) - lm;
+                              double systemRM = pageWidth - rm - (getTenthsFromDots(m->system()->bbox().width()) + lm);
+
+                              xml.stag("system-layout");
+                              xml.stag("system-margins");
+                              xml.tag("left-margin", QString("%1").arg(QString::number(systemLM,'f',2)));
+                              xml.tag("right-margin", QString("%1").arg(QString::number(systemRM,'f',2)) );
+                              xml.etag();
+
+                              if (currentSystem == NewPage || currentSystem == TopSystem)
+                                    xml.tag("top-system-distance", QString("%1").arg(QString::number(getTenthsFromDots(m->pagePos().y()) - tm,'f',2)) );
+                              if (currentSystem == NewSystem)
+                                    xml.tag("system-distance", QString("%1").arg(QString::number(getTenthsFromDots(m->pagePos().y() - previousMeasure->pagePos().y() - previousMeasure->bbox().height()),'f',2)));
+
+                              xml.etag();
+                              }
+
+                        // Staff layout elements.
+                        for (int staffIdx = (staffCount == 0) ? 1 : 0; staffIdx < staves; staffIdx++) {
+                              xml.stag(QString("staff-layout number=\"%1\"").arg(staffIdx + 1));
+                              xml.tag("staff-distance", QString("%1").arg(QString::number(getTenthsFromDots(mb->system()->staff(staffCount + staffIdx - 1)->distanceDown()),'f',2)));
+                              xml.etag();
+                              }
+
+                        xml.etag();
+                        }
+                  else {
+                        // !doLayout
+                        if (newThing != "")
+                              xml.tagE(QString("print%1").arg(newThing));
+                        }
+
+                  } // if (currentSystem ...
+
+            attr.start();
+
+            findTrills(m, strack, etrack, trillStart, trillStop);
+
+            // barline left must be the first element in a measure
+            barlineLeft(m);
+
+            // output attributes with the first actual measure (pickup or regular)
+            if ((irregularMeasureNo + measureNo + pickupMeasureNo) == 4) {
+                  attr.doAttr(xml, true);
+                  xml.tag("divisions", MScore::division / div);
+                  }
+            // output attributes at start of measure: key, time
+            keysigTimesig(m, strack, etrack);
+            // output attributes with the first actual measure (pickup or regular) only
+            if ((irregularMeasureNo + measureNo + pickupMeasureNo) == 4) {
+                  if (staves > 1)
+                        xml.tag("staves", staves);
+                  }
+            // output attribute at start of measure: clef
+            for (Segment* seg = m->first(); seg; seg = seg->next()) {
+
+                  if (seg->tick() > m->tick())
+                        break;
+                  Element* el = seg->element(strack);
+                  if (!el)
+                        continue;
+                  if (el->type() == Element::CLEF)
+                        for (int st = strack; st < etrack; st += VOICES) {
+                              // sstaff - xml staff number, counting from 1 for this
+                              // instrument
+                              // special number 0 -> dont show staff number in
+                              // xml output (because there is only one staff)
+
+                              int sstaff = (staves > 1) ? st - strack + VOICES : 0;
+                              sstaff /= VOICES;
+
+                              el = seg->element(st);
+                              if (el && el->type() == Element::CLEF) {
+                                    Clef* cle = static_cast<Clef*>(el);
+                                    int ct = cle->clefType();
+                                    int ti = cle->segment()->tick();
+#ifdef DEBUG_CLEF
+                                    qDebug("exportxml: clef at start measure ti=%d ct=%d gen=%d", ti, ct, el->generated());
+#endif
+                                    // output only clef changes, not generated clefs at line beginning
+                                    // exception: at tick=0, export clef anyway
+                                    if (ti == 0 || !cle->generated()) {
+#ifdef DEBUG_CLEF
+                                          qDebug("exportxml: clef exported");
+#endif
+                                          clef(sstaff, ct);
+                                          }
+                                    else {
+#ifdef DEBUG_CLEF
+                                          qDebug("exportxml: clef not exported");
+#endif
+                                          }
+                                    }
+                              }
+                  }
+
+            // output attributes with the first actual measure (pickup or regular) only
+            if ((irregularMeasureNo + measureNo + pickupMeasureNo) == 4) {
+                  const Instrument* instrument = part->instr();
+
+                  // staff details
+                  // TODO: decide how to handle linked regular / TAB staff
+                  //       currently exported as a two staff part ...
+                  for (int i = 0; i < staves; i++) {
+                        Staff* st = part->staff(i);
+                        if (st->lines() != 5) {
+                              if (staves > 1)
+                                    xml.stag(QString("staff-details number=\"%1\"").arg(i+1));
+                              else
+                                    xml.stag("staff-details");
+                              xml.tag("staff-lines", st->lines());
+                              if (st->isTabStaff() && instrument->tablature()) {
+                                    QList<int> l = instrument->tablature()->stringList();
+                                    for (int i = 0; i < l.size(); i++) {
+                                          char step  = ' ';
+                                          int alter  = 0;
+                                          int octave = 0;
+                                          midipitch2xml(l.at(i), step, alter, octave);
+                                          xml.stag(QString("staff-tuning line=\"%1\"").arg(i+1));
+                                          xml.tag("tuning-step", QString("%1").arg(step));
+                                          if (alter)
+                                                xml.tag("tuning-alter", alter);
+                                          xml.tag("tuning-octave", octave);
+                                          xml.etag();
+                                          }
+                                    }
+                              xml.etag();
+                              }
+                        }
+                  // instrument details
+                  if (instrument->transpose().chromatic) {
+                        xml.stag("transpose");
+                        xml.tag("diatonic",  instrument->transpose().diatonic);
+                        xml.tag("chromatic", instrument->transpose().chromatic);
+                        xml.etag();
+                        }
+                  }
+
+            // output attribute at start of measure: measure-style
+            measureStyle(xml, attr, m);
+
+            // MuseScore limitation: repeats are always in the first part
+            // and are implicitly placed at either measure start or stop
+            if (idx == 0)
+                  repeatAtMeasureStart(xml, attr, m, strack, etrack, strack);
+
+            for (int st = strack; st < etrack; ++st) {
+                  // sstaff - xml staff number, counting from 1 for this
+                  // instrument
+                  // special number 0 -> dont show staff number in
+                  // xml output (because there is only one staff)
+
+                  int sstaff = (staves > 1) ? st - strack + VOICES : 0;
+                  sstaff /= VOICES;
+
+                  for (Segment* seg = m->first(); seg; seg = seg->next()) {
+                        Element* el = seg->element(st);
+                        if (!el)
+                              continue;
+                        // must ignore start repeat to prevent spurious backup/forward
+                        if (el->type() == Element::BAR_LINE && static_cast<BarLine*>(el)->barLineType() == START_REPEAT)
+                              continue;
+
+                        // look for harmony element for this tick position
+                        if (el->isChordRest()) {
+                              QList<Element*> list;
+
+#if 0 // TODO-WS
+                              foreach(Element* he, *m->el()) {
+                                    if ((he->type() == Element::HARMONY) && (he->staffIdx() == sstaff)
+                                        && (he->tick() == el->tick())) {
+                                          list << he;
+                                          }
+                                    }
+#endif
+
+                              qSort(list.begin(), list.end(), elementRighter);
+
+                              foreach (Element* hhe, list) {
+                                    attr.doAttr(xml, false);
+                                    qDebug("writing harmony");
+                                    harmony((Harmony*)hhe, 0);
+                                    }
+                              }
+
+                        // generate backup or forward to the start time of the element
+                        // but not for breath, which has the same start time as the
+                        // previous note, while tick is already at the end of that note
+                        if (tick != seg->tick()) {
+                              attr.doAttr(xml, false);
+                              if (el->type() != Element::BREATH)
+                                    moveToTick(seg->tick());
+                              }
+
+                        // handle annotations and spanners (directions attached to this note or rest)
+                        if (el->isChordRest()) {
+                              attr.doAttr(xml, false);
+                              annotations(this, xml, strack, etrack, st, sstaff, seg);
+                              figuredBass(xml, strack, etrack, st, static_cast<const ChordRest*>(el), fbMap);
+                              spannerStop(this, strack, etrack, st, sstaff, seg);
+                              spannerStart(this, strack, etrack, st, sstaff, seg);
+                              }
+
+                        switch (el->type()) {
+
+                              case Element::CLEF:
+                                    {
+                                    // output only clef changes, not generated clefs
+                                    // at line beginning
+                                    // also ignore clefs at the start of a measure,
+                                    // these have already been output
+                                    int ct = ((Clef*)el)->clefType();
+#ifdef DEBUG_CLEF
+                                    int ti = seg->tick();
+                                    qDebug("exportxml: clef in measure ti=%d ct=%d gen=%d", ti, ct, el->generated());
+#endif
+                                    if (el->generated()) {
+#ifdef DEBUG_CLEF
+                                          qDebug("exportxml: generated clef not exported");
+#endif
+                                          break;
+                                          }
+                                    if (!el->generated() && seg->tick() != m->tick())
+                                          clef(sstaff, ct);
+                                    else {
+#ifdef DEBUG_CLEF
+                                          qDebug("exportxml: clef not exported");
+#endif
+                                          }
+                                    }
+                                    break;
+
+                              case Element::KEYSIG:
+                                    // ignore
+                                    break;
+
+                              case Element::TIMESIG:
+                                    // ignore
+                                    break;
+
+                              case Element::CHORD:
+                                    {
+                                    Chord* c                 = static_cast<Chord*>(el);
+                                    const QList<Lyrics*>* ll = &c->lyricsList();
+
+                                    chord(c, sstaff, ll, part->instr()->useDrumset());
+                                    break;
+                                    }
+                              case Element::REST:
+                                    rest((Rest*)el, sstaff);
+                                    break;
+
+                              case Element::BAR_LINE:
+                                    // Following must be enforced (ref MusicXML barline.dtd):
+                                    // If location is left, it should be the first element in the measure;
+                                    // if location is right, it should be the last element.
+                                    // implementation note: START_REPEAT already written by barlineLeft()
+                                    // any bars left should be "middle"
+                                    // TODO: print barline only if middle
+                                    // if (el->subtype() != START_REPEAT)
+                                    //       bar((BarLine*) el);
+                                    break;
+                              case Element::BREATH:
+                                    // ignore, already exported as note articulation
+                                    break;
+
+                              default:
+                                    qDebug("ExportMusicXml::write unknown segment type %s\n", el->name());
+                                    break;
+                              }
+                        } // for (Segment* seg = ...
+                  attr.stop(xml);
+                  } // for (int st = ...
+            // move to end of measure (in case of incomplete last voice)
+#ifdef DEBUG_TICK
+            qDebug("end of measure");
+#endif
+            moveToTick(m->tick() + m->ticks());
+            if (idx == 0)
+                  repeatAtMeasureStop(xml, m, strack, etrack, strack);
+            // note: don't use "m->repeatFlags() & RepeatEnd" here, because more
+            // barline types need to be handled besides repeat end ("light-heavy")
+            barlineRight(m);
+            xml.etag();
+            }
+      xml.etag();
+      }
+
+//---------------------------------------------------------
+//   PartJob
+//---------------------------------------------------------
+
+struct PartJob {
+      int idx;
+      int staffCount;         // staves in the parts before this one
+      QByteArray data;        // the complete part element
+      TextLine const* bracket[MAX_BRACKETS];    // bracket numbers in use after the part
+      };
+
+//---------------------------------------------------------
+//   parallelPartExport
+//    parts are written concurrently on the global thread
+//    pool when called from the gui thread; jobs of a batch
+//    conversion already run in parallel and write their
+//    parts serially
+//---------------------------------------------------------
+
+static bool parallelPartExport(int parts)
+      {
+      return parts > 1
+         && QThread::currentThread() == qApp->thread()
+         && QThreadPool::globalInstance()->maxThreadCount() > 1
+         && QFontDatabase::supportsThreadedFontRendering();
+      }
+
+//---------------------------------------------------------
+//   writePart
+//    write one part with a private exporter, so that parts
+//    can be written concurrently; brackets holds the bracket
+//    numbers in use before the part and is updated to the
+//    numbers still in use after it
+//---------------------------------------------------------
+
+QByteArray ExportMusicXml::writePart(int idx, int staffCount, TextLine const** brackets) const
+      {
+      ExportMusicXml exp(score);
+      exp.div         = div;
+      exp.millimeters = millimeters;
+      exp.tenths      = tenths;
+      for (int i = 0; i < MAX_BRACKETS; ++i)
+            exp.bracket[i] = brackets[i];
+      QBuffer buffer;
+      buffer.open(QIODevice::WriteOnly);
+      exp.xml.setDevice(&buffer);
+      exp.xml.setCodec("utf8");
+      exp.xml.pushTag("score-partwise");        // indent as in the complete file
+      exp.part(score->parts().at(idx), idx, staffCount);
+      exp.xml.flush();
+      for (int i = 0; i < MAX_BRACKETS; ++i)
+            brackets[i] = exp.bracket[i];
+      return buffer.data();
+      }
+
 //---------------------------------------------------------
 //  write
 //---------------------------------------------------------
@@ -3990,402 +4451,50 @@ void ExportMusicXml::write(QIODevice* dev)
 
       staffCount = 0;
 
+      // each part body is written into its own buffer and the buffers
+      // are copied in score order. The only state carried from one part
+      // to the next are the bracket numbers still in use, so the parts
+      // are written concurrently assuming no bracket is in use and a
+      // part is written again if the parts before it leave a bracket
+      // open; the output does not depend on the number of threads
+      QList<PartJob> jobs;
       for (int idx = 0; idx < il.size(); ++idx) {
-            Part* part = il.at(idx);
-            tick = 0;
-            xml.stag(QString("part id=\"P%1\"").arg(idx+1));
-
-            int staves = part->nstaves();
-            int strack = score->staffIdx(part) * VOICES;
-            int etrack = strack + staves * VOICES;
-
-            trillStart.clear();
-            trillStop.clear();
-
-            int measureNo = 1;          // number of next regular measure
-            int irregularMeasureNo = 1; // number of next irregular measure
-            int pickupMeasureNo = 1;    // number of next pickup measure
-
-            FigBassMap fbMap;           // pending figure base extends
-
-            for (MeasureBase* mb = score->measures()->first(); mb; mb = mb->next()) {
-                  if (mb->type() != Element::MEASURE)
-                        continue;
-                  Measure* m = static_cast<Measure*>(mb);
-                  const PageFormat* pf = score->pageFormat();
-
-
-                  // pickup and other irregular measures need special care
-                  QString measureTag = "measure number=";
-                  if ((irregularMeasureNo + measureNo) == 2 && m->irregular()) {
-                        measureTag += "\"0\" implicit=\"yes\"";
-                        pickupMeasureNo++;
-                        }
-                  else if (m->irregular())
-                        measureTag += QString("\"X%1\" implicit=\"yes\"").arg(irregularMeasureNo++);
-                  else
-                        measureTag += QString("\"%1\"").arg(measureNo++);
-                  if (preferences.musicxmlExportLayout)
-                        measureTag += QString(" width=\"%1\"").arg(QString::number(m->bbox().width() / MScore::DPMM / millimeters * tenths,'f',2));
-                  xml.stag(measureTag);
-
-                  // Handle the <print> element.
-                  // When exporting layout and all breaks, a <print> with layout informations
-                  // is generated for the measure types TopSystem, NewSystem and newPage.
-                  // When exporting layout but only manual or no breaks, a <print> with
-                  // layout informations is generated only for the measure type TopSystem,
-                  // as it is assumed the system layout is broken by the importing application
-                  // anyway and is thus useless.
-
-                  int currentSystem = NoSystem;
-                  Measure* previousMeasure = 0;
-
-                  for (MeasureBase* currentMeasureB = m->prev(); currentMeasureB; currentMeasureB = currentMeasureB->prev()) {
-                        if (currentMeasureB->type() == Element::MEASURE) {
-                              previousMeasure = (Measure*) currentMeasureB;
+            PartJob job;
+            job.idx        = idx;
+            job.staffCount = staffCount;
+            for (int i = 0; i < MAX_BRACKETS; ++i)
+                  job.bracket[i] = 0;
+            jobs.append(job);
+            staffCount += il.at(idx)->nstaves();
+            }
+      if (parallelPartExport(jobs.size())) {
+            QtConcurrent::blockingMap(jobs, [this](PartJob& job) {
+                  job.data = writePart(job.idx, job.staffCount, job.bracket);
+                  });
+            for (PartJob& job : jobs) {
+                  bool clean = true;
+                  for (int i = 0; i < MAX_BRACKETS; ++i) {
+                        if (bracket[i]) {
+                              clean = false;
                               break;
                               }
                         }
-
-                  if (!previousMeasure)
-                        currentSystem = TopSystem;
-                  else if (m->parent()->parent() != previousMeasure->parent()->parent())
-                        currentSystem = NewPage;
-                  else if (m->parent() != previousMeasure->parent())
-                        currentSystem = NewSystem;
-
-                  bool prevMeasLineBreak = false;
-                  bool prevMeasPageBreak = false;
-                  if (previousMeasure) {
-                        prevMeasLineBreak = previousMeasure->lineBreak();
-                        prevMeasPageBreak = previousMeasure->pageBreak();
-                        }
-
-                  if (currentSystem != NoSystem) {
-
-                        // determine if a new-system or new-page is required
-                        QString newThing; // new-[system|page]="yes" or empty
-                        if (preferences.musicxmlExportBreaks == ALL_BREAKS) {
-                              if (currentSystem == NewSystem)
-                                    newThing = " new-system=\"yes\"";
-                              else if (currentSystem == NewPage)
-                                    newThing = " new-page=\"yes\"";
-                              }
-                        else if (preferences.musicxmlExportBreaks == MANUAL_BREAKS) {
-                              if (currentSystem == NewSystem && prevMeasLineBreak)
-                                    newThing = " new-system=\"yes\"";
-                              else if (currentSystem == NewPage && prevMeasPageBreak)
-                                    newThing = " new-page=\"yes\"";
-                              }
-
-                        // determine if layout information is required
-                        bool doLayout = false;
-                        if (preferences.musicxmlExportLayout) {
-                              if (currentSystem == TopSystem
-                                  || (preferences.musicxmlExportBreaks == ALL_BREAKS && newThing != "")) {
-                                    doLayout = true;
-                                    }
-                              }
-
-                        if (doLayout) {
-                              xml.stag(QString("print%1").arg(newThing));
-                              const double pageWidth  = getTenthsFromInches(pf->size().width());
-                              const double lm = getTenthsFromInches(pf->oddLeftMargin());
-                              const double rm = getTenthsFromInches(pf->oddRightMargin());
-                              const double tm = getTenthsFromInches(pf->oddTopMargin());
-
-                              // System Layout
-                              // Put the system print suggestions only for the first part in a score...
-                              if (idx == 0) {
-                                    // Find the right margin of the system.
-                                    double systemLM = getTenthsFromDots(m->pagePos().x() - m->system()->page()->pagePos().x()) - lm;
-                                    double systemRM = pageWidth - rm - (getTenthsFromDots(m->system()->bbox().width()) + lm);
-
-                                    xml.stag("system-layout");
-                                    xml.stag("system-margins");
-                                    xml.tag("left-margin", QString("%1").arg(QString::number(systemLM,'f',2)));
-                                    xml.tag("right-margin", QString("%1").arg(QString::number(systemRM,'f',2)) );
-                                    xml.etag();
-
-                                    if (currentSystem == NewPage || currentSystem == TopSystem)
-                                          xml.tag("top-system-distance", QString("%1").arg(QString::number(getTenthsFromDots(m->pagePos().y()) - tm,'f',2)) );
-                                    if (currentSystem == NewSystem)
-                                          xml.tag("system-distance", QString("%1").arg(QString::number(getTenthsFromDots(m->pagePos().y() - previousMeasure->pagePos().y() - previousMeasure->bbox().height()),'f',2)));
-
-                                    xml.etag();
-                                    }
-
-                              // Staff layout elements.
-                              for (int staffIdx = (staffCount == 0) ? 1 : 0; staffIdx < staves; staffIdx++) {
-                                    xml.stag(QString("staff-layout number=\"%1\"").arg(staffIdx + 1));
-                                    xml.tag("staff-distance", QString("%1").arg(QString::number(getTenthsFromDots(mb->system()->staff(staffCount + staffIdx - 1)->distanceDown()),'f',2)));
-                                    xml.etag();
-                                    }
-
-                              xml.etag();
-                              }
-                        else {
-                              // !doLayout
-                              if (newThing != "")
-                                    xml.tagE(QString("print%1").arg(newThing));
-                              }
-
-                        } // if (currentSystem ...
-
-                  attr.start();
-
-                  findTrills(m, strack, etrack, trillStart, trillStop);
-
-                  // barline left must be the first element in a measure
-                  barlineLeft(m);
-
-                  // output attributes with the first actual measure (pickup or regular)
-                  if ((irregularMeasureNo + measureNo + pickupMeasureNo) == 4) {
-                        attr.doAttr(xml, true);
-                        xml.tag("divisions", MScore::division / div);
-                        }
-                  // output attributes at start of measure: key, time
-                  keysigTimesig(m, strack, etrack);
-                  // output attributes with the first actual measure (pickup or regular) only
-                  if ((irregularMeasureNo + measureNo + pickupMeasureNo) == 4) {
-                        if (staves > 1)
-                              xml.tag("staves", staves);
-                        }
-                  // output attribute at start of measure: clef
-                  for (Segment* seg = m->first(); seg; seg = seg->next()) {
-
-                        if (seg->tick() > m->tick())
-                              break;
-                        Element* el = seg->element(strack);
-                        if (!el)
-                              continue;
-                        if (el->type() == Element::CLEF)
-                              for (int st = strack; st < etrack; st += VOICES) {
-                                    // sstaff - xml staff number, counting from 1 for this
-                                    // instrument
-                                    // special number 0 -> dont show staff number in
-                                    // xml output (because there is only one staff)
-
-                                    int sstaff = (staves > 1) ? st - strack + VOICES : 0;
-                                    sstaff /= VOICES;
-
-                                    el = seg->element(st);
-                                    if (el && el->type() == Element::CLEF) {
-                                          Clef* cle = static_cast<Clef*>(el);
-                                          int ct = cle->clefType();
-                                          int ti = cle->segment()->tick();
-#ifdef DEBUG_CLEF
-                                          qDebug("exportxml: clef at start measure ti=%d ct=%d gen=%d", ti, ct, el->generated());
-#endif
-                                          // output only clef changes, not generated clefs at line beginning
-                                          // exception: at tick=0, export clef anyway
-                                          if (ti == 0 || !cle->generated()) {
-#ifdef DEBUG_CLEF
-                                                qDebug("exportxml: clef exported");
-#endif
-                                                clef(sstaff, ct);
-                                                }
-                                          else {
-#ifdef DEBUG_CLEF
-                                                qDebug("exportxml: clef not exported");
-#endif
-                                                }
-                                          }
-                                    }
-                        }
-
-                  // output attributes with the first actual measure (pickup or regular) only
-                  if ((irregularMeasureNo + measureNo + pickupMeasureNo) == 4) {
-                        const Instrument* instrument = part->instr();
-
-                        // staff details
-                        // TODO: decide how to handle linked regular / TAB staff
-                        //       currently exported as a two staff part ...
-                        for (int i = 0; i < staves; i++) {
-                              Staff* st = part->staff(i);
-                              if (st->lines() != 5) {
-                                    if (staves > 1)
-                                          xml.stag(QString("staff-details number=\"%1\"").arg(i+1));
-                                    else
-                                          xml.stag("staff-details");
-                                    xml.tag("staff-lines", st->lines());
-                                    if (st->isTabStaff() && instrument->tablature()) {
-                                          QList<int> l = instrument->tablature()->stringList();
-                                          for (int i = 0; i < l.size(); i++) {
-                                                char step  = ' ';
-                                                int alter  = 0;
-                                                int octave = 0;
-                                                midipitch2xml(l.at(i), step, alter, octave);
-                                                xml.stag(QString("staff-tuning line=\"%1\"").arg(i+1));
-                                                xml.tag("tuning-step", QString("%1").arg(step));
-                                                if (alter)
-                                                      xml.tag("tuning-alter", alter);
-                                                xml.tag("tuning-octave", octave);
-                                                xml.etag();
-                                                }
-                                          }
-                                    xml.etag();
-                                    }
-                              }
-                        // instrument details
-                        if (instrument->transpose().chromatic) {
-                              xml.stag("transpose");
-                              xml.tag("diatonic",  instrument->transpose().diatonic);
-                              xml.tag("chromatic", instrument->transpose().chromatic);
-                              xml.etag();
-                              }
+                  if (!clean) {
+                        for (int i = 0; i < MAX_BRACKETS; ++i)
+                              job.bracket[i] = bracket[i];
+                        job.data = writePart(job.idx, job.staffCount, job.bracket);
                         }
-
-                  // output attribute at start of measure: measure-style
-                  measureStyle(xml, attr, m);
-
-                  // MuseScore limitation: repeats are always in the first part
-                  // and are implicitly placed at either measure start or stop
-                  if (idx == 0)
-                        repeatAtMeasureStart(xml, attr, m, strack, etrack, strack);
-
-                  for (int st = strack; st < etrack; ++st) {
-                        // sstaff - xml staff number, counting from 1 for this
-                        // instrument
-                        // special number 0 -> dont show staff number in
-                        // xml output (because there is only one staff)
-
-                        int sstaff = (staves > 1) ? st - strack + VOICES : 0;
-                        sstaff /= VOICES;
-
-                        for (Segment* seg = m->first(); seg; seg = seg->next()) {
-                              Element* el = seg->element(st);
-                              if (!el)
-                                    continue;
-                              // must ignore start repeat to prevent spurious backup/forward
-                              if (el->type() == Element::BAR_LINE && static_cast<BarLine*>(el)->barLineType() == START_REPEAT)
-                                    continue;
-
-                              // look for harmony element for this tick position
-                              if (el->isChordRest()) {
-                                    QList<Element*> list;
-
-#if 0 // TODO-WS
-                                    foreach(Element* he, *m->el()) {
-                                          if ((he->type() == Element::HARMONY) && (he->staffIdx() == sstaff)
-                                              && (he->tick() == el->tick())) {
-                                                list << he;
-                                                }
-                                          }
-#endif
-
-                                    qSort(list.begin(), list.end(), elementRighter);
-
-                                    foreach (Element* hhe, list) {
-                                          attr.doAttr(xml, false);
-                                          qDebug("writing harmony");
-                                          harmony((Harmony*)hhe, 0);
-                                          }
-                                    }
-
-                              // generate backup or forward to the start time of the element
-                              // but not for breath, which has the same start time as the
-                              // previous note, while tick is already at the end of that note
-                              if (tick != seg->tick()) {
-                                    attr.doAttr(xml, false);
-                                    if (el->type() != Element::BREATH)
-                                          moveToTick(seg->tick());
-                                    }
-
-                              // handle annotations and spanners (directions attached to this note or rest)
-                              if (el->isChordRest()) {
-                                    attr.doAttr(xml, false);
-                                    annotations(this, xml, strack, etrack, st, sstaff, seg);
-                                    figuredBass(xml, strack, etrack, st, static_cast<const ChordRest*>(el), fbMap);
-                                    spannerStop(this, strack, etrack, st, sstaff, seg);
-                                    spannerStart(this, strack, etrack, st, sstaff, seg);
-                                    }
-
-                              switch (el->type()) {
-
-                                    case Element::CLEF:
-                                          {
-                                          // output only clef changes, not generated clefs
-                                          // at line beginning
-                                          // also ignore clefs at the start of a measure,
-                                          // these have already been output
-                                          int ct = ((Clef*)el)->clefType();
-#ifdef DEBUG_CLEF
-                                          int ti = seg->tick();
-                                          qDebug("exportxml: clef in measure ti=%d ct=%d gen=%d", ti, ct, el->generated());
-#endif
-                                          if (el->generated()) {
-#ifdef DEBUG_CLEF
-                                                qDebug("exportxml: generated clef not exported");
-#endif
-                                                break;
-                                                }
-                                          if (!el->generated() && seg->tick() != m->tick())
-                                                clef(sstaff, ct);
-                                          else {
-#ifdef DEBUG_CLEF
-                                                qDebug("exportxml: clef not exported");
-#endif
-                                                }
-                                          }
-                                          break;
-
-                                    case Element::KEYSIG:
-                                          // ignore
-                                          break;
-
-                                    case Element::TIMESIG:
-                                          // ignore
-                                          break;
-
-                                    case Element::CHORD:
-                                          {
-                                          Chord* c                 = static_cast<Chord*>(el);
-                                          const QList<Lyrics*>* ll = &c->lyricsList();
-
-                                          chord(c, sstaff, ll, part->instr()->useDrumset());
-                                          break;
-                                          }
-                                    case Element::REST:
-                                          rest((Rest*)el, sstaff);
-                                          break;
-
-                                    case Element::BAR_LINE:
-                                          // Following must be enforced (ref MusicXML barline.dtd):
-                                          // If location is left, it should be the first element in the measure;
-                                          // if location is right, it should be the last element.
-                                          // implementation note: START_REPEAT already written by barlineLeft()
-                                          // any bars left should be "middle"
-                                          // TODO: print barline only if middle
-                                          // if (el->subtype() != START_REPEAT)
-                                          //       bar((BarLine*) el);
-                                          break;
-                                    case Element::BREATH:
-                                          // ignore, already exported as note articulation
-                                          break;
-
-                                    default:
-                                          qDebug("ExportMusicXml::write unknown segment type %s\n", el->name());
-                                          break;
-                                    }
-                              } // for (Segment* seg = ...
-                        attr.stop(xml);
-                        } // for (int st = ...
-                  // move to end of measure (in case of incomplete last voice)
-#ifdef DEBUG_TICK
-                  qDebug("end of measure");
-#endif
-                  moveToTick(m->tick() + m->ticks());
-                  if (idx == 0)
-                        repeatAtMeasureStop(xml, m, strack, etrack, strack);
-                  // note: don't use "m->repeatFlags() & RepeatEnd" here, because more
-                  // barline types need to be handled besides repeat end ("light-heavy")
-                  barlineRight(m);
-                  xml.etag();
+                  for (int i = 0; i < MAX_BRACKETS; ++i)
+                        bracket[i] = job.bracket[i];
                   }
-            staffCount += staves;
-            xml.etag();
             }
+      else {
+            for (PartJob& job : jobs)
+                  job.data = writePart(job.idx, job.staffCount, bracket);
+            }
+      xml.flush();
+      foreach(const PartJob& job, jobs)
+            dev->write(job.data);
 
       xml.etag();
       }
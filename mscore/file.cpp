@@ -91,6 +91,8 @@
 #include "libmscore/chordlist.h"
 #include "libmscore/mscore.h"
 
+#include <functional>
+
 extern Ms::Score::FileError importOve(Ms::Score*, const QString& name);
 
 namespace Ms {
@@ -115,9 +117,9 @@ extern MasterSynthesizer* synti;
 //   paintElements
 //---------------------------------------------------------
 
-static void paintElements(QPainter& p, const QList<const Element*>& el)
+static void paintElements(QPainter& p, const QVector<const Element*>& dl)
       {
-      foreach(const Element* e, el) {
+      foreach(const Element* e, dl) {
             if (!e->visible())
                   continue;
             QPointF pos(e->pagePos());
@@ -127,6 +129,31 @@ static void paintElements(QPainter& p, const QList<const Element*>& el)
             }
       }
 
+//---------------------------------------------------------
+//   forEachPage
+//    call f for page 0 .. pages-1; pages are rendered
+//    concurrently on the global thread pool (size set
+//    with -P) when called from the gui thread. Jobs of a
+//    batch conversion already run in parallel and render
+//    their pages serially.
+//---------------------------------------------------------
+
+static void forEachPage(int pages, const std::function<void(int)>& f)
+      {
+      if (pages < 2
+         || QThread::currentThread() != qApp->thread()
+         || QThreadPool::globalInstance()->maxThreadCount() < 2
+         || !QFontDatabase::supportsThreadedFontRendering()) {
+            for (int i = 0; i < pages; ++i)
+                  f(i);
+            return;
+            }
+      QList<int> pl;
+      for (int i = 0; i < pages; ++i)
+            pl.append(i);
+      QtConcurrent::blockingMap(pl, [&f](int& pageNumber) { f(pageNumber); });
+      }
+
 //---------------------------------------------------------
 //   createDefaultFileName
 //---------------------------------------------------------
@@ -188,7 +215,7 @@ static bool readScoreError(const QString& name, Score::FileError error, bool ask
             case Score::FILE_NOT_FOUND:
             case Score::FILE_OPEN_ERROR:
             default:
-                  msg += MScore::lastError;
+                  msg += MScore::lastError();
                   break;
             }
       int rv = false;
@@ -373,7 +400,7 @@ void MuseScore::saveFile()
             writeSessionFile(false);
             }
       if (!cs->saveFile()) {
-            QMessageBox::critical(mscore, tr("MuseScore: Save File"), MScore::lastError);
+            QMessageBox::critical(mscore, tr("MuseScore: Save File"), MScore::lastError());
             return;
             }
       setWindowTitle("MuseScore: " + cs->name());
@@ -383,6 +410,7 @@ void MuseScore::saveFile()
             tab2->setTabText(idx, cs->name());
       QString tmp = cs->tmpName();
       if (!tmp.isEmpty()) {
+            waitAutoSave();
             QFile f(tmp);
             if (!f.remove())
                   qDebug("cannot remove temporary file <%s>\n", qPrintable(f.fileName()));
@@ -1396,6 +1424,12 @@ void MuseScore::printFile()
       if ((toPage < 0) || (toPage >= pages))
             toPage = pages - 1;
 
+      // the pdf stream itself is written serially, but the display
+      // lists of the pages are prepared in parallel
+      forEachPage(toPage - fromPage + 1, [&](int n) {
+            pl.at(fromPage + n)->displayList();
+            });
+
       for (int copy = 0; copy < printerDev.numCopies(); ++copy) {
             bool firstPage = true;
             for (int n = fromPage; n <= toPage; ++n) {
@@ -1403,7 +1437,7 @@ void MuseScore::printFile()
                         printerDev.newPage();
                   firstPage = false;
 
-                  cs->print(&p, n);
+                  cs->print(&p, pl.at(n)->displayList());
                   if ((copy + 1) < printerDev.numCopies())
                         printerDev.newPage();
                   }
@@ -1671,6 +1705,12 @@ bool MuseScore::savePsPdf(Score* cs, const QString& saveName, QPrinter::OutputFo
       if ((toPage < 0) || (toPage >= pages))
             toPage = pages - 1;
 
+      // the pdf stream itself is written serially, but the display
+      // lists of the pages are prepared in parallel
+      forEachPage(toPage - fromPage + 1, [&](int n) {
+            pl.at(fromPage + n)->displayList();
+            });
+
       for (int copy = 0; copy < printerDev.numCopies(); ++copy) {
             bool firstPage = true;
             for (int n = fromPage; n <= toPage; ++n) {
@@ -1678,7 +1718,7 @@ bool MuseScore::savePsPdf(Score* cs, const QString& saveName, QPrinter::OutputFo
                         printerDev.newPage();
                   firstPage = false;
 
-                  cs->print(&p, n);
+                  cs->print(&p, pl.at(n)->displayList());
                   if ((copy + 1) < printerDev.numCopies())
                         printerDev.newPage();
                   }
@@ -1958,7 +1998,8 @@ bool MuseScore::savePng(Score* score, const QString& name, bool screenshot, bool
       int pages = pl.size();
 
       int padding = QString("%1").arg(pages).size();
-      for (int pageNumber = 0; pageNumber < pages; ++pageNumber) {
+      QVector<bool> pageOk(pages);
+      forEachPage(pages, [&](int pageNumber) {
             Page* page = pl.at(pageNumber);
 
             QRectF r = page->abbox();
@@ -1978,7 +2019,7 @@ bool MuseScore::savePng(Score* score, const QString& name, bool screenshot, bool
             p.setRenderHint(QPainter::TextAntialiasing, true);
             p.scale(mag, mag);
 
-            paintElements(p, page->elements());
+            paintElements(p, page->displayList());
 
             if (format == QImage::Format_Indexed8) {
                   //convert to grayscale & respect alpha
@@ -2000,11 +2041,10 @@ bool MuseScore::savePng(Score* score, const QString& name, bool screenshot, bool
                   fileName = fileName.left(fileName.size() - 4);
             fileName += QString("-%1.png").arg(pageNumber+1, padding, 10, QLatin1Char('0'));
 
-            rv = printer.save(fileName, "png");
-            if (!rv)
-                  break;
-            }
-      cs->setPrinting(false);
+            pageOk[pageNumber] = printer.save(fileName, "png");
+            });
+      rv = !pageOk.contains(false);
+      score->setPrinting(false);
       return rv;
       }
 
@@ -2116,7 +2156,7 @@ bool MuseScore::saveSvg(Score* score, const QString& saveName)
       printer.setTitle(title);
       printer.setDescription(QString("Generated by MuseScore %1").arg(VERSION));
       printer.setFileName(saveName);
-      const PageFormat* pf = cs->pageFormat();
+      const PageFormat* pf = score->pageFormat();
       double mag = converterDpi / MScore::DPI;
 
       qreal w = pf->width() * MScore::DPI * score->pages().size();
@@ -2126,15 +2166,35 @@ bool MuseScore::saveSvg(Score* score, const QString& saveName)
 
       score->setPrinting(true);
 
-      QPainter p(&printer);
-      p.setRenderHint(QPainter::Antialiasing, true);
-      p.setRenderHint(QPainter::TextAntialiasing, true);
-      p.scale(mag, mag);
+      // every page is rendered into its own svg fragment,
+      // the fragments are then appended in page order; in
+      // compact mode each fragment has its own symbol
+      // definitions
+      const QList<Page*>& pl = score->pages();
+      QVector<QString> fragments(pl.size());
+      forEachPage(pl.size(), [&](int pageNumber) {
+            QBuffer buffer;
+            SvgGenerator fragment;
+            fragment.setFragment(true);
+            fragment.setCompact(preferences.compactSvg);
+            fragment.setIdPrefix(QString("p%1_").arg(pageNumber + 1));
+            fragment.setResolution(converterDpi);
+            fragment.setSize(printer.size());
+            fragment.setOutputDevice(&buffer);
+
+            QPainter p(&fragment);
+            p.setRenderHint(QPainter::Antialiasing, true);
+            p.setRenderHint(QPainter::TextAntialiasing, true);
+            p.scale(mag, mag);
+            p.translate(QPointF(pf->width() * MScore::DPI * pageNumber, 0.0));
+            paintElements(p, pl.at(pageNumber)->displayList());
+            p.end();
+            fragments[pageNumber] = QString::fromUtf8(buffer.data());
+            });
 
-      foreach (Page* page, score->pages()) {
-            paintElements(p, page->elements());
-            p.translate(QPointF(pf->width() * MScore::DPI, 0.0));
-            }
+      QPainter p(&printer);
+      foreach (const QString& f, fragments)
+            printer.appendFragment(f);
 
       score->setPrinting(false);
       p.end();
@@ -67,6 +67,24 @@ class MidiChord {
       QList<MidiNote> notes;
       };
 
+//---------------------------------------------------------
+//   MidiChordList
+//    chords of a track as a flat vector, sorted by tick;
+//    chords with the same tick keep their insertion order
+//---------------------------------------------------------
+
+typedef std::vector<std::pair<int, MidiChord>> MidiChordList;
+
+static bool chordTickLessThan(const std::pair<int, MidiChord>& a, const std::pair<int, MidiChord>& b)
+      {
+      return a.first < b.first;
+      }
+
+static void sortChords(MidiChordList& chords)
+      {
+      std::stable_sort(chords.begin(), chords.end(), chordTickLessThan);
+      }
+
 //---------------------------------------------------------
 //   MTrack
 //---------------------------------------------------------
@@ -78,13 +96,16 @@ class MTrack {
       MidiTrack* mtrack = 0;
       QString name;
       bool hasKey = false;
+      qint64 prepareTime = 0;       // ns, cleanup and findChords
+      qint64 convertTime = 0;       // ns, meta events and score elements
 
-      std::multimap<int, MidiChord> chords;
+      MidiChordList chords;
 
       void convertTrack(int lastTick);
       void findChords();
       void cleanup(int lastTick, TimeSigMap*);
-      void quantize(int startTick, int endTick, std::multimap<int,MidiChord>&);
+      void prepare(int lastTick, TimeSigMap*);
+      void quantize(int startTick, int endTick, MidiChordList&);
       void processPendingNotes(QList<MidiChord>& notes, int voice, int ctick, int tick);
       void processMeta(int tick, const MidiEvent& mm);
       };
@@ -93,15 +114,12 @@ class MTrack {
 //   quantize
 //---------------------------------------------------------
 
-void MTrack::quantize(int startTick, int endTick, std::multimap<int,MidiChord>& dst)
+void MTrack::quantize(int startTick, int endTick, MidiChordList& dst)
       {
       int division = MScore::division;
 
-      auto i = chords.begin();
-      for (; i != chords.end(); ++i) {
-            if (i->first >= startTick)
-                  break;
-            }
+      auto i = std::lower_bound(chords.begin(), chords.end(), std::pair<int, MidiChord>(startTick, MidiChord()),
+         chordTickLessThan);
       //
       // find shortest note in measure
       //
@@ -150,7 +168,7 @@ void MTrack::quantize(int startTick, int endTick, std::multimap<int,MidiChord>&
             MidiChord e = i->second;
             e.onTime    = ((e.onTime + raster2) / raster) * raster;
             e.duration  = quantizeLen(e.duration, raster);
-            dst.insert(std::pair<int,MidiChord>(e.onTime, e));
+            dst.push_back(std::pair<int,MidiChord>(e.onTime, e));
             }
       }
 
@@ -162,7 +180,8 @@ void MTrack::quantize(int startTick, int endTick, std::multimap<int,MidiChord>&
 
 void MTrack::cleanup(int lastTick, TimeSigMap* sigmap)
     {
-      std::multimap<int, MidiChord> dl;
+      MidiChordList dl;
+      dl.reserve(chords.size());
 
       //
       //	quantize every measure
@@ -175,6 +194,9 @@ void MTrack::cleanup(int lastTick, TimeSigMap* sigmap)
                   break;
             startTick = endTick;
             }
+      // rounding can move a chord past the first chords
+      // of the next measure
+      sortChords(dl);
 
       for (auto i = dl.begin(); i != dl.end(); ++i) {
             const MidiChord& e = i->second;
@@ -197,7 +219,7 @@ void MTrack::cleanup(int lastTick, TimeSigMap* sigmap)
                   continue;
                   }
             }
-      chords = dl;
+      chords.swap(dl);
       }
 
 //---------------------------------------------------------
@@ -209,7 +231,12 @@ void MTrack::findChords()
       Drumset* drumset = mtrack->drumTrack() ? smDrumset : 0;
       int jitter       = 3;   // tick tolerance for note on/off
 
+      // chords merged into a previous chord are marked and
+      // removed in one pass at the end
+      std::vector<bool> merged(chords.size(), false);
       for (auto i = chords.begin(); i != chords.end(); ++i) {
+            if (merged[i - chords.begin()])
+                  continue;
             const MidiChord& e = i->second;
             int ontime   = i->first;
             int offtime  = ontime + e.duration;
@@ -224,26 +251,48 @@ void MTrack::findChords()
                   }
             auto k = i;
             ++k;
-            for (; k != chords.end();) {
+            for (; k != chords.end(); ++k) {
                   if (k->first - jitter > ontime)
                         break;
+                  if (merged[k - chords.begin()])
+                        continue;
                   int on2  = k->first;
                   int off2 = k->first + k->second.duration;
-                  if (qAbs(on2 - ontime) > jitter || qAbs(off2 - offtime) > jitter) {
-                        ++k;
+                  if (qAbs(on2 - ontime) > jitter || qAbs(off2 - offtime) > jitter)
                         continue;
-                        }
                   int pitch = k->second.notes[0].pitch;
                   if (!useDrumset
                      || (drumset->isValid(pitch) && drumset->voice(pitch) == e.voice)
                      ) {
                         i->second.notes.append(k->second.notes[0]);
-                        k = chords.erase(k);
+                        merged[k - chords.begin()] = true;
                         }
-                  else
-                        ++k;
                   }
             }
+      int n = 0;
+      for (int i = 0; i < int(chords.size()); ++i) {
+            if (merged[i])
+                  continue;
+            if (n != i)
+                  std::swap(chords[n], chords[i]);
+            ++n;
+            }
+      chords.resize(n);
+      }
+
+//---------------------------------------------------------
+//   prepare
+//    the per track stages which do not touch the score;
+//    can run concurrently for different tracks
+//---------------------------------------------------------
+
+void MTrack::prepare(int lastTick, TimeSigMap* sigmap)
+      {
+      QElapsedTimer timer;
+      timer.start();
+      cleanup(lastTick, sigmap);   // quantize
+      findChords();
+      prepareTime = timer.nsecsElapsed();
       }
 
 //---------------------------------------------------------
@@ -641,7 +690,7 @@ static void splitIntoLeftRightHands(QList<MTrack>& tracks, tMidiImportOperations
             leftHandTrack.mtrack = srcTrack.mtrack;
             rightHandTrack.mtrack = srcTrack.mtrack;
 
-            typedef std::multimap<int, MidiChord>::iterator tIter;
+            typedef MidiChordList::iterator tIter;
             std::vector<tIter> chordGroup;
             int currentTime = 0;
             const int OCTAVE = 12;
@@ -679,23 +728,26 @@ static void splitIntoLeftRightHands(QList<MTrack>& tracks, tMidiImportOperations
                               // and assign all other chords to right hand
                               for (const auto &chordIter: chordGroup) {
                                     if (chordIter->second.notes[0].pitch <= minPitch + OCTAVE)
-                                          leftHandTrack.chords.insert({chordIter->first, chordIter->second});
+                                          leftHandTrack.chords.push_back({chordIter->first, chordIter->second});
                                     else
-                                          rightHandTrack.chords.insert({chordIter->first, chordIter->second});
+                                          rightHandTrack.chords.push_back({chordIter->first, chordIter->second});
                                     }
                               // maybe todo later: if range of right-hand chords > OCTAVE => assign all bottom right-hand
                               // chords to another, third track
                               }
                         else { // check - use two hands or one hand will be enough (right or left?)
                               // assign top chord for right hand, all the rest - to left hand
-                              rightHandTrack.chords.insert({chordGroup.back()->first, chordGroup.back()->second});
+                              rightHandTrack.chords.push_back({chordGroup.back()->first, chordGroup.back()->second});
                               for (auto p = chordGroup.begin(); p != chordGroup.end() - 1; ++p)
-                                    leftHandTrack.chords.insert({(*p)->first, (*p)->second});
+                                    leftHandTrack.chords.push_back({(*p)->first, (*p)->second});
                               }
                         // reset group for next iteration
                         chordGroup.clear();
                         }
                   }
+            // chord groups were appended in pitch order
+            sortChords(leftHandTrack.chords);
+            sortChords(rightHandTrack.chords);
             if (!rightHandTrack.chords.empty())
                   srcTrack = rightHandTrack;
             if (!leftHandTrack.chords.empty()) {
@@ -763,7 +815,8 @@ void createMTrackList(int& lastTick, Score* score, QList<MTrack>& tracks, MidiFi
                         c.duration = len;
                         c.notes.push_back(n);
 
-                        track.chords.insert(std::pair<int,MidiChord>(tick, c));
+                        // events are sorted by tick, so are the chords
+                        track.chords.push_back(std::pair<int,MidiChord>(tick, c));
                         }
                   else if (e.type() == ME_PROGRAM)
                         track.program = e.dataA();
@@ -844,13 +897,58 @@ void createMeasures(int& lastTick, Score* score)
       lastTick = score->lastMeasure()->endTick();
       }
 
+//---------------------------------------------------------
+//   parallelTrackImport
+//    tracks are prepared concurrently on the global thread
+//    pool when called from the gui thread; jobs of a batch
+//    conversion already run in parallel
+//---------------------------------------------------------
+
+static bool parallelTrackImport(int tracks)
+      {
+      return tracks > 1
+         && QThread::currentThread() == qApp->thread()
+         && QThreadPool::globalInstance()->maxThreadCount() > 1;
+      }
+
+//---------------------------------------------------------
+//   prepareTracks
+//---------------------------------------------------------
+
+static void prepareTracks(int lastTick, TimeSigMap* sigmap, QList<MTrack>& tracks)
+      {
+      if (parallelTrackImport(tracks.size()))
+            QtConcurrent::blockingMap(tracks, [lastTick, sigmap](MTrack& mt) { mt.prepare(lastTick, sigmap); });
+      else {
+            for (MTrack& mt : tracks)
+                  mt.prepare(lastTick, sigmap);
+            }
+      }
+
+//---------------------------------------------------------
+//   reportImportTimes
+//---------------------------------------------------------
+
+static void reportImportTimes(const QList<MTrack>& tracks)
+      {
+      for (int i = 0; i < tracks.size(); ++i) {
+            const MTrack& mt = tracks[i];
+            qDebug("importMidi: track %d <%s>: %d chords, prepare %.2f ms, convert %.2f ms",
+               i, qPrintable(mt.name), int(mt.chords.size()),
+               mt.prepareTime / 1e6, mt.convertTime / 1e6);
+            }
+      }
+
 void createNotes(int lastTick, Score* score, QList<MTrack>& tracks, MidiFile* mf)
 {
+      prepareTracks(lastTick, score->sigmap(), tracks);
+
       for (int i = 0; i < tracks.size(); ++i) {
             MTrack& mt = tracks[i];
             MidiTrack* track = mt.mtrack;
+            QElapsedTimer timer;
+            timer.start();
 
-            mt.cleanup(lastTick, score->sigmap());   // quantize
             for (auto ie : track->events()) {
                   const MidiEvent& e = ie.second;
                   if ((e.type() == ME_META) && (e.metaType() != META_LYRIC))
@@ -878,7 +976,6 @@ void createNotes(int lastTick, Score* score, QList<MTrack>& tracks, MidiFile* mf
                   part->setMidiChannel(track->outChannel());
                   part->setMidiProgram(mt.program & 0x7f);  // only GM
                   }
-            mt.findChords();
             mt.convertTrack(lastTick);
 
             for (auto ie : track->events()) {
@@ -886,7 +983,9 @@ void createNotes(int lastTick, Score* score, QList<MTrack>& tracks, MidiFile* mf
                   if ((e.type() == ME_META) && (e.metaType() == META_LYRIC))
                         mt.processMeta(ie.first, e);
                   }
+            mt.convertTime = timer.nsecsElapsed();
             }
+      reportImportTimes(tracks);
 
       for (auto is = score->sigmap()->begin(); is != score->sigmap()->end(); ++is) {
             SigEvent se = is->second;
@@ -922,14 +1021,13 @@ void convertMidi(Score* score, MidiFile* mf)
       createNotes(lastTick, score, tracks, mf);
       }
 
-QList<QString> getInstrumentNames(int lastTick, Score* score, QList<MTrack>& tracks, MidiFile* mf)
+QList<QString> getInstrumentNames(QList<MTrack>& tracks, MidiFile* mf)
 {
       QList<QString> instrumentNames;
       for (int i = 0; i < tracks.size(); ++i) {
             MTrack& mt = tracks[i];
             MidiTrack* track = mt.mtrack;
 
-            mt.cleanup(lastTick, score->sigmap());   // quantize
             for (auto ie : track->events()) {
                   const MidiEvent& e = ie.second;
                   if ((e.type() == ME_META) && (e.metaType() != META_LYRIC))
@@ -979,7 +1077,7 @@ QList<QString> extractMidiInstruments(const QString& fileName)
 
       mf.separateChannel();
       createMTrackList(lastTick, &mockScore, tracks, &mf);
-      return getInstrumentNames(lastTick, &mockScore, tracks, &mf);
+      return getInstrumentNames(tracks, &mf);
       }
 
 //---------------------------------------------------------
@@ -403,10 +403,10 @@ static void determineMeasureStart(const QVector<int>& ml, QVector<int>& ms)
  MusicXml constructor.
  */
 
-MusicXml::MusicXml(QDomDocument* d, MxmlReaderFirstPass const& p1)
+MusicXml::MusicXml(QIODevice* d, MxmlReaderFirstPass const& p1)
       :
       lastVolta(0),
-      doc(d),
+      device(d),
       pass1(p1),
       maxLyrics(0),
       beamMode(BeamMode::NONE),
@@ -430,7 +430,7 @@ static bool initMusicXmlSchema(QXmlSchema& schema)
       QFile schemaFile(":/schema/musicxml.xsd");
       if (!schemaFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
             qDebug("initMusicXmlSchema() could not open resource musicxml.xsd");
-            MScore::lastError = QT_TRANSLATE_NOOP("file", "internal error: could not open resource musicxml.xsd\n");
+            MScore::setLastError(QT_TRANSLATE_NOOP("file", "internal error: could not open resource musicxml.xsd\n"));
             return false;
             }
 
@@ -451,7 +451,7 @@ static bool initMusicXmlSchema(QXmlSchema& schema)
       schema.load(schemaBa);
       if (!schema.isValid()) {
             qDebug("initMusicXmlSchema() internal error: MusicXML schema is invalid");
-            MScore::lastError = QT_TRANSLATE_NOOP("file", "internal error: MusicXML schema is invalid\n");
+            MScore::setLastError(QT_TRANSLATE_NOOP("file", "internal error: MusicXML schema is invalid\n"));
             return false;
             }
 
@@ -500,7 +500,7 @@ static bool extractRootfile(QFile* qf, QByteArray& data)
       QString err;
       if (!container.setContent(data, false, &err, &line, &column)) {
             QString s = QT_TRANSLATE_NOOP("file", "error reading container.xml at line %1 column %2: %3\n");
-            MScore::lastError = s.arg(line).arg(column).arg(err);
+            MScore::setLastError(s.arg(line).arg(column).arg(err));
             return false;
             }
 
@@ -529,7 +529,7 @@ static bool extractRootfile(QFile* qf, QByteArray& data)
 
       if (rootfile == "") {
             qDebug("can't find rootfile in: %s", qPrintable(qf->fileName()));
-            MScore::lastError = QT_TRANSLATE_NOOP("file", "can't find rootfile\n");
+            MScore::setLastError(QT_TRANSLATE_NOOP("file", "can't find rootfile\n"));
             return false;
             }
 
@@ -568,7 +568,7 @@ static Score::FileError doValidate(const QString& name, QIODevice* dev)
             qDebug("importMusicXml() file '%s' is a valid MusicXML file", qPrintable(name));
       else {
             qDebug("importMusicXml() file '%s' is not a valid MusicXML file", qPrintable(name));
-            MScore::lastError = QT_TRANSLATE_NOOP("file", "this is not a valid MusicXML file\n");
+            MScore::setLastError(QT_TRANSLATE_NOOP("file", "this is not a valid MusicXML file\n"));
             QString text = QString("File '%1' is not a valid MusicXML file").arg(name);
             if (musicXMLValidationErrorDialog(text, messageHandler.getErrors()) != QMessageBox::Yes)
                   return Score::FILE_USER_ABORT;
@@ -590,20 +590,11 @@ static Score::FileError doImport(Score* score, const QString& name, QIODevice* d
       {
       QTime t;
       t.start();
-      QDomDocument doc;
-      int line;
-      int column;
-      QString err;
-      if (!doc.setContent(dev, false, &err, &line, &column)) {
-            QString s = QT_TRANSLATE_NOOP("file", "error at line %1 column %2: %3\n");
-            MScore::lastError = s.arg(line).arg(column).arg(err);
-            return Score::FILE_BAD_FORMAT;
-            }
-      docName = name; // set filename for domError
-      MusicXml musicxml(&doc, pass1);
-      musicxml.import(score);
+      setDomDocName(name); // set filename for domError
+      MusicXml musicxml(dev, pass1);
+      Score::FileError res = musicxml.import(score);
       qDebug("Parsing time elapsed: %d ms", t.elapsed());
-      return Score::FILE_NO_ERROR;
+      return res;
       }
 
 
@@ -626,10 +617,9 @@ static Score::FileError doValidateAndImport(Score* score, const QString& name, Q
       // pass 1
       dev->seek(0);
       MxmlReaderFirstPass pass1;
-      res = pass1.setContent(dev);
+      res = pass1.parseFile(dev);
       if (res != Score::FILE_NO_ERROR)
             return res;
-      pass1.parseFile();
 
       // import the file
       dev->seek(0);
@@ -656,7 +646,7 @@ Score::FileError importMusicXml(Score* score, const QString& name)
       QFile xmlFile(name);
       if (!xmlFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
             qDebug("importMusicXml() could not open MusicXML file '%s'", qPrintable(name));
-            MScore::lastError = QT_TRANSLATE_NOOP("file", "could not open MusicXML file\n");
+            MScore::setLastError(QT_TRANSLATE_NOOP("file", "could not open MusicXML file\n"));
             return Score::FILE_OPEN_ERROR;
             }
 
@@ -682,7 +672,7 @@ Score::FileError importCompressedMusicXml(Score* score, const QString& name)
       QFile mxlFile(name);
       if (!mxlFile.open(QIODevice::ReadOnly)) {
             qDebug("importCompressedMusicXml() could not open compressed MusicXML file '%s'", qPrintable(name));
-            MScore::lastError = QT_TRANSLATE_NOOP("file", "could not open compressed MusicXML file\n");
+            MScore::setLastError(QT_TRANSLATE_NOOP("file", "could not open compressed MusicXML file\n"));
             return Score::FILE_OPEN_ERROR;
             }
 
@@ -711,9 +701,10 @@ static void tupletAssert();
 
 /**
  Parse the MusicXML file, which must be in score-partwise format.
+ The file is streamed, only one measure at a time is held as DOM tree.
  */
 
-void MusicXml::import(Score* s)
+Score::FileError MusicXml::import(Score* s)
       {
       tupletAssert();
       score  = s;
@@ -736,12 +727,21 @@ void MusicXml::import(Score* s)
       // TODO only if multi-measure rests used ???
       // score->style()->set(ST_createMultiMeasureRests, true);
 
-      for (QDomElement e = doc->documentElement(); !e.isNull(); e = e.nextSiblingElement()) {
-            if (e.tagName() == "score-partwise")
-                  scorePartwise(e.firstChildElement());
-            else
-                  domError(e);
+      QXmlStreamReader r(device);
+      while (r.readNextStartElement()) {
+            if (r.name() == "score-partwise")
+                  scorePartwise(r);
+            else {
+                  QDomDocument doc;
+                  domError(MxmlSupport::readElement(r, doc));
+                  }
             }
+      if (r.hasError()) {
+            QString s = QT_TRANSLATE_NOOP("file", "error at line %1 column %2: %3\n");
+            MScore::setLastError(s.arg(r.lineNumber()).arg(r.columnNumber()).arg(r.errorString()));
+            return Score::FILE_BAD_FORMAT;
+            }
+      return Score::FILE_NO_ERROR;
       }
 
 //---------------------------------------------------------
@@ -1009,38 +1009,41 @@ static void readPageFormat(PageFormat* pf, QDomElement de, qreal conversion)
 
 /**
  Read the MusicXML score-partwise element.
+ In: r is positioned on the "score-partwise" start element
  */
 
-void MusicXml::scorePartwise(QDomElement ee)
+void MusicXml::scorePartwise(QXmlStreamReader& r)
       {
-      // In a first pass collect all parts in case the part-list does not
+      // The first pass collected all parts in case the part-list does not
       // list them all. Incomplete part-list's are generated by some versions
       // of Finale.
-      // Furthermore, determine the length in ticks of each measure in the part
-      for (QDomElement e = ee; !e.isNull(); e = e.nextSiblingElement()) {
-            if (e.tagName() == "part") {
-                  QString id = e.attribute(QString("id"));
-                  if (id == "")
-                        qDebug("MusicXML import: part without id");
-                  else {
-                        Part* part = new Part(score);
-                        part->setId(id);
-                        score->appendPart(part);
-                        Staff* staff = new Staff(score, part, 0);
-                        part->staves()->push_back(staff);
-                        score->staves().push_back(staff);
-                        tuplets.resize(VOICES); // part now contains one staff, thus VOICES voices
-                        }
+      foreach(const QString& id, pass1.getPartIds()) {
+            if (id == "")
+                  qDebug("MusicXML import: part without id");
+            else {
+                  Part* part = new Part(score);
+                  part->setId(id);
+                  score->appendPart(part);
+                  Staff* staff = new Staff(score, part, 0);
+                  part->staves()->push_back(staff);
+                  score->staves().push_back(staff);
+                  tuplets.resize(VOICES); // part now contains one staff, thus VOICES voices
                   }
             }
 
       // Read the score
-      for (QDomElement e = ee; !e.isNull(); e = e.nextSiblingElement()) {
+      // parts are streamed measure by measure, all other elements are small
+      // enough to be read as a whole
+      while (r.readNextStartElement()) {
+            if (r.name() == "part") {
+                  xmlPart(r, r.attributes().value("id").toString());
+                  continue;
+                  }
+            QDomDocument doc;
+            QDomElement e = MxmlSupport::readElement(r, doc);
             QString tag(e.tagName());
             if (tag == "part-list")
                   xmlPartList(e.firstChildElement());
-            else if (tag == "part")
-                  xmlPart(e.firstChildElement(), e.attribute(QString("id")));
             else if (tag == "work") {
                   for (QDomElement ee = e.firstChildElement(); !ee.isNull(); ee = ee.nextSiblingElement()) {
                         if (ee.tagName() == "work-number")
@@ -1611,13 +1614,17 @@ static void fillGapsInFirstVoices(Measure* measure, Part* part)
 
 /**
  Read the MusicXML part element.
+ In: r is positioned on the "part" start element
+ Each measure is read into its own small DOM tree and processed
+ before the next one is read.
  */
 
-void MusicXml::xmlPart(QDomElement e, QString id)
+void MusicXml::xmlPart(QXmlStreamReader& r, QString id)
       {
       qDebug("xmlPart(id='%s')", qPrintable(id));
       if (id == "") {
             qDebug("MusicXML import: part without id");
+            r.skipCurrentElement();
             return;
             }
       Part* part = 0;
@@ -1629,6 +1636,7 @@ void MusicXml::xmlPart(QDomElement e, QString id)
             }
       if (part == 0) {
             qDebug("Import MusicXml:xmlPart: cannot find part %s", id.toLatin1().data());
+            r.skipCurrentElement();
             return;
             }
       fractionTSig          = Fraction(0, 1);
@@ -1654,7 +1662,9 @@ void MusicXml::xmlPart(QDomElement e, QString id)
             doCredits();
             }
 
-      for (int measureNr = 0; !e.isNull(); e = e.nextSiblingElement(), measureNr++) {
+      for (int measureNr = 0; r.readNextStartElement(); measureNr++) {
+            QDomDocument doc;
+            QDomElement e = MxmlSupport::readElement(r, doc);
             if (e.tagName() == "measure") {
                   // set the correct start tick for the measure
                   tick = measureStart.at(measureNr);
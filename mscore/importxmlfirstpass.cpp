@@ -480,10 +480,11 @@ static bool determineTimeSig(const QString beats, const QString beatType, const
 
 /**
  Setup the voice mapper for a MusicXML part.
- In: e is the "part" node
+ In: r is positioned on the "part" start element
+ Only one measure at a time is held in memory.
  */
 
-void MxmlReaderFirstPass::initVoiceMapperAndMapVoices(QDomElement e, int partNr)
+void MxmlReaderFirstPass::initVoiceMapperAndMapVoices(QXmlStreamReader& r, int partNr)
       {
       VoiceOverlapDetector vod;
       int loc_divisions = -1;
@@ -494,7 +495,9 @@ void MxmlReaderFirstPass::initVoiceMapperAndMapVoices(QDomElement e, int partNr)
       int timeSigLen = -1; // measure length in ticks according to the last timesig read
 
       // count number of chordrests on each MusicXML staff
-      for (e = e.firstChildElement(); !e.isNull(); e = e.nextSiblingElement()) {
+      while (r.readNextStartElement()) {
+            QDomDocument doc;
+            QDomElement e = MxmlSupport::readElement(r, doc);
             if (e.tagName() == "measure") {
                   Fraction measureStartTick = loc_tick;
                   QString measureNumber = e.attribute("number");
@@ -719,30 +722,13 @@ VoiceList MxmlReaderFirstPass::getVoiceList(const QString id) const
       }
 
 
-Score::FileError MxmlReaderFirstPass::setContent(QIODevice* d)
-      {
-      int line;
-      int column;
-      QString err;
-
-      if (!doc.setContent(d, false, &err, &line, &column)) {
-            QString s = QT_TRANSLATE_NOOP("file", "error at line %1 column %2: %3\n");
-            MScore::lastError = s.arg(line).arg(column).arg(err);
-            return Score::FILE_BAD_FORMAT;
-            }
-
-      // return OK
-      return Score::FILE_NO_ERROR;
-      }
-
-
 // parse the part
-// in: e is the "part" node
+// in: r is positioned on the "part" node
 // equivalent to MuseScores xmlPart
 
-void MxmlReaderFirstPass::parsePart(const QDomElement e, QString& /* partName */, int partNr)
+void MxmlReaderFirstPass::parsePart(QXmlStreamReader& r, QString& /* partName */, int partNr)
       {
-      initVoiceMapperAndMapVoices(e, partNr);
+      initVoiceMapperAndMapVoices(r, partNr);
       }
 
 
@@ -774,33 +760,48 @@ void MxmlReaderFirstPass::parsePartList(QDomElement e)
 
 
 // parse the file
+// streams through the file, the part list is read as a whole,
+// the parts measure by measure
 
-void MxmlReaderFirstPass::parseFile()
+Score::FileError MxmlReaderFirstPass::parseFile(QIODevice* d)
       {
       qDebug("MxmlReaderFirstPass::parseFile() begin");
       QTime t;
       t.start();
-      // get the root element
-      QDomElement e = doc.documentElement();
+      QXmlStreamReader r(d);
 
       // read the score
       int partNr = 0; // part number while reading parts
       qDebug("part list");
-      for (e = e.firstChildElement(); !e.isNull(); e = e.nextSiblingElement()) {
-            if (e.tagName() == "part") {
-                  QString partName = e.attribute("id");
-                  parsePart(e, partName, partNr);
-                  ++partNr;
-                  qDebug("part %d id '%s'", partNr, qPrintable(partName));
-                  }
-            else if (e.tagName() == "part-list") {
-                  parsePartList(e);
+      while (r.readNextStartElement()) {
+            if (r.name() != "score-partwise") {
+                  r.skipCurrentElement();
+                  continue;
                   }
-            else {
-                  // ignore
+            while (r.readNextStartElement()) {
+                  if (r.name() == "part") {
+                        QString partName = r.attributes().value("id").toString();
+                        partIds.append(partName);
+                        parsePart(r, partName, partNr);
+                        ++partNr;
+                        qDebug("part %d id '%s'", partNr, qPrintable(partName));
+                        }
+                  else if (r.name() == "part-list") {
+                        QDomDocument doc;
+                        parsePartList(MxmlSupport::readElement(r, doc));
+                        }
+                  else {
+                        r.skipCurrentElement(); // ignore
+                        }
                   }
             }
 
+      if (r.hasError()) {
+            QString s = QT_TRANSLATE_NOOP("file", "error at line %1 column %2: %3\n");
+            MScore::setLastError(s.arg(r.lineNumber()).arg(r.columnNumber()).arg(r.errorString()));
+            return Score::FILE_BAD_FORMAT;
+            }
+
       // debug: print results
       for (int i = 0; i < parts.size(); ++i) {
             qDebug("part %d\n%s", i + 1, qPrintable(parts.at(i).toString()));
@@ -808,6 +809,7 @@ void MxmlReaderFirstPass::parseFile()
 
       qDebug("Parsing time elapsed: %d ms", t.elapsed());
       qDebug("MxmlReaderFirstPass::parseFile() end");
+      return Score::FILE_NO_ERROR;
       }
 }
 
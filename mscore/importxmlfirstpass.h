@@ -41,18 +41,18 @@ class MxmlReaderFirstPass {
 public:
       MxmlReaderFirstPass();
       bool determineMeasureLength(QVector<int>& ml) const;
-      void initVoiceMapperAndMapVoices(QDomElement e, int partNr);
+      void initVoiceMapperAndMapVoices(QXmlStreamReader& r, int partNr);
       VoiceList getVoiceList(const int n) const;
       VoiceList getVoiceList(const QString id) const;
       int nParts() const { return parts.size(); }
-      void parsePart(QDomElement e, QString& partName, int partNr);
+      QStringList getPartIds() const { return partIds; }
+      void parsePart(QXmlStreamReader& r, QString& partName, int partNr);
       void parsePartList(QDomElement e);
-      void parseFile();
-      Score::FileError setContent(QIODevice* d);
+      Score::FileError parseFile(QIODevice* d);
 private:
-      QDomDocument doc;
       int partNr;           // the current part number, zero-based
       QList<MusicXmlPart> parts;
+      QStringList partIds;  // id of every part element, in file order
       };
 
 
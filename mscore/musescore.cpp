@@ -125,6 +125,8 @@ bool converterMode = false;
 bool noGui = false;
 bool externalIcons = false;
 static bool pluginMode = false;
+static bool synthBenchmarkMode = false;
+static bool batchMode = false;
 static bool startWithNewScore = false;
 double converterDpi = 0;
 
@@ -133,6 +135,8 @@ static QStringList recentScores;
 static QString outFileName;
 static QString audioDriver;
 static QString pluginName;
+static QString synthBenchmarkSpec;
+static QString batchJobFile;
 static QString styleFile;
 QString localeName;
 bool useFactorySettings = false;
@@ -250,6 +254,7 @@ void MuseScore::closeEvent(QCloseEvent* ev)
             scoreList.removeAll(score);
 
       writeSessionFile(true);
+      waitAutoSave();
       foreach(Score* score, scoreList) {
             if (!score->tmpName().isEmpty()) {
                   QFile f(score->tmpName());
@@ -1066,6 +1071,8 @@ MuseScore::MuseScore()
       autoSaveTimer = new QTimer(this);
       autoSaveTimer->setSingleShot(true);
       connect(autoSaveTimer, SIGNAL(timeout()), this, SLOT(autoSaveTimerTimeout()));
+      autoSavePending = false;
+      connect(&autoSaveWatcher, SIGNAL(finished()), SLOT(autoSaveFinished()));
       initOsc();
       startAutoSave();
       if (enableExperimental) {
@@ -1354,15 +1361,22 @@ static void usage()
         "   -I        dump midi input\n"
         "   -O        dump midi output\n"
         "   -o file   export to 'file'; format depends on file extension\n"
+        "   -j file   convert all jobs listed in 'file' in parallel; one job\n"
+        "             per line: input;output[;style]\n"
+        "   -P n      use 'n' threads for conversion and page rendering\n"
         "   -r dpi    set output resolution for image export\n"
         "   -S style  load style file\n"
         "   -p name   execute named plugin\n"
+        "   -b synth[:soundfont]\n"
+        "             benchmark synthesizer (fluid, zerberus, aeolus) playing\n"
+        "             the given midi file or a stress pattern; prints JSON\n"
         "   -F        use factory settings\n"
         "   -i        load icons from INSTALLPATH/icons\n"
         "   -e        enable experimental features\n"
         "   -c dir    override config/settings directory\n"
         "   -t        set testMode flag for all files\n"
         "   -w        write buildin workspace\n"
+        "   -T sec    log audio thread telemetry every 'sec' seconds\n"
         );
       exit(-1);
       }
@@ -1894,6 +1908,7 @@ void MuseScore::removeTab(int i)
             setCurrentScoreView((firstTab ? tab1 : tab2)->view());
       writeSessionFile(false);
       if (!tmpName.isEmpty()) {
+            waitAutoSave();
             QFile f(tmpName);
             f.remove();
             }
@@ -2021,6 +2036,69 @@ static void loadScores(const QStringList& argv)
       mscore->setCurrentView(1, currentScoreView);
       }
 
+//---------------------------------------------------------
+//   convertFile
+//    export score to file fn; format depends on file
+//    extension
+//    return true on success
+//---------------------------------------------------------
+
+bool MuseScore::convertFile(Score* cs, const QString& fn)
+      {
+      if (fn.endsWith(".mscx")) {
+            QFileInfo fi(fn);
+            try {
+                  cs->saveFile(fi);
+                  }
+            catch(QString) {
+                  return false;
+                  }
+            return true;
+            }
+      if (fn.endsWith(".mscz")) {
+            QFileInfo fi(fn);
+            try {
+                  cs->saveCompressedFile(fi, false);
+                  }
+            catch(QString) {
+                  return false;
+                  }
+            return true;
+            }
+      if (fn.endsWith(".xml"))
+            return saveXml(cs, fn);
+      if (fn.endsWith(".mxl"))
+            return saveMxl(cs, fn);
+      if (fn.endsWith(".mid"))
+            return saveMidi(cs, fn);
+      if (fn.endsWith(".pdf"))
+            return savePsPdf(cs, fn, QPrinter::PdfFormat);
+#if QT_VERSION < 0x050000
+      if (fn.endsWith(".ps"))
+            return savePsPdf(cs, fn, QPrinter::PostScriptFormat);
+#endif
+      if (fn.endsWith(".png"))
+            return savePng(cs, fn);
+      if (fn.endsWith(".svg"))
+            return saveSvg(cs, fn);
+      if (fn.endsWith(".ly"))
+            return saveLilypond(cs, fn);
+#ifdef HAS_AUDIOFILE
+      if (fn.endsWith(".wav"))
+            return saveAudio(cs, fn, "wav");
+      if (fn.endsWith(".ogg"))
+            return saveAudio(cs, fn, "ogg");
+      if (fn.endsWith(".flac"))
+            return saveAudio(cs, fn, "flac");
+#endif
+      if (fn.endsWith(".mp3"))
+            return saveMp3(cs, fn);
+      if (fn.endsWith(".pos"))
+            return savePositions(cs, fn);
+      qDebug("dont know how to convert to %s", qPrintable(fn));
+      return false;
+      }
+
 //---------------------------------------------------------
 //   processNonGui
 //---------------------------------------------------------
@@ -2048,7 +2126,6 @@ static bool processNonGui()
             }
 
       if (converterMode) {
-            QString fn(outFileName);
             Score* cs = mscore->currentScore();
             if (!styleFile.isEmpty()) {
                   QFile f(styleFile);
@@ -2056,60 +2133,7 @@ static bool processNonGui()
                         cs->style()->load(&f);
                         }
                   }
-            if (fn.endsWith(".mscx")) {
-                  QFileInfo fi(fn);
-                  try {
-                        cs->saveFile(fi);
-                        }
-                  catch(QString) {
-                        return false;
-                        }
-                  return true;
-                  }
-            if (fn.endsWith(".mscz")) {
-                  QFileInfo fi(fn);
-                  try {
-                        cs->saveCompressedFile(fi, false);
-                        }
-                  catch(QString) {
-                        return false;
-                        }
-                  return true;
-                  }
-            if (fn.endsWith(".xml"))
-                  return saveXml(cs, fn);
-            if (fn.endsWith(".mxl"))
-                  return saveMxl(cs, fn);
-            if (fn.endsWith(".mid"))
-                  return mscore->saveMidi(cs, fn);
-            if (fn.endsWith(".pdf"))
-                  return mscore->savePsPdf(fn, QPrinter::PdfFormat);
-#if QT_VERSION < 0x050000
-            if (fn.endsWith(".ps"))
-                  return mscore->savePsPdf(fn, QPrinter::PostScriptFormat);
-#endif
-            if (fn.endsWith(".png"))
-                  return mscore->savePng(cs, fn);
-            if (fn.endsWith(".svg"))
-                  return mscore->saveSvg(cs, fn);
-            if (fn.endsWith(".ly"))
-                  return mscore->saveLilypond(cs, fn);
-#ifdef HAS_AUDIOFILE
-            if (fn.endsWith(".wav"))
-                  return mscore->saveAudio(cs, fn, "wav");
-            if (fn.endsWith(".ogg"))
-                  return mscore->saveAudio(cs, fn, "ogg");
-            if (fn.endsWith(".flac"))
-                  return mscore->saveAudio(cs, fn, "flac");
-#endif
-            if (fn.endsWith(".mp3"))
-                  return mscore->saveMp3(cs, fn);
-            if (fn.endsWith(".pos"))
-                  return savePositions(cs, fn);
-            else {
-                  qDebug("dont know how to convert to %s", qPrintable(outFileName));
-                  return false;
-                  }
+            return mscore->convertFile(cs, outFileName);
             }
       return true;
       }
@@ -3078,47 +3102,99 @@ void MuseScore::removeSessionFile()
             }
       }
 
+static const int AUTOSAVE_COMPRESSION_LEVEL = 1;      // fastest deflate
+
+//---------------------------------------------------------
+//   writeAutoSave
+//    runs in a worker thread; every file is written to a
+//    new file first so that a crash never leaves a
+//    truncated autosave behind
+//---------------------------------------------------------
+
+static void writeAutoSave(const QList<QPair<QString, MsczContents> >& jobs)
+      {
+      for (const auto& job : jobs) {
+            QString path = job.first;
+            QFile f(path + ".new");
+            if (!f.open(QIODevice::WriteOnly)) {
+                  qDebug("autosave: cannot create <%s>", qPrintable(f.fileName()));
+                  continue;
+                  }
+            try {
+                  job.second.write(&f, AUTOSAVE_COMPRESSION_LEVEL);
+                  }
+            catch(QString s) {
+                  qDebug("autosave: <%s>: %s", qPrintable(path), qPrintable(s));
+                  f.close();
+                  f.remove();
+                  continue;
+                  }
+            f.close();
+            QFile::remove(path);
+            if (!f.rename(path))
+                  qDebug("autosave: cannot rename <%s>", qPrintable(f.fileName()));
+            }
+      }
+
 //---------------------------------------------------------
 //   autoSaveTimerTimeout
+//    take a snapshot of every changed score; compression
+//    and writing is done in the background. If the last
+//    autosave is still being written, a new snapshot is
+//    taken when it is finished.
 //---------------------------------------------------------
 
 void MuseScore::autoSaveTimerTimeout()
       {
+      if (autoSaveWatcher.isRunning()) {
+            autoSavePending = true;
+            return;
+            }
+      autoSavePending = false;
       bool sessionChanged = false;
+      QList<QPair<QString, MsczContents> > jobs;
       foreach(Score* s, scoreList) {
-            if (s->autosaveDirty()) {
-                  QString tmp = s->tmpName();
-                  if (!tmp.isEmpty()) {
-                        QFileInfo fi(tmp);
-                        // TODO: cannot catch exeption here:
-                        cs->saveCompressedFile(fi, false);
-                        }
-                  else {
-                        QDir dir;
-                        dir.mkpath(dataPath);
-                        QTemporaryFile tf(dataPath + "/scXXXXXX.mscz");
-                        tf.setAutoRemove(false);
-                        if (!tf.open()) {
-                              qDebug("autoSaveTimerTimeout(): create temporary file failed");
-                              return;
-                              }
-                        s->setTmpName(tf.fileName());
-                        QFileInfo info(tf.fileName());
-                        s->saveCompressedFile(&tf, info, false);
-                        tf.close();
-                        sessionChanged = true;
+            if (!s->autosaveDirty())
+                  continue;
+            QString tmp = s->tmpName();
+            if (tmp.isEmpty()) {
+                  QDir dir;
+                  dir.mkpath(dataPath);
+                  QTemporaryFile tf(dataPath + "/scXXXXXX.mscz");
+                  tf.setAutoRemove(false);
+                  if (!tf.open()) {
+                        qDebug("autoSaveTimerTimeout(): create temporary file failed");
+                        continue;
                         }
-                  s->setAutosaveDirty(false);
+                  tmp = tf.fileName();
+                  tf.close();
+                  s->setTmpName(tmp);
+                  sessionChanged = true;
                   }
+            QFileInfo fi(tmp);
+            jobs.append(qMakePair(tmp, s->msczContents(fi, false)));
+            s->setAutosaveDirty(false);
             }
       if (sessionChanged)
             writeSessionFile(false);
+      if (!jobs.isEmpty())
+            autoSaveWatcher.setFuture(QtConcurrent::run(writeAutoSave, jobs));
       if (preferences.autoSave) {
             int t = preferences.autoSaveTime * 60 * 1000;
             autoSaveTimer->start(t);
             }
       }
 
+//---------------------------------------------------------
+//   autoSaveFinished
+//---------------------------------------------------------
+
+void MuseScore::autoSaveFinished()
+      {
+      if (autoSavePending)
+            autoSaveTimerTimeout();
+      }
+
 //---------------------------------------------------------
 //   restoreSession
 //    Restore last session. If "always" is true, then restore
@@ -4053,7 +4129,7 @@ void MuseScore::cmd(QAction* a, const QString& cmd)
             if (!name.isEmpty()) {
                   if (!cs->saveStyle(name)) {
                         QMessageBox::critical(this,
-                           tr("MuseScore: save style"), MScore::lastError);
+                           tr("MuseScore: save style"), MScore::lastError());
                         }
                   }
             }
@@ -4062,7 +4138,7 @@ void MuseScore::cmd(QAction* a, const QString& cmd)
             if (!name.isEmpty()) {
                   if (!cs->saveStyle(name)) {
                         QMessageBox::critical(this,
-                           tr("MuseScore: save style"), MScore::lastError);
+                           tr("MuseScore: save style"), MScore::lastError());
                         }
                   else {
                         QFileInfo info(name);
@@ -4078,7 +4154,7 @@ void MuseScore::cmd(QAction* a, const QString& cmd)
                   cs->startCmd();
                   if (!cs->loadStyle(name)) {
                         QMessageBox::critical(this,
-                           tr("MuseScore: load style"), MScore::lastError);
+                           tr("MuseScore: load style"), MScore::lastError());
                         }
                   cs->endCmd();
                   endCmd();
@@ -4556,6 +4632,27 @@ int main(int argc, char* av[])
                               usage();
                         pluginName = argv.takeAt(i + 1);
                         break;
+                  case 'b':
+                        synthBenchmarkMode = true;
+                        converterMode = true;
+                        noGui = true;
+                        if (argv.size() - i < 2)
+                              usage();
+                        synthBenchmarkSpec = argv.takeAt(i + 1);
+                        break;
+                  case 'j':
+                        batchMode = true;
+                        converterMode = true;
+                        noGui = true;
+                        if (argv.size() - i < 2)
+                              usage();
+                        batchJobFile = argv.takeAt(i + 1);
+                        break;
+                  case 'P':
+                        if (argv.size() - i < 2)
+                              usage();
+                        QThreadPool::globalInstance()->setMaxThreadCount(qMax(1, argv.takeAt(i + 1).toInt()));
+                        break;
                   case 'r':
                         if (argv.size() - i < 2)
                               usage();
@@ -4570,6 +4667,11 @@ int main(int argc, char* av[])
                         writeWorkspaceFile = true;
                         converterMode = true;
                         break;
+                  case 'T':
+                        if (argv.size() - i < 2)
+                              usage();
+                        Seq::setTelemetryLogInterval(argv.takeAt(i + 1).toInt());
+                        break;
                   case 'F':
                         useFactorySettings = true;
                         break;
@@ -4776,6 +4878,10 @@ int main(int argc, char* av[])
       mscore->setRevision(revision);
 
       int files = 0;
+      if (synthBenchmarkMode)
+            exit(synthBenchmark(synthBenchmarkSpec, argv) ? 0 : -1);
+      if (batchMode)
+            exit(batchConvert(batchJobFile, styleFile) ? 0 : -1);
       if (noGui) {
             loadScores(argv);
             exit(processNonGui() ? 0 : -1);
@@ -293,6 +293,8 @@ class MuseScore : public QMainWindow, public MuseScoreCore {
       void createMenuEntry(PluginDescription*);
 
       QTimer* autoSaveTimer;
+      QFutureWatcher<void> autoSaveWatcher;     // compresses and writes autosave snapshots
+      bool autoSavePending;
       QList<QAction*> qmlPluginActions;
       QList<QAction*> pluginActions;
       QSignalMapper* pluginMapper;
@@ -403,6 +405,7 @@ class MuseScore : public QMainWindow, public MuseScoreCore {
    private slots:
       void cmd(QAction* a, const QString& cmd);
       void autoSaveTimerTimeout();
+      void autoSaveFinished();
       void helpBrowser1() const;
       void about();
       void aboutQt();
@@ -493,6 +496,7 @@ class MuseScore : public QMainWindow, public MuseScoreCore {
       bool loadPlugin(const QString& filename);
       QString createDefaultName() const;
       void startAutoSave();
+      void waitAutoSave() { autoSaveWatcher.waitForFinished(); }
       double getMag(ScoreView*) const;
       void setMag(double);
       bool noScore() const { return scoreList.isEmpty(); }
@@ -596,6 +600,7 @@ class MuseScore : public QMainWindow, public MuseScoreCore {
       bool savePng(Score*, const QString& name);
       bool saveLilypond(Score*, const QString& name);
       bool saveMidi(Score* score, const QString& name);
+      bool convertFile(Score*, const QString& name);
 
       void closeScore(Score* score);
 
@@ -645,6 +650,8 @@ extern MuseScoreCore* mscoreCore;
 extern QString dataPath;
 extern MasterSynthesizer* synti;
 MasterSynthesizer* synthesizerFactory();
+extern bool synthBenchmark(const QString& spec, const QStringList& files);
+extern bool batchConvert(const QString& jobFile, const QString& defaultStyle);
 Driver* driverFactory(Seq*, QString driver);
 
 extern QAction* getAction(const char*);
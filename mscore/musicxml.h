@@ -175,7 +175,7 @@ class MusicXml {
       Tie* tie;
       Volta* lastVolta;
 
-      QDomDocument* doc;
+      QIODevice* device;
       MxmlReaderFirstPass const& pass1;
       int tick;                                 ///< Current position in MuseScore time
       int maxtick;                              ///< Maxtick of a measure, used to calculate measure len
@@ -217,9 +217,9 @@ class MusicXml {
 
       void doCredits();
       void direction(Measure* measure, int staff, QDomElement node);
-      void scorePartwise(QDomElement);
+      void scorePartwise(QXmlStreamReader& r);
       void xmlPartList(QDomElement);
-      void xmlPart(QDomElement, QString id);
+      void xmlPart(QXmlStreamReader& r, QString id);
       void xmlScorePart(QDomElement node, QString id, int& parts);
       Measure* xmlMeasure(Part*, QDomElement, int, int measureLen);
       void xmlAttributes(Measure*, int stave, QDomElement node);
@@ -233,8 +233,8 @@ class MusicXml {
       int xmlClef(QDomElement, int staffIdx, Measure*);
 
 public:
-      MusicXml(QDomDocument* d, MxmlReaderFirstPass const& p1);
-      void import(Score*);
+      MusicXml(QIODevice* d, MxmlReaderFirstPass const& p1);
+      Score::FileError import(Score*);
       };
 
 //---------------------------------------------------------
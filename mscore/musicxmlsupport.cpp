@@ -204,6 +204,19 @@ static QString domElementPath(const QDomElement& e)
       return s;
       }
 
+//---------------------------------------------------------
+//   setDomDocName
+//    file name used by domError() and domNotImplemented();
+//    kept per thread as files are imported concurrently
+//---------------------------------------------------------
+
+static QThreadStorage<QString> domDocName;
+
+void setDomDocName(const QString& name)
+      {
+      domDocName.setLocalData(name);
+      }
+
 //---------------------------------------------------------
 //   domError
 //---------------------------------------------------------
@@ -212,6 +225,7 @@ void domError(const QDomElement& e)
       {
       QString m;
       QString s = domElementPath(e);
+      QString docName = domDocName.localData();
       if (!docName.isEmpty())
             m = QString("<%1>:").arg(docName);
       int ln = e.lineNumber();
@@ -235,6 +249,7 @@ void domNotImplemented(const QDomElement& e)
       if (!MScore::debugMode)
             return;
       QString s = domElementPath(e);
+      QString docName = domDocName.localData();
       if (!docName.isEmpty())
             qDebug("<%s>:", qPrintable(docName));
       qDebug("%s: Node not implemented: <%s>, type %d\n",
@@ -360,5 +375,42 @@ Fraction MxmlSupport::calculateFraction(QString type, int dots, int normalNotes,
             }
       return f;
       }
-}
 
+//---------------------------------------------------------
+//   readElement
+//---------------------------------------------------------
+
+/**
+ Read the element the stream reader \a r is positioned on, including all
+ its children, into a DOM tree owned by \a doc. On return the reader is
+ positioned on the matching end element.
+ As with QDomDocument::setContent(), whitespace-only text and comments
+ are dropped.
+ */
+
+QDomElement MxmlSupport::readElement(QXmlStreamReader& r, QDomDocument& doc)
+      {
+      QDomElement root = doc.createElement(r.qualifiedName().toString());
+      foreach(const QXmlStreamAttribute& a, r.attributes())
+            root.setAttribute(a.qualifiedName().toString(), a.value().toString());
+      QDomElement e = root;
+      while (!r.atEnd()) {
+            r.readNext();
+            if (r.isStartElement()) {
+                  QDomElement ee = doc.createElement(r.qualifiedName().toString());
+                  foreach(const QXmlStreamAttribute& a, r.attributes())
+                        ee.setAttribute(a.qualifiedName().toString(), a.value().toString());
+                  e.appendChild(ee);
+                  e = ee;
+                  }
+            else if (r.isEndElement()) {
+                  if (e == root)
+                        break;
+                  e = e.parentNode().toElement();
+                  }
+            else if (r.isCharacters() && !r.isWhitespace())
+                  e.appendChild(doc.createTextNode(r.text().toString()));
+            }
+      return root;
+      }
+}
@@ -160,6 +160,7 @@ public:
       static Fraction durationAsFraction(const int divisions, const QDomElement e);
       static Fraction noteTypeToFraction(QString type);
       static Fraction calculateFraction(QString type, int dots, int normalNotes, int actualNotes);
+      static QDomElement readElement(QXmlStreamReader& r, QDomDocument& doc);
 };
 
 //---------------------------------------------------------
@@ -182,6 +183,7 @@ private:
       QString errors;
       };
 
+extern void setDomDocName(const QString&);
 extern void domError(const QDomElement&);
 extern void domNotImplemented(const QDomElement&);
 
@@ -19,6 +19,7 @@
 #include "libmscore/mscore.h"
 #include "libmscore/system.h"
 #include "libmscore/measurebase.h"
+#include "libmscore/text.h"
 
 namespace Ms {
 
@@ -99,6 +100,10 @@ Navigator::Navigator(NScrollArea* sa, QWidget* parent)
       scrollArea->setWidgetResizable(true);
       _cv            = 0;
       viewRect       = new ViewRect(this);
+      thumbnailTimer = new QTimer(this);
+      thumbnailTimer->setSingleShot(true);
+      thumbnailTimer->setInterval(0);
+      connect(thumbnailTimer, SIGNAL(timeout()), SLOT(updateThumbnails()));
       setSizePolicy(QSizePolicy::Ignored, QSizePolicy::Ignored);
       sa->setWidget(this);
       sa->setWidgetResizable(false);
@@ -113,6 +118,7 @@ void Navigator::resizeEvent(QResizeEvent* ev)
       if (_score) {
             rescale();
             updateViewRect();
+            thumbnailTimer->start();
             }
       }
 
@@ -127,6 +133,7 @@ void Navigator::setScoreView(ScoreView* v)
             disconnect(_cv, SIGNAL(viewRectChanged()), this, SLOT(updateViewRect()));
             }
       _cv = QPointer<ScoreView>(v);
+      clearThumbnails();
       if (v) {
             _score  = v->score();
             rescale();
@@ -149,6 +156,7 @@ void Navigator::setScore(Score* v)
       {
       _cv    = 0;
       _score = v;
+      clearThumbnails();
       rescale();
       updateViewRect();
       update();
@@ -265,16 +273,157 @@ void Navigator::setViewRect(const QRectF& _viewRect)
       }
 
 //---------------------------------------------------------
-//   paintElement
+//   PageThumbnail
+//    a page to render, possibly in a worker thread
 //---------------------------------------------------------
 
-static void paintElement(void* data, Element* e)
+struct PageThumbnail {
+      int page;
+      uint signature;
+      QRectF bbox;
+      QSize size;
+      qreal mag;
+      int pageNo;             // -1: do not show
+      QVector<const Element*> items;
+      QImage image;
+      };
+
+//---------------------------------------------------------
+//   pageSignature
+//    changes if anything visible at thumbnail scale changes
+//---------------------------------------------------------
+
+static uint pageSignature(int pageNo, const QVector<const Element*>& dl)
       {
-      QPainter* p = static_cast<QPainter*>(data);
-      QPointF pos(e->pagePos());
-      p->translate(pos);
-      e->draw(p);
-      p->translate(-pos);
+      uint h = uint(pageNo) * 31 + uint(dl.size());
+      foreach(const Element* e, dl) {
+            QRectF r(e->bbox().translated(e->pagePos()));
+            h = h * 31 + uint(quintptr(e));
+            h = h * 31 + uint(e->type());
+            h = h * 31 + uint(lrint(r.x() * 8.0));
+            h = h * 31 + uint(lrint(r.y() * 8.0));
+            h = h * 31 + uint(lrint(r.width() * 8.0));
+            h = h * 31 + uint(lrint(r.height() * 8.0));
+            h = h * 31 + e->curColor().rgba();
+            if (e->isText())
+                  h = h * 31 + qHash(static_cast<const Text*>(e)->text());
+            }
+      return h;
+      }
+
+//---------------------------------------------------------
+//   renderThumbnail
+//---------------------------------------------------------
+
+static void renderThumbnail(PageThumbnail& t)
+      {
+      t.image = QImage(t.size, QImage::Format_ARGB32_Premultiplied);
+      t.image.fill(0xffffffff);
+      QPainter p(&t.image);
+      p.scale(t.mag, t.mag);
+      foreach(const Element* e, t.items) {
+            QPointF pos(e->pagePos());
+            p.translate(pos);
+            e->draw(&p);
+            p.translate(-pos);
+            }
+      if (t.pageNo >= 0) {
+            p.setFont(QFont("FreeSans", 400));  // !!
+            p.setPen(QColor(0, 0, 255, 50));
+            p.drawText(t.bbox, Qt::AlignCenter, QString("%1").arg(t.pageNo + 1));
+            }
+      }
+
+//---------------------------------------------------------
+//   clearThumbnails
+//---------------------------------------------------------
+
+void Navigator::clearThumbnails()
+      {
+      thumbnails.clear();
+      thumbnailSignatures.clear();
+      pageSignatures.clear();
+      dirtyPages.clear();
+      }
+
+//---------------------------------------------------------
+//   updateThumbnails
+//    render some of the pages which changed since their
+//    thumbnail was made, visible pages first; pages are
+//    rendered in parallel but the score is not touched
+//    between two calls, which come from the event loop
+//    until all thumbnails are current. Old thumbnails are
+//    kept until their replacement is rendered, scaled if
+//    the navigator scale changed
+//---------------------------------------------------------
+
+void Navigator::updateThumbnails()
+      {
+      if (!_score || !isVisible())
+            return;
+      qreal mag = matrix.m11();
+      const QList<Page*>& pl = _score->pages();
+      thumbnails.resize(pl.size());
+      thumbnailSignatures.resize(pl.size());
+      if (pageSignatures.size() != pl.size()) {
+            // once per layout
+            pageSignatures.resize(pl.size());
+            for (int i = 0; i < pl.size(); ++i)
+                  pageSignatures[i] = pageSignature(pl[i]->no(), pl[i]->displayList());
+            }
+      else {
+            // pages touched by edits without a relayout
+            foreach(int i, dirtyPages) {
+                  if (i < pl.size())
+                        pageSignatures[i] = pageSignature(pl[i]->no(), pl[i]->displayList());
+                  }
+            }
+      dirtyPages.clear();
+
+      bool parallel = QThreadPool::globalInstance()->maxThreadCount() > 1
+         && QFontDatabase::supportsThreadedFontRendering();
+      int batch = parallel ? QThreadPool::globalInstance()->maxThreadCount() : 1;
+      QRect vr(visibleRegion().boundingRect());
+
+      QList<PageThumbnail> jobs;
+      int dirty = 0;
+      for (int i = 0; i < pl.size(); ++i) {
+            Page* page = pl[i];
+            PageThumbnail t;
+            t.page      = i;
+            t.signature = pageSignatures[i];
+            t.bbox      = page->bbox();
+            t.size      = QSize(lrint(page->width() * mag), lrint(page->height() * mag));
+            if (t.size.isEmpty() || (!thumbnails[i].isNull() && thumbnails[i].size() == t.size
+               && thumbnailSignatures[i] == t.signature))
+                  continue;
+            ++dirty;
+            t.items  = page->displayList();
+            t.mag    = mag;
+            t.pageNo = page->score()->layoutMode() == LayoutPage ? page->no() : -1;
+            QRect pr(matrix.mapRect(page->abbox().translated(page->pos())).toRect());
+            if (pr.intersects(vr))
+                  jobs.prepend(t);
+            else if (jobs.size() < batch)
+                  jobs.append(t);
+            }
+      while (jobs.size() > batch)
+            jobs.removeLast();
+
+      if (parallel && jobs.size() > 1)
+            QtConcurrent::blockingMap(jobs, renderThumbnail);
+      else {
+            for (PageThumbnail& t : jobs)
+                  renderThumbnail(t);
+            }
+      for (const PageThumbnail& t : jobs) {
+            thumbnails[t.page]          = QPixmap::fromImage(t.image);
+            thumbnailSignatures[t.page] = t.signature;
+            }
+      if (!jobs.isEmpty())
+            update();
+      if (dirty > jobs.size())
+            thumbnailTimer->start();
       }
 
 //---------------------------------------------------------
@@ -285,9 +434,41 @@ void Navigator::layoutChanged()
       {
       if (_score && !_score->pages().isEmpty())
             rescale();
+      pageSignatures.clear();
+      thumbnailTimer->start();
       update();
       }
 
+//---------------------------------------------------------
+//   dataChanged
+//    the score changed in r (canvas coordinates) without
+//    a relayout; check the pages touching r again
+//---------------------------------------------------------
+
+void Navigator::dataChanged(const QRectF& r)
+      {
+      if (!_score)
+            return;
+      const QList<Page*>& pl = _score->pages();
+      for (int i = 0; i < pl.size(); ++i) {
+            if (pl[i]->abbox().translated(pl[i]->pos()).intersects(r))
+                  dirtyPages.insert(i);
+            }
+      if (!dirtyPages.isEmpty())
+            thumbnailTimer->start();
+      }
+
+//---------------------------------------------------------
+//   updateAll
+//    check all pages again
+//---------------------------------------------------------
+
+void Navigator::updateAll()
+      {
+      pageSignatures.clear();
+      thumbnailTimer->start();
+      }
+
 //---------------------------------------------------------
 //   paintEvent
 //---------------------------------------------------------
@@ -301,30 +482,29 @@ void Navigator::paintEvent(QPaintEvent* ev)
       if (!_score)
             return;
 
-      p.setTransform(matrix);
       QRectF fr = matrix.inverted().mapRect(QRectF(r));
 
-      foreach (Page* page, _score->pages()) {
+      const QList<Page*>& pl = _score->pages();
+      for (int i = 0; i < pl.size(); ++i) {
+            Page* page = pl[i];
             QPointF pos(page->pos());
             QRectF pr(page->abbox().translated(pos));
             if (pr.right() < fr.left())
                   continue;
             if (pr.left() > fr.right())
                   break;
-
-            p.fillRect(pr, Qt::white);
-            p.translate(pos);
-            foreach(System* s, *page->systems()) {
-                  foreach(MeasureBase* m, s->measures())
-                        m->scanElements(&p, paintElement, false);
+            if (i < thumbnails.size() && !thumbnails[i].isNull()) {
+                  const QPixmap& pm = thumbnails[i];
+                  QSize size(lrint(page->width() * matrix.m11()), lrint(page->height() * matrix.m11()));
+                  if (pm.size() == size)
+                        p.drawPixmap(matrix.map(pos).toPoint(), pm);
+                  else  // not yet rendered at the new scale
+                        p.drawPixmap(matrix.mapRect(pr), pm, QRectF(pm.rect()));
                   }
-            page->scanElements(&p, paintElement, false);
-            if (page->score()->layoutMode() == LayoutPage) {
-                  p.setFont(QFont("FreeSans", 400));  // !!
-                  p.setPen(QColor(0, 0, 255, 50));
-                  p.drawText(page->bbox(), Qt::AlignCenter, QString("%1").arg(page->no()+1));
+            else {
+                  p.fillRect(matrix.mapRect(pr), Qt::white);
+                  thumbnailTimer->start();
                   }
-            p.translate(-pos);
             }
       }
 }
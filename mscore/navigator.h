@@ -71,13 +71,23 @@ class Navigator : public QWidget {
       QPoint startMove;
       QTransform matrix;
 
+      QTimer* thumbnailTimer;
+      QVector<QPixmap> thumbnails;        ///< one per page, null if not yet rendered
+      QVector<uint> thumbnailSignatures;  ///< page content the thumbnail shows
+      QVector<uint> pageSignatures;       ///< page content after the last layout
+      QSet<int> dirtyPages;               ///< pages changed by edits since
+
       void rescale();
+      void clearThumbnails();
 
       virtual void paintEvent(QPaintEvent*);
       virtual void mousePressEvent(QMouseEvent*);
       virtual void mouseMoveEvent(QMouseEvent*);
       virtual void resizeEvent(QResizeEvent*);
 
+   private slots:
+      void updateThumbnails();
+
    public slots:
       void updateViewRect();
       void layoutChanged();
@@ -91,6 +101,8 @@ class Navigator : public QWidget {
       void setScore(Score*);
       Score* score() const { return _score; }
       void setViewRect(const QRectF& r);
+      void dataChanged(const QRectF&);
+      void updateAll();
       };
 
 
@@ -0,0 +1,360 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2013 Werner Schweer and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include "pagetiles.h"
+#include "libmscore/score.h"
+#include "libmscore/page.h"
+#include "libmscore/element.h"
+
+namespace Ms {
+
+static const int TILE_CACHE_SIZE = 64 * 1024;     // KB
+
+//---------------------------------------------------------
+//   PageTileCache
+//---------------------------------------------------------
+
+PageTileCache::PageTileCache()
+   : tiles(TILE_CACHE_SIZE)
+      {
+      _score         = 0;
+      _generation    = -1;
+      _antialias     = false;
+      _showInvisible = false;
+      _fgKey         = 0;
+      _magKey        = 0;
+      }
+
+//---------------------------------------------------------
+//   clear
+//---------------------------------------------------------
+
+void PageTileCache::clear()
+      {
+      tiles.clear();
+      }
+
+//---------------------------------------------------------
+//   invalidate
+//    remove all tiles touching r (canvas coordinates)
+//---------------------------------------------------------
+
+void PageTileCache::invalidate(const QRectF& r)
+      {
+      if (!_score || tiles.isEmpty())
+            return;
+      const QList<Page*>& pl = _score->pages();
+      foreach (const TileKey& k, tiles.keys()) {
+            if (k.page >= pl.size()) {
+                  tiles.remove(k);
+                  continue;
+                  }
+            qreal mag = qreal(k.mag) / MAG_SCALE;
+            qreal ts  = TILE_SIZE / mag;
+            qreal d   = 1.0 / mag;          // antialiased edges
+            QRectF tr(pl[k.page]->pos() + QPointF(k.x * ts, k.y * ts), QSizeF(ts, ts));
+            if (tr.adjusted(-d, -d, d, d).intersects(r))
+                  tiles.remove(k);
+            }
+      }
+
+//---------------------------------------------------------
+//   validate
+//    drop all tiles if anything changed which is not
+//    reported by refresh rectangles
+//---------------------------------------------------------
+
+void PageTileCache::validate(Score* score, bool antialias, const QColor& fgColor, const QPixmap* fgPixmap)
+      {
+      qint64 fgKey = (fgPixmap && !fgPixmap->isNull()) ? fgPixmap->cacheKey() : 0;
+      if (score == _score && score->layoutGeneration() == _generation
+         && antialias == _antialias && score->showInvisible() == _showInvisible
+         && fgColor == _fgColor && fgKey == _fgKey)
+            return;
+      tiles.clear();
+      _score         = score;
+      _generation    = score->layoutGeneration();
+      _antialias     = antialias;
+      _showInvisible = score->showInvisible();
+      _fgColor       = fgColor;
+      if (fgKey != _fgKey)
+            _fgImage = fgKey ? fgPixmap->toImage() : QImage();
+      _fgKey         = fgKey;
+      }
+
+//---------------------------------------------------------
+//   renderTile
+//    draw the elements of a tile; runs in a worker thread
+//---------------------------------------------------------
+
+void PageTileCache::renderTile(Tile& t) const
+      {
+      t.image = QImage(t.rect.size(), QImage::Format_ARGB32_Premultiplied);
+      QPainter p(&t.image);
+      p.setRenderHint(QPainter::Antialiasing, _antialias);
+      p.setRenderHint(QPainter::TextAntialiasing, true);
+      if (_fgImage.isNull())
+            p.fillRect(t.image.rect(), _fgColor);
+      else {
+            p.setBrushOrigin(-(t.paperOffset + t.rect.topLeft()));
+            p.fillRect(t.image.rect(), QBrush(_fgImage));
+            p.setBrushOrigin(QPoint());
+            }
+      p.translate(-t.rect.topLeft());
+      p.scale(t.mag, t.mag);
+      foreach (const Element* e, t.items) {
+            if (!e->visible() && !_showInvisible)
+                  continue;
+            QPointF pos(e->pagePos());
+            p.translate(pos);
+            e->draw(&p);
+            p.translate(-pos);
+            }
+      }
+
+//---------------------------------------------------------
+//   drawnConcurrently
+//    text documents and images update caches while they
+//    are drawn, other elements can be drawn into several
+//    tiles at a time
+//---------------------------------------------------------
+
+static bool drawnConcurrently(const Element* e)
+      {
+      return !e->isText() && e->type() != IMAGE;
+      }
+
+//---------------------------------------------------------
+//   tileJobs
+//    every tile is a job of its own, except tiles sharing
+//    an element which cannot be drawn concurrently
+//---------------------------------------------------------
+
+QList<PageTileCache::TileJob> PageTileCache::tileJobs(const QList<Tile>& tl) const
+      {
+      QVector<int> group(tl.size());
+      for (int i = 0; i < tl.size(); ++i)
+            group[i] = i;
+      auto root = [&group](int i) {
+            while (group[i] != i)
+                  i = group[i] = group[group[i]];
+            return i;
+            };
+      QHash<const Element*, int> owner;
+      for (int i = 0; i < tl.size(); ++i) {
+            foreach (const Element* e, tl[i].items) {
+                  if (drawnConcurrently(e))
+                        continue;
+                  QHash<const Element*, int>::const_iterator k = owner.constFind(e);
+                  if (k == owner.constEnd())
+                        owner.insert(e, i);
+                  else
+                        group[root(i)] = root(k.value());
+                  }
+            }
+      QList<TileJob> jobs;
+      QHash<int, int> jobIdx;
+      for (int i = 0; i < tl.size(); ++i) {
+            int r = root(i);
+            if (!jobIdx.contains(r)) {
+                  jobIdx.insert(r, jobs.size());
+                  jobs.append(TileJob());
+                  }
+            jobs[jobIdx[r]].tiles.append(tl[i]);
+            }
+      return jobs;
+      }
+
+//---------------------------------------------------------
+//   previewMag
+//    return the mag key of the cached tiles of page
+//    closest to magKey, 0 if there are none
+//---------------------------------------------------------
+
+int PageTileCache::previewMag(int page, int magKey) const
+      {
+      int best = 0;
+      qreal bestDist = 0.0;
+      foreach (const TileKey& k, tiles.keys()) {
+            if (k.page != page || k.mag == magKey)
+                  continue;
+            qreal dist = qAbs(log(qreal(k.mag) / qreal(magKey)));
+            if (best == 0 || dist < bestDist) {
+                  best     = k.mag;
+                  bestDist = dist;
+                  }
+            }
+      return best;
+      }
+
+//---------------------------------------------------------
+//   drawPreview
+//    draw the tile key at device rect r from the tiles of
+//    its page at mag key pmag, scaled
+//---------------------------------------------------------
+
+void PageTileCache::drawPreview(QPainter& p, const TileKey& key, const QRect& r, const QPoint& pageOrigin, int pmag)
+      {
+      p.save();
+      p.setClipRect(r);
+      qreal s = qreal(key.mag) / qreal(pmag);
+      foreach (const TileKey& k, tiles.keys()) {
+            if (k.page != key.page || k.mag != pmag)
+                  continue;
+            const QPixmap* pm = tiles.object(k);
+            QRectF dr(QPointF(k.x * TILE_SIZE * s, k.y * TILE_SIZE * s) + pageOrigin,
+               QSizeF(pm->width() * s, pm->height() * s));
+            if (dr.intersects(r))
+                  p.drawPixmap(dr, *pm, QRectF(pm->rect()));
+            }
+      p.restore();
+      }
+
+//---------------------------------------------------------
+//   paint
+//    blit the page tiles visible in r (device pixels) and
+//    render missing tiles first. While the mag changes,
+//    missing tiles are drawn from tiles of another mag if
+//    there are any; return true if the view has to be
+//    painted again after ZOOM_SETTLE ms
+//---------------------------------------------------------
+
+bool PageTileCache::paint(QPainter& p, const QRect& r, const QTransform& matrix, Score* score,
+   const QColor& fgColor, const QPixmap* fgPixmap, bool antialias)
+      {
+      validate(score, antialias, fgColor, fgPixmap);
+
+      qreal mag  = matrix.m11();
+      int magKey = lrint(mag * MAG_SCALE);
+      if (magKey != _magKey) {
+            _magKey = magKey;
+            _magChanged.start();
+            }
+      QRectF fr  = matrix.inverted().mapRect(QRectF(r));
+      QPoint canvasOrigin(lrint(matrix.dx()), lrint(matrix.dy()));
+
+      struct VisibleTile {
+            TileKey key;
+            QRect rect;             // device pixels
+            QPoint pageOrigin;
+            };
+      QList<VisibleTile> visible;
+      QList<Tile> missing;
+
+      const QList<Page*>& pl = score->pages();
+      for (int pageIdx = 0; pageIdx < pl.size(); ++pageIdx) {
+            Page* page = pl[pageIdx];
+            QRectF pr(page->abbox().translated(page->pos()));
+            if (pr.right() < fr.left())
+                  continue;
+            if (pr.left() > fr.right())
+                  break;
+            QPoint o(matrix.map(page->pos()).toPoint());
+            QRect pageRect(0, 0, lrint(page->width() * mag), lrint(page->height() * mag));
+            QRect vr = r.translated(-o) & pageRect;
+            if (vr.isEmpty())
+                  continue;
+
+            qreal d = 1.0 / mag;          // antialiased edges
+            for (int ty = vr.top() / TILE_SIZE; ty <= vr.bottom() / TILE_SIZE; ++ty) {
+                  for (int tx = vr.left() / TILE_SIZE; tx <= vr.right() / TILE_SIZE; ++tx) {
+                        TileKey key(pageIdx, magKey, tx, ty);
+                        QRect tr = QRect(tx * TILE_SIZE, ty * TILE_SIZE, TILE_SIZE, TILE_SIZE) & pageRect;
+                        VisibleTile vt;
+                        vt.key        = key;
+                        vt.rect       = tr.translated(o);
+                        vt.pageOrigin = o;
+                        visible.append(vt);
+                        if (tiles.contains(key))
+                              continue;
+                        Tile t(key, tr);
+                        t.mag         = mag;
+                        t.paperOffset = o - canvasOrigin;
+                        QRectF cr(tr.x() / mag - d, tr.y() / mag - d, tr.width() / mag + 2 * d, tr.height() / mag + 2 * d);
+                        t.items = page->items(cr);
+                        qStableSort(t.items.begin(), t.items.end(), elementLessThan);
+                        missing.append(t);
+                        }
+                  }
+            }
+
+      //
+      // while zooming, missing tiles are scaled from tiles
+      // of another mag; they are rendered once the mag did
+      // not change for ZOOM_SETTLE ms
+      //
+      QHash<int, int> previewMags;        // page -> mag key
+      if (!missing.isEmpty() && _magChanged.elapsed() < ZOOM_SETTLE) {
+            foreach (const Tile& t, missing) {
+                  if (!previewMags.contains(t.key.page))
+                        previewMags.insert(t.key.page, previewMag(t.key.page, magKey));
+                  }
+            foreach (int pmag, previewMags) {
+                  if (pmag == 0) {
+                        previewMags.clear();
+                        break;
+                        }
+                  }
+            }
+      bool preview = !previewMags.isEmpty();
+
+      QHash<TileKey, QPixmap> newTiles;
+      if (!preview && !missing.isEmpty()) {
+            QList<TileJob> jobs = tileJobs(missing);
+            if (jobs.size() > 1 && QThreadPool::globalInstance()->maxThreadCount() > 1
+               && QFontDatabase::supportsThreadedFontRendering()) {
+                  QtConcurrent::blockingMap(jobs, [this](TileJob& job) {
+                        for (Tile& t : job.tiles)
+                              renderTile(t);
+                        });
+                  }
+            else {
+                  for (TileJob& job : jobs) {
+                        for (Tile& t : job.tiles)
+                              renderTile(t);
+                        }
+                  }
+            for (const TileJob& job : jobs) {
+                  for (const Tile& t : job.tiles)
+                        newTiles.insert(t.key, QPixmap::fromImage(t.image));
+                  }
+            }
+
+      p.save();
+      p.setWorldTransform(QTransform());
+      if (preview)
+            p.setRenderHint(QPainter::SmoothPixmapTransform, true);
+      for (const VisibleTile& vt : visible) {
+            const QPixmap* pm = tiles.object(vt.key);
+            if (!pm && newTiles.contains(vt.key))
+                  pm = &newTiles[vt.key];
+            if (pm)
+                  p.drawPixmap(vt.rect.topLeft(), *pm);
+            else {
+                  if (fgPixmap && !fgPixmap->isNull())
+                        p.drawTiledPixmap(vt.rect, *fgPixmap, vt.rect.topLeft() - canvasOrigin);
+                  else
+                        p.fillRect(vt.rect, fgColor);
+                  drawPreview(p, vt.key, vt.rect, vt.pageOrigin, previewMags[vt.key.page]);
+                  }
+            }
+      p.restore();
+
+      for (QHash<TileKey, QPixmap>::const_iterator i = newTiles.constBegin(); i != newTiles.constEnd(); ++i) {
+            const QPixmap& pm = i.value();
+            tiles.insert(i.key(), new QPixmap(pm), pm.width() * pm.height() * 4 / 1024);
+            }
+      return preview;
+      }
+
+}
+
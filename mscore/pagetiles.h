@@ -0,0 +1,99 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2013 Werner Schweer and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef __PAGETILES_H__
+#define __PAGETILES_H__
+
+#include "libmscore/page.h"
+
+namespace Ms {
+
+class Score;
+
+//---------------------------------------------------------
+//   TileKey
+//    tile x, y of page at mag (in 1/MAG_SCALE)
+//---------------------------------------------------------
+
+struct TileKey {
+      int page;
+      int mag;
+      int x;
+      int y;
+
+      TileKey() : page(0), mag(0), x(0), y(0) {}
+      TileKey(int p, int m, int tx, int ty) : page(p), mag(m), x(tx), y(ty) {}
+      bool operator==(const TileKey& k) const {
+            return page == k.page && mag == k.mag && x == k.x && y == k.y;
+            }
+      };
+
+inline uint qHash(const TileKey& k)
+      {
+      return ((uint(k.page) * 31 + uint(k.mag)) * 31 + uint(k.x)) * 31 + uint(k.y);
+      }
+
+//---------------------------------------------------------
+//   PageTileCache
+//    score pages rasterized in tiles of TILE_SIZE device
+//    pixels at the current mag; a tile is blitted as long
+//    as no layout or refresh rectangle touches it. While
+//    the mag changes, missing tiles are drawn scaled from
+//    tiles of another mag
+//---------------------------------------------------------
+
+class PageTileCache {
+      struct Tile {
+            TileKey key;
+            QRect rect;                   // device pixels relative to page origin
+            qreal mag;
+            QPoint paperOffset;           // of page origin to fg pixmap origin
+            QList<Element*> items;        // in paint order
+            QImage image;
+            Tile(const TileKey& k, const QRect& r) : key(k), rect(r), mag(1.0) {}
+            };
+      struct TileJob {
+            QList<Tile> tiles;            // tiles sharing elements which cannot be drawn concurrently
+            };
+
+      QCache<TileKey, QPixmap> tiles;
+      Score* _score;
+      int _generation;
+      bool _antialias;
+      bool _showInvisible;
+      QColor _fgColor;
+      qint64 _fgKey;
+      QImage _fgImage;              // fg pixmap, usable outside the gui thread
+      int _magKey;
+      QElapsedTimer _magChanged;
+
+      void validate(Score*, bool antialias, const QColor& fgColor, const QPixmap* fgPixmap);
+      void renderTile(Tile&) const;
+      QList<TileJob> tileJobs(const QList<Tile>&) const;
+      int previewMag(int page, int magKey) const;
+      void drawPreview(QPainter&, const TileKey&, const QRect&, const QPoint& pageOrigin, int previewMag);
+
+   public:
+      static const int TILE_SIZE   = 256;
+      static const int MAG_SCALE   = 10000;
+      static const int ZOOM_SETTLE = 150;      // ms without mag change before new tiles are rendered
+
+      PageTileCache();
+      void clear();
+      void invalidate(const QRectF&);
+      bool paint(QPainter&, const QRect&, const QTransform&, Score*,
+         const QColor& fgColor, const QPixmap* fgPixmap, bool antialias);
+      };
+
+} // namespace Ms
+#endif
+
@@ -498,6 +498,8 @@ PaletteCell* Palette::add(int idx, Element* s, const QString& name, QString tag,
       return cell;
       }
 
+int Palette::_styleGeneration = 0;
+
 //---------------------------------------------------------
 //   paintPaletteElement
 //---------------------------------------------------------
@@ -523,6 +525,11 @@ void Palette::paintEvent(QPaintEvent* event)
 
       QPainter p(this);
       p.setRenderHint(QPainter::Antialiasing, true);
+#if QT_VERSION >= 0x050100
+      qreal dpr = devicePixelRatio();
+#else
+      qreal dpr = 1.0;
+#endif
 
       QColor bgColor(0xf6, 0xf0, 0xda);
 #if 1
@@ -599,13 +606,11 @@ void Palette::paintEvent(QPaintEvent* event)
                   p.drawPixmap(x + (hhgrid - size) / 2, y + (vgrid - size) / 2, pm);
                   }
             else {
+                  PaletteCell* cell = cells[idx];
                   int row    = idx / columns();
                   int column = idx % columns();
 
-                  el->layout();
-                  el->setPos(0.0, 0.0);
-
-                  qreal cellMag = cells[idx]->mag * mag;
+                  qreal cellMag = cell->mag * mag;
                   if (drawStaff) {
                         qreal y = r.y() + vgrid * .5 - dy + _yOffset * _spatium * cellMag;
                         qreal x = r.x() + 3;
@@ -615,13 +620,42 @@ void Palette::paintEvent(QPaintEvent* event)
                               p.drawLine(QLineF(x, yy, x + w, yy));
                               }
                         }
-                  p.save();
-                  p.scale(cellMag, cellMag);
+
+                  QColor color;
+                  if (idx != selectedIdx) {
+                        // show voice colors for notes
+                        if (el->type() == Element::CHORD) {
+                              el->setSelected(true);
+                              color = el->curColor();
+                              }
+                        else
+                              color = palette().color(QPalette::Normal, QPalette::Text);
+                        }
+                  else
+                        color = palette().color(QPalette::Normal, QPalette::HighlightedText);
+
+                  PaletteCellKey key;
+                  key.element         = el;
+                  key.mag             = cellMag;
+                  key.hgrid           = hhgrid;
+                  key.vgrid           = vgrid;
+                  key.xoffset         = cell->xoffset;
+                  key.yoffset         = cell->yoffset;
+                  key.paletteYOffset  = _yOffset;
+                  key.drawStaff       = drawStaff;
+                  key.color           = color.rgba();
+                  key.dpr             = dpr;
+                  key.styleGeneration = _styleGeneration;
+                  bool cached = !cell->pixmap.isNull() && cell->pixmapKey == key;
+                  if (!cached) {
+                        el->layout();
+                        el->setPos(0.0, 0.0);
+                        }
 
                   double gw = hhgrid / cellMag;
                   double gh = vgrid / cellMag;
-                  double gx = column * gw + cells[idx]->xoffset * _spatium;
-                  double gy = row    * gh + cells[idx]->yoffset * _spatium;
+                  double gx = column * gw + cell->xoffset * _spatium;
+                  double gy = row    * gh + cell->yoffset * _spatium;
 
                   double sw = el->width();
                   double sh = el->height();
@@ -635,26 +669,38 @@ void Palette::paintEvent(QPaintEvent* event)
 
                   sy += _yOffset * _spatium;
 
-                  p.translate(sx, sy);
-                  cells[idx]->x = sx;
-                  cells[idx]->y = sy;
-
-                  QColor color;
-                  if (idx != selectedIdx) {
-                        // show voice colors for notes
-                        if (el->type() == Element::CHORD) {
-                              el->setSelected(true);
-                              color = el->curColor();
-                              }
-                        else
-                              color = palette().color(QPalette::Normal, QPalette::Text);
+                  cell->x = sx;
+                  cell->y = sy;
+
+                  if (!cached) {
+                        //
+                        // render the element into a pixmap covering its
+                        // cell and its bounding box, which may reach
+                        // into neighbour cells
+                        //
+                        QRectF br(el->bbox().translated(sx, sy));
+                        br = QRectF(br.x() * cellMag, br.y() * cellMag, br.width() * cellMag, br.height() * cellMag);
+                        QRect pr = (br.toAlignedRect() | r).adjusted(-2, -2, 2, 2);
+
+                        QPixmap pm(pr.size() * dpr);
+                        pm.fill(Qt::transparent);
+#if QT_VERSION >= 0x050100
+                        pm.setDevicePixelRatio(dpr);
+#endif
+                        QPainter pp(&pm);
+                        pp.setRenderHint(QPainter::Antialiasing, true);
+                        pp.translate(-pr.topLeft());
+                        pp.scale(cellMag, cellMag);
+                        pp.translate(sx, sy);
+                        pp.setPen(QPen(color));
+                        el->scanElements(&pp, paintPaletteElement);
+                        pp.end();
+
+                        cell->pixmap    = pm;
+                        cell->pixmapPos = pr.topLeft() - r.topLeft();
+                        cell->pixmapKey = key;
                         }
-                  else
-                        color = palette().color(QPalette::Normal, QPalette::HighlightedText);
-
-                  p.setPen(QPen(color));
-                  el->scanElements(&p, paintPaletteElement);
-                  p.restore();
+                  p.drawPixmap(r.topLeft() + cell->pixmapPos, cell->pixmap);
                   }
             }
       }
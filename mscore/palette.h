@@ -33,6 +33,31 @@ class Xml;
 class XmlReader;
 class Palette;
 
+//---------------------------------------------------------
+//   PaletteCellKey
+//    everything the cached rendering of a cell depends on
+//---------------------------------------------------------
+
+struct PaletteCellKey {
+      const Element* element;
+      qreal mag;
+      int hgrid, vgrid;
+      double xoffset, yoffset;
+      qreal paletteYOffset;
+      bool drawStaff;
+      QRgb color;
+      qreal dpr;              // device pixel ratio
+      int styleGeneration;
+
+      PaletteCellKey() : element(0) {}
+      bool operator==(const PaletteCellKey& k) const {
+            return element == k.element && mag == k.mag && hgrid == k.hgrid && vgrid == k.vgrid
+               && xoffset == k.xoffset && yoffset == k.yoffset && paletteYOffset == k.paletteYOffset
+               && drawStaff == k.drawStaff && color == k.color && dpr == k.dpr
+               && styleGeneration == k.styleGeneration;
+            }
+      };
+
 //---------------------------------------------------------
 //   PaletteCell
 //---------------------------------------------------------
@@ -46,6 +71,10 @@ struct PaletteCell {
       double xoffset, yoffset;      // in spatium units of "gscore"
       qreal mag;
       bool readOnly;
+
+      PaletteCellKey pixmapKey;
+      QPixmap pixmap;               // cached rendering of element
+      QPoint pixmapPos;             // of pixmap relative to cell
       };
 
 //---------------------------------------------------------
@@ -135,6 +164,8 @@ class Palette : public QWidget {
       QRect idxRect(int);
       void layoutCell(PaletteCell*);
 
+      static int _styleGeneration;
+
    private slots:
       void actionToggled(bool val);
 
@@ -193,6 +224,8 @@ class Palette : public QWidget {
 
       virtual int heightForWidth(int) const;
       virtual QSize sizeHint() const;
+
+      static void styleChanged()     { ++_styleGeneration;  }
       };
 
 
@@ -156,6 +156,8 @@ void Preferences::init()
       portMidiInput      = "";
 
       antialiasedDrawing       = true;
+      cachePageTiles           = true;
+      compactSvg               = true;
       sessionStart             = SCORE_SESSION;
       startScore               = ":/data/Promenade_Example.mscz";
       defaultStyleFile         = "";
@@ -285,6 +287,8 @@ void Preferences::write()
 
       s.setValue("layoutBreakColor",   MScore::layoutBreakColor);
       s.setValue("antialiasedDrawing", antialiasedDrawing);
+      s.setValue("cachePageTiles",     cachePageTiles);
+      s.setValue("compactSvg",         compactSvg);
       switch(sessionStart) {
             case EMPTY_SESSION:  s.setValue("sessionStart", "empty"); break;
             case LAST_SESSION:   s.setValue("sessionStart", "last"); break;
@@ -434,6 +438,8 @@ void Preferences::read()
       portMidiInput      = s.value("portMidiInput", portMidiInput).toString();
       MScore::layoutBreakColor   = s.value("layoutBreakColor", MScore::layoutBreakColor).value<QColor>();
       antialiasedDrawing = s.value("antialiasedDrawing", antialiasedDrawing).toBool();
+      cachePageTiles     = s.value("cachePageTiles", cachePageTiles).toBool();
+      compactSvg         = s.value("compactSvg", compactSvg).toBool();
 
       defaultStyleFile         = s.value("defaultStyle", defaultStyleFile).toString();
       MScore::partStyle        = s.value("partStyle", MScore::partStyle).toString();
@@ -1449,8 +1455,10 @@ bool Preferences::readDefaultStyle()
       if (!f.open(QIODevice::ReadOnly))
             return false;
       bool rv = style->load(&f);
-      if (rv)
+      if (rv) {
             MScore::setDefaultStyle(style);     // transfer ownership
+            Palette::styleChanged();
+            }
       f.close();
       return rv;
       }
@@ -113,6 +113,8 @@ struct Preferences {
       QString portMidiInput;
 
       bool antialiasedDrawing;
+      bool cachePageTiles;          ///< blit score pages from cached tiles
+      bool compactSvg;              ///< share symbols and coalesce lines in svg export
       SessionStart sessionStart;
       QString startScore;
       QString defaultStyleFile;
@@ -77,6 +77,7 @@
 #include "libmscore/rehearsalmark.h"
 #include "libmscore/excerpt.h"
 #include "libmscore/stafftype.h"
+#include "pagetiles.h"
 
 #include "navigator.h"
 #include "inspector.h"
@@ -647,6 +648,7 @@ ScoreView::ScoreView(QWidget* parent)
       _fgColor    = Qt::white;
       fgPixmap    = 0;
       bgPixmap    = 0;
+      tileCache   = new PageTileCache;
       lasso       = new Lasso(_score);
       _foto       = new Lasso(_score);
 
@@ -904,6 +906,7 @@ void ScoreView::setScore(Score* s)
             _score->removeViewer(this);
       _score = s;
       _score->addViewer(this);
+      tileCache->clear();
 
       if (shadowNote == 0) {
             shadowNote = new ShadowNote(_score);
@@ -932,6 +935,7 @@ ScoreView::~ScoreView()
       delete _cursor;
       delete bgPixmap;
       delete fgPixmap;
+      delete tileCache;
       delete shadowNote;
       }
 
@@ -1233,7 +1237,11 @@ void ScoreView::setForeground(const QColor& color)
 
 void ScoreView::dataChanged(const QRectF& r)
       {
+      tileCache->invalidate(r);
       update(_matrix.mapRect(r).toRect());  // generate paint event
+      Navigator* nav = mscore->navigator();
+      if (nav && nav->score() == _score)
+            nav->dataChanged(r);
       }
 
 //---------------------------------------------------------
@@ -1242,7 +1250,11 @@ void ScoreView::dataChanged(const QRectF& r)
 
 void ScoreView::updateAll()
       {
+      tileCache->clear();
       update();
+      Navigator* nav = mscore->navigator();
+      if (nav && nav->score() == _score)
+            nav->updateAll();
       }
 
 //---------------------------------------------------------
@@ -1656,6 +1668,23 @@ void ScoreView::paintPageBorder(QPainter& p, Page* page)
             }
       }
 
+//---------------------------------------------------------
+//   useTileCache
+//    tiles hold the page elements only; elements which
+//    are edited, dragged or dropped on are drawn directly
+//---------------------------------------------------------
+
+bool ScoreView::useTileCache() const
+      {
+      return preferences.cachePageTiles
+         && !_score->printing()
+         && !MScore::debugMode
+         && !editObject && !dragElement && !dropTarget
+         && !dropRectangle.isValid()
+         && !sm->configuration().contains(states[DRAG_OBJECT])
+         && !sm->configuration().contains(states[DRAG_EDIT]);
+      }
+
 //---------------------------------------------------------
 //   paint
 //---------------------------------------------------------
@@ -1680,6 +1709,19 @@ void ScoreView::paint(const QRect& r, QPainter& p)
             qStableSort(ell.begin(), ell.end(), elementLessThan);
             drawElements(p, ell);
             }
+      else if (useTileCache()) {
+            if (tileCache->paint(p, r, _matrix, _score, _fgColor, fgPixmap, preferences.antialiasedDrawing))
+                  QTimer::singleShot(PageTileCache::ZOOM_SETTLE, this, SLOT(update()));
+            foreach (Page* page, _score->pages()) {
+                  paintPageBorder(p, page);
+                  QRectF pr(page->abbox().translated(page->pos()));
+                  if (pr.right() < fr.left())
+                        continue;
+                  if (pr.left() > fr.right())
+                        break;
+                  r1 -= _matrix.mapRect(pr).toAlignedRect();
+                  }
+            }
       else {
             foreach (Page* page, _score->pages()) {
                   if (!score()->printing())
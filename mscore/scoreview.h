@@ -46,6 +46,7 @@ class Text;
 class MeasureBase;
 class Staff;
 class OmrView;
+class PageTileCache;
 
 enum {
       TEXT_TITLE,
@@ -190,8 +191,11 @@ class ScoreView : public QWidget, public MuseScoreView {
       QPixmap* bgPixmap;
       QPixmap* fgPixmap;
 
+      PageTileCache* tileCache;
+
       virtual void paintEvent(QPaintEvent*);
       void paint(const QRect&, QPainter&);
+      bool useTileCache() const;
 
       void objectPopup(const QPoint&, Element*);
       void measurePopup(const QPoint&, Measure*);
@@ -23,6 +23,7 @@
 #include "musescore.h"
 
 #include "synthesizer/msynthesizer.h"
+#include "synthesizer/synthesizer.h"
 #include "libmscore/slur.h"
 #include "libmscore/score.h"
 #include "libmscore/segment.h"
@@ -68,6 +69,8 @@ struct VorbisData {
 
 static VorbisData vorbisData;
 
+int Seq::telemetryLogInterval = 0;
+
 static size_t ovRead(void* ptr, size_t size, size_t nmemb, void* datasource);
 static int ovSeek(void* datasource, ogg_int64_t offset, int whence);
 static long ovTell(void* datasource);
@@ -153,6 +156,7 @@ Seq::Seq()
       meterPeakValue[1] = 0.0;
       peakTimer[0]       = 0;
       peakTimer[1]       = 0;
+      smoothedLoad       = 0.0;
 
       heartBeatTimer = new QTimer(this);
       connect(heartBeatTimer, SIGNAL(timeout()), this, SLOT(heartBeatTimeout()));
@@ -233,6 +237,10 @@ bool Seq::init()
             return false;
             }
       running = true;
+      // the heartbeat also writes the telemetry log, which must
+      // not depend on a score view being opened
+      if (telemetryLogInterval && !heartBeatTimer->isActive())
+            heartBeatTimer->start(20);    // msec
       return true;
       }
 
@@ -245,6 +253,8 @@ void Seq::exit()
       if (_driver) {
             if (MScore::debugMode)
                   qDebug("Stop I/O\n");
+            if (telemetryLogInterval)
+                  qDebug("Seq telemetry: %s", qPrintable(_telemetry.toString(_synti).replace('\n', "; ")));
             stopWait();
             delete _driver;
             _driver = 0;
@@ -559,6 +569,8 @@ void Seq::metronome(unsigned n, float* p)
 
 void Seq::process(unsigned n, float* buffer)
       {
+      QElapsedTimer callbackTimer;
+      callbackTimer.start();
       unsigned frames = n;
       int driverState = _driver->getState();
 
@@ -695,6 +707,94 @@ void Seq::process(unsigned n, float* buffer)
             meterPeakValue[1] = rv;
             peakTimer[1] = 0;
             }
+      updateTelemetry(n, callbackTimer.nsecsElapsed());
+      }
+
+//---------------------------------------------------------
+//   updateTelemetry
+//    realtime; must not lock or allocate
+//---------------------------------------------------------
+
+void Seq::updateTelemetry(unsigned frames, qint64 nsecs)
+      {
+      const double period = double(frames) / MScore::sampleRate * 1e9;
+      const float load    = period > 0.0 ? nsecs / period : 0.0;
+
+      int bin = int(load * 10);
+      if (bin >= SeqTelemetry::HISTOGRAM_BINS - 1) {
+            bin = SeqTelemetry::HISTOGRAM_BINS - 1;
+            ++_telemetry.xruns;
+            }
+      ++_telemetry.histogram[bin];
+      ++_telemetry.callbacks;
+
+      smoothedLoad += (load - smoothedLoad) * 0.05f;
+      _telemetry.load = int(smoothedLoad * 1000);
+      if (int(load * 1000) > _telemetry.peakLoad)
+            _telemetry.peakLoad = int(load * 1000);
+
+      int idx = 0;
+      for (Synthesizer* s : _synti->synthesizer()) {
+            if (idx >= SeqTelemetry::MAX_SYNTHESIZERS)
+                  break;
+            _telemetry.activeVoices[idx] = s->activeVoiceCount();
+            _telemetry.stolenVoices[idx] = s->stolenVoiceCount();
+            ++idx;
+            }
+
+      int depth = toSeq.count();
+      _telemetry.queueDepth = depth;
+      if (depth > _telemetry.peakQueueDepth)
+            _telemetry.peakQueueDepth = depth;
+      }
+
+//---------------------------------------------------------
+//   SeqTelemetry::reset
+//    called from the gui thread; a concurrent update from
+//    the audio thread may survive, which is harmless
+//---------------------------------------------------------
+
+void SeqTelemetry::reset()
+      {
+      callbacks = 0;
+      for (int i = 0; i < HISTOGRAM_BINS; ++i)
+            histogram[i] = 0;
+      load           = 0;
+      peakLoad       = 0;
+      xruns          = 0;
+      for (int i = 0; i < MAX_SYNTHESIZERS; ++i) {
+            activeVoices[i] = 0;
+            stolenVoices[i] = 0;
+            }
+      queueDepth     = 0;
+      peakQueueDepth = 0;
+      }
+
+//---------------------------------------------------------
+//   SeqTelemetry::toString
+//---------------------------------------------------------
+
+QString SeqTelemetry::toString(const MasterSynthesizer* ms) const
+      {
+      QString s = QString("load %1% (peak %2%) xruns %3 callbacks %4 queue %5 (peak %6)")
+         .arg(load / 10.0, 0, 'f', 1)
+         .arg(peakLoad / 10.0, 0, 'f', 1)
+         .arg(xruns.load())
+         .arg(callbacks.load())
+         .arg(queueDepth.load())
+         .arg(peakQueueDepth.load());
+      int idx = 0;
+      for (Synthesizer* synth : ms->synthesizer()) {
+            if (idx >= MAX_SYNTHESIZERS)
+                  break;
+            s += QString("\n%1: voices %2 stolen %3")
+               .arg(synth->name()).arg(activeVoices[idx].load()).arg(stolenVoices[idx].load());
+            ++idx;
+            }
+      s += "\nhistogram:";
+      for (int i = 0; i < HISTOGRAM_BINS; ++i)
+            s += QString(" %1").arg(histogram[i].load());
+      return s;
       }
 
 //---------------------------------------------------------
@@ -1104,6 +1204,16 @@ void Seq::heartBeatTimeout()
             if (++peakTimer[1] >= peakHold)
                   meterPeakValue[1] *= .7f;
             sc->setMeter(meterValue[0], meterValue[1], meterPeakValue[0], meterPeakValue[1]);
+            if (sc->isVisible())
+                  sc->setTelemetry(_telemetry);
+            }
+      if (telemetryLogInterval && _driver) {
+            if (!telemetryLogTimer.isValid())
+                  telemetryLogTimer.start();
+            else if (telemetryLogTimer.elapsed() >= telemetryLogInterval * 1000) {
+                  qDebug("Seq telemetry: %s", qPrintable(_telemetry.toString(_synti).replace('\n', "; ")));
+                  telemetryLogTimer.restart();
+                  }
             }
 
       while (!fromSeq.isEmpty()) {
@@ -81,6 +81,32 @@ class SeqMsgFifo : public FifoBase {
       SeqMsg dequeue();                   // remove object from fifo
       };
 
+//---------------------------------------------------------
+//   SeqTelemetry
+//    written by the audio thread at the end of every
+//    Seq::process() call, read by the gui heartbeat;
+//    all values are single atomics so no lock is needed
+//---------------------------------------------------------
+
+struct SeqTelemetry {
+      static const int HISTOGRAM_BINS = 11;     // 10% steps of the buffer period, last bin: deadline missed
+      static const int MAX_SYNTHESIZERS = 4;
+
+      std::atomic<unsigned> callbacks;
+      std::atomic<unsigned> histogram[HISTOGRAM_BINS];
+      std::atomic<int> load;                    // smoothed DSP load in 1/10 %
+      std::atomic<int> peakLoad;                // 1/10 %
+      std::atomic<unsigned> xruns;              // callbacks which took longer than the buffer period
+      std::atomic<int> activeVoices[MAX_SYNTHESIZERS];
+      std::atomic<int> stolenVoices[MAX_SYNTHESIZERS];
+      std::atomic<int> queueDepth;              // pending gui -> sequencer messages
+      std::atomic<int> peakQueueDepth;
+
+      SeqTelemetry() { reset(); }
+      void reset();
+      QString toString(const MasterSynthesizer*) const;
+      };
+
 //---------------------------------------------------------
 //   Seq
 //    sequencer
@@ -124,6 +150,11 @@ class Seq : public QObject, public Sequencer {
       QTimer* heartBeatTimer;
       QTimer* noteTimer;
 
+      SeqTelemetry _telemetry;
+      float smoothedLoad;                 // audio thread only
+      static int telemetryLogInterval;    // seconds, 0 = no log
+      QElapsedTimer telemetryLogTimer;
+
       void collectMeasureEvents(Measure*, int staffIdx);
 
       void setPos(int);
@@ -133,6 +164,7 @@ class Seq : public QObject, public Sequencer {
       void seek(int utick, Segment* seg);
       void unmarkNotes();
       void updateSynthesizerState(int tick1, int tick2);
+      void updateTelemetry(unsigned frames, qint64 nsecs);
 
    private slots:
       void seqMessage(int msg);
@@ -200,6 +232,10 @@ class Seq : public QObject, public Sequencer {
       int getCurTick();
       double curTempo() const;
 
+      const SeqTelemetry& telemetry() const            { return _telemetry; }
+      void resetTelemetry()                            { _telemetry.reset(); }
+      static void setTelemetryLogInterval(int sec)     { telemetryLogInterval = sec; }
+
       void putEvent(const NPlayEvent&);
       void startNoteTimer(int duration);
       void startNote(int channel, int, int, double nt);
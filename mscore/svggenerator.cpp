@@ -118,6 +118,40 @@ static void translate_color(const QColor &color, QString *color_string,
     *opacity_string = QString::number(color.alphaF());
 }
 
+static void writePathData(QTextStream& stream, const QPainterPath& p)
+{
+    for (int i=0; i<p.elementCount(); ++i) {
+        const QPainterPath::Element &e = p.elementAt(i);
+        switch (e.type) {
+        case QPainterPath::MoveToElement:
+            stream << 'M' << e.x << ',' << e.y;
+            break;
+        case QPainterPath::LineToElement:
+            stream << 'L' << e.x << ',' << e.y;
+            break;
+        case QPainterPath::CurveToElement:
+            stream << 'C' << e.x << ',' << e.y;
+            ++i;
+            while (i < p.elementCount()) {
+                const QPainterPath::Element &e = p.elementAt(i);
+                if (e.type != QPainterPath::CurveToDataElement) {
+                    --i;
+                    break;
+                } else
+                    stream << ' ';
+                stream << e.x << ',' << e.y;
+                ++i;
+            }
+            break;
+        default:
+            break;
+        }
+        if (i != p.elementCount() - 1) {
+            stream << ' ';
+        }
+    }
+}
+
 static void translate_dashPattern(QVector<qreal> pattern, const qreal& width, QString *pattern_string)
 {
     Q_ASSERT(pattern_string);
@@ -147,7 +181,11 @@ public:
         attributes.font_weight = QLatin1String("normal");
 
         afterFirstUpdate = false;
+        fragment = false;
+        compact = false;
+        dirtyState = false;
         numGradients = 0;
+        stateOpacity = 1.0;
     }
 
     QSize size;
@@ -160,15 +198,33 @@ public:
     QString defs;
     QString body;
     bool    afterFirstUpdate;
+    bool    fragment;
+    bool    compact;
+    QString idPrefix;
 
     QBrush brush;
     QPen pen;
     QMatrix matrix;
     QFont font;
 
+    // painter state, written with the next drawing
+    bool    dirtyState;
+    QBrush  stateBrush;
+    QPen    statePen;
+    QMatrix stateMatrix;
+    QFont   stateFont;
+    qreal   stateOpacity;
+
+    // compact mode
+    QHash<QString, QString> symbols;    // font key and text -> path id in defs
+    QString lineKey;                    // pen and transform of the pending lines
+    QPen    linePen;                    // pen of the pending lines
+    QMatrix lineMatrix;                 // transform of the pending lines, without translation
+    QString lines;                      // path data of the pending lines
+
     QString generateGradientName() {
         ++numGradients;
-        currentGradientName = QString::fromLatin1("gradient%1").arg(numGradients);
+        currentGradientName = QString::fromLatin1("%1gradient%2").arg(idPrefix).arg(numGradients);
         return currentGradientName;
     }
 
@@ -213,11 +269,15 @@ public:
     bool end();
 
     void updateState(const QPaintEngineState &state);
+    void writeState();
+    void flushLines();
     void popGroup();
 
     void drawPath(const QPainterPath &path);
     void drawPixmap(const QRectF &r, const QPixmap &pm, const QRectF &sr);
     void drawPolygon(const QPointF *points, int pointCount, PolygonDrawMode mode);
+    void drawLines(const QLineF *lines, int lineCount);
+    void drawTextItem(const QPointF &p, const QTextItem &textItem);
     void drawImage(const QRectF &r, const QImage &pm, const QRectF &sr,
                    Qt::ImageConversionFlag = Qt::AutoColor);
 
@@ -256,6 +316,27 @@ public:
         Q_ASSERT(!isActive());
         d_func()->resolution = resolution;
     }
+
+    bool fragment() const { return d_func()->fragment; }
+    void setFragment(bool fragment) {
+        Q_ASSERT(!isActive());
+        d_func()->fragment = fragment;
+    }
+    void appendFragment(const QString& svg) {
+        Q_ASSERT(isActive());
+        *d_func()->stream << svg;
+    }
+
+    bool compact() const { return d_func()->compact; }
+    void setCompact(bool compact) {
+        Q_ASSERT(!isActive());
+        d_func()->compact = compact;
+    }
+    QString idPrefix() const { return d_func()->idPrefix; }
+    void setIdPrefix(const QString& prefix) {
+        Q_ASSERT(!isActive());
+        d_func()->idPrefix = prefix;
+    }
     void saveLinearGradientBrush(const QGradient *g)
     {
         QTextStream str(&d_func()->defs, QIODevice::Append);
@@ -808,6 +889,87 @@ void SvgGenerator::setResolution(int dpi)
     d->engine->setResolution(dpi);
 }
 
+/*!
+    \property SvgGenerator::fragment
+    \brief write only the drawing, without xml header and \c<svg> element
+
+    Fragments are used to render pages concurrently; the results
+    are merged into one document with appendFragment().
+*/
+bool SvgGenerator::fragment() const
+{
+    Q_D(const SvgGenerator);
+    return d->engine->fragment();
+}
+
+void SvgGenerator::setFragment(bool fragment)
+{
+    Q_D(SvgGenerator);
+    if (d->engine->isActive()) {
+        qWarning("SvgGenerator::setFragment(), cannot set fragment mode while SVG is being generated");
+        return;
+    }
+    d->engine->setFragment(fragment);
+}
+
+/*!
+    Appends \a svg, the output of a generator in fragment mode,
+    to the drawing. Must be called while painting is active.
+*/
+void SvgGenerator::appendFragment(const QString& svg)
+{
+    Q_D(SvgGenerator);
+    d->engine->appendFragment(svg);
+}
+
+/*!
+    \property SvgGenerator::compact
+    \brief share repeated text and coalesce lines
+
+    In compact mode every distinct text item, e.g. a musical
+    symbol, is written once as a path in \c<defs> and drawn with
+    \c<use>. Consecutive solid lines drawn with the same pen and
+    scale, e.g. staff lines, bar lines and stems, are written as
+    one path.
+*/
+bool SvgGenerator::compact() const
+{
+    Q_D(const SvgGenerator);
+    return d->engine->compact();
+}
+
+void SvgGenerator::setCompact(bool compact)
+{
+    Q_D(SvgGenerator);
+    if (d->engine->isActive()) {
+        qWarning("SvgGenerator::setCompact(), cannot set compact mode while SVG is being generated");
+        return;
+    }
+    d->engine->setCompact(compact);
+}
+
+/*!
+    \property SvgGenerator::idPrefix
+    \brief prefix of the ids of the definitions written
+
+    Fragments merged into one document need different prefixes.
+*/
+QString SvgGenerator::idPrefix() const
+{
+    Q_D(const SvgGenerator);
+    return d->engine->idPrefix();
+}
+
+void SvgGenerator::setIdPrefix(const QString& prefix)
+{
+    Q_D(SvgGenerator);
+    if (d->engine->isActive()) {
+        qWarning("SvgGenerator::setIdPrefix(), cannot set id prefix while SVG is being generated");
+        return;
+    }
+    d->engine->setIdPrefix(prefix);
+}
+
 /*!
     Returns the paint engine used to render graphics to be converted to SVG
     format information.
@@ -920,6 +1082,7 @@ bool SvgPaintEngine::end()
 {
     Q_D(SvgPaintEngine);
 
+    flushLines();
     d->stream->setString(&d->defs);
     *d->stream << "</defs>\n";
 
@@ -928,16 +1091,20 @@ bool SvgPaintEngine::end()
     d->stream->setCodec(QTextCodec::codecForName("UTF-8"));
 #endif
 
-    *d->stream << d->header;
-    *d->stream << d->defs;
+    if (!d->fragment)
+        *d->stream << d->header;
+    if (!d->fragment || d->numGradients || !d->symbols.isEmpty())
+        *d->stream << d->defs;
     *d->stream << d->body;
     if (d->afterFirstUpdate)
         *d->stream << "</g>" << endl; // close the updateState
 
-    *d->stream << "</g>" << endl // close the Qt defaults
-               << "</svg>" << endl;
+    *d->stream << "</g>" << endl; // close the Qt defaults
+    if (!d->fragment)
+        *d->stream << "</svg>" << endl;
 
     delete d->stream;
+    d->symbols.clear();
 
     return true;
 }
@@ -954,6 +1121,7 @@ void SvgPaintEngine::drawImage(const QRectF &r, const QImage &image,
 {
     //Q_D(SvgPaintEngine);
 
+    writeState();
     Q_UNUSED(sr);
     Q_UNUSED(flags);
     stream() << "<image ";
@@ -976,10 +1144,28 @@ void SvgPaintEngine::drawImage(const QRectF &r, const QImage &image,
 void SvgPaintEngine::updateState(const QPaintEngineState &state)
 {
     Q_D(SvgPaintEngine);
-    QPaintEngine::DirtyFlags flags = state.state();
 
     // always stream full gstate, which is not required, but...
-    flags |= QPaintEngine::AllDirty;
+    d->stateBrush   = state.brush();
+    d->statePen     = state.pen();
+    d->stateMatrix  = state.matrix();
+    d->stateFont    = state.font();
+    d->stateOpacity = state.opacity();
+    d->dirtyState   = true;
+
+    // in compact mode the state is written with the next drawing
+    // which is not a coalesced line
+    if (!d->compact)
+        writeState();
+}
+
+void SvgPaintEngine::writeState()
+{
+    Q_D(SvgPaintEngine);
+
+    flushLines();
+    if (!d->dirtyState)
+        return;
 
     // close old state and start a new one...
     if (d->afterFirstUpdate)
@@ -987,79 +1173,66 @@ void SvgPaintEngine::updateState(const QPaintEngineState &state)
 
     *d->stream << "<g ";
 
-    if (flags & QPaintEngine::DirtyBrush) {
-        qbrushToSvg(state.brush());
-    }
+    qbrushToSvg(d->stateBrush);
+    qpenToSvg(d->statePen);
 
-    if (flags & QPaintEngine::DirtyPen) {
-        qpenToSvg(state.pen());
-    }
+    d->matrix = d->stateMatrix;
+    *d->stream << "transform=\"matrix(" << d->matrix.m11() << ','
+               << d->matrix.m12() << ','
+               << d->matrix.m21() << ',' << d->matrix.m22() << ','
+               << d->matrix.dx() << ',' << d->matrix.dy()
+               << ")\""
+               << endl;
 
-    if (flags & QPaintEngine::DirtyTransform) {
-        d->matrix = state.matrix();
-        *d->stream << "transform=\"matrix(" << d->matrix.m11() << ','
-                   << d->matrix.m12() << ','
-                   << d->matrix.m21() << ',' << d->matrix.m22() << ','
-                   << d->matrix.dx() << ',' << d->matrix.dy()
-                   << ")\""
-                   << endl;
-    }
+    qfontToSvg(d->stateFont);
 
-    if (flags & QPaintEngine::DirtyFont) {
-        qfontToSvg(state.font());
-    }
-
-    if (flags & QPaintEngine::DirtyOpacity) {
-        if (!qFuzzyIsNull(state.opacity() - 1))
-            stream() << "opacity=\""<<state.opacity()<<"\" ";
-    }
+    if (!qFuzzyIsNull(d->stateOpacity - 1))
+        stream() << "opacity=\""<<d->stateOpacity<<"\" ";
 
     *d->stream << '>' << endl;
 
     d->afterFirstUpdate = true;
+    d->dirtyState = false;
+}
+
+/*!
+    Writes the pending coalesced lines as one path in a group of
+    their own. The state of the next drawing has to be written
+    again.
+*/
+void SvgPaintEngine::flushLines()
+{
+    Q_D(SvgPaintEngine);
+
+    if (d->lines.isEmpty())
+        return;
+
+    if (d->afterFirstUpdate)
+        *d->stream << "</g>\n\n";
+    *d->stream << "<g fill=\"none\" ";
+    qpenToSvg(d->linePen);
+    const QMatrix& m = d->lineMatrix;
+    *d->stream << "transform=\"matrix(" << m.m11() << ',' << m.m12() << ','
+               << m.m21() << ',' << m.m22() << ",0,0)\">" << endl;
+    *d->stream << "<path d=\"" << d->lines << "\"/>" << endl;
+
+    d->lines.clear();
+    d->lineKey.clear();
+    d->afterFirstUpdate = true;
+    d->dirtyState = true;
 }
 
 void SvgPaintEngine::drawPath(const QPainterPath &p)
 {
     Q_D(SvgPaintEngine);
 
+    writeState();
     *d->stream << "<path vector-effect=\""
                << (state->pen().isCosmetic() ? "non-scaling-stroke" : "none")
                << "\" fill-rule=\""
                << (p.fillRule() == Qt::OddEvenFill ? "evenodd" : "nonzero")
                << "\" d=\"";
-
-    for (int i=0; i<p.elementCount(); ++i) {
-        const QPainterPath::Element &e = p.elementAt(i);
-        switch (e.type) {
-        case QPainterPath::MoveToElement:
-            *d->stream << 'M' << e.x << ',' << e.y;
-            break;
-        case QPainterPath::LineToElement:
-            *d->stream << 'L' << e.x << ',' << e.y;
-            break;
-        case QPainterPath::CurveToElement:
-            *d->stream << 'C' << e.x << ',' << e.y;
-            ++i;
-            while (i < p.elementCount()) {
-                const QPainterPath::Element &e = p.elementAt(i);
-                if (e.type != QPainterPath::CurveToDataElement) {
-                    --i;
-                    break;
-                } else
-                    *d->stream << ' ';
-                *d->stream << e.x << ',' << e.y;
-                ++i;
-            }
-            break;
-        default:
-            break;
-        }
-        if (i != p.elementCount() - 1) {
-            *d->stream << ' ';
-        }
-    }
-
+    writePathData(*d->stream, p);
     *d->stream << "\"/>" << endl;
 }
 
@@ -1075,6 +1248,7 @@ void SvgPaintEngine::drawPolygon(const QPointF *points, int pointCount,
         path.lineTo(points[i]);
 
     if (mode == PolylineMode) {
+        writeState();
         stream() << "<polyline fill=\"none\" vector-effect=\""
                  << (state->pen().isCosmetic() ? "non-scaling-stroke" : "none")
                  << "\" points=\"";
@@ -1088,3 +1262,87 @@ void SvgPaintEngine::drawPolygon(const QPointF *points, int pointCount,
         drawPath(path);
     }
 }
+
+/*!
+    In compact mode consecutive lines drawn with the same solid
+    pen and scale are collected into one path, which is written
+    with the next state change or drawing of another kind.
+*/
+void SvgPaintEngine::drawLines(const QLineF *lines, int lineCount)
+{
+    Q_D(SvgPaintEngine);
+
+    const QPen& pen = d->statePen;
+    if (!d->compact || pen.style() != Qt::SolidLine || pen.brush().style() != Qt::SolidPattern
+       || pen.isCosmetic() || pen.widthF() <= 0.0 || !qFuzzyIsNull(d->stateOpacity - 1)) {
+        writeState();
+        QPaintEngine::drawLines(lines, lineCount);
+        return;
+    }
+
+    const QMatrix& m = d->stateMatrix;
+    QMatrix linear(m.m11(), m.m12(), m.m21(), m.m22(), 0.0, 0.0);
+    bool invertible;
+    QMatrix toGroup = m * linear.inverted(&invertible);
+    if (!invertible)
+        return;
+
+    QString key = QString::fromLatin1("%1 %2 %3 %4 %5 %6 %7 %8")
+       .arg(pen.color().rgba()).arg(pen.widthF()).arg(int(pen.capStyle())).arg(int(pen.joinStyle()))
+       .arg(m.m11()).arg(m.m12()).arg(m.m21()).arg(m.m22());
+    if (key != d->lineKey) {
+        flushLines();
+        d->lineKey    = key;
+        d->linePen    = pen;
+        d->lineMatrix = linear;
+    }
+
+    QTextStream str(&d->lines, QIODevice::Append);
+    for (int i = 0; i < lineCount; ++i) {
+        QPointF p1 = toGroup.map(lines[i].p1());
+        QPointF p2 = toGroup.map(lines[i].p2());
+        if (!d->lines.isEmpty())
+            str << ' ';
+        str << 'M' << p1.x() << ',' << p1.y() << 'L' << p2.x() << ',' << p2.y();
+        str.flush();
+    }
+}
+
+/*!
+    In compact mode the outline of every distinct text item is
+    written once to the definitions and drawn with <use>.
+*/
+void SvgPaintEngine::drawTextItem(const QPointF &p, const QTextItem &textItem)
+{
+    Q_D(SvgPaintEngine);
+
+    const QFont font = textItem.font();
+    const QPen& pen  = d->statePen;
+    if (!d->compact || font.pixelSize() <= 0 || pen.style() == Qt::NoPen
+       || pen.brush().style() != Qt::SolidPattern) {
+        writeState();
+        QPaintEngine::drawTextItem(p, textItem);
+        return;
+    }
+
+    writeState();
+    QString key = font.key() + QChar(0) + textItem.text();
+    QString id  = d->symbols.value(key);
+    if (id.isEmpty()) {
+        id = QString::fromLatin1("%1sym%2").arg(d->idPrefix).arg(d->symbols.size() + 1);
+        d->symbols.insert(key, id);
+        QPainterPath path;
+        path.setFillRule(Qt::WindingFill);
+        path.addText(QPointF(), font, textItem.text());
+        QTextStream str(&d->defs, QIODevice::Append);
+        str << "<path id=\"" << id << "\" d=\"";
+        writePathData(str, path);
+        str << "\"/>" << endl;
+    }
+
+    QString color, colorOpacity;
+    translate_color(pen.color(), &color, &colorOpacity);
+    *d->stream << "<use xlink:href=\"#" << id << "\" x=\"" << p.x() << "\" y=\"" << p.y()
+               << "\" fill=\"" << color << "\" fill-opacity=\"" << colorOpacity
+               << "\" stroke=\"none\"/>" << endl;
+}
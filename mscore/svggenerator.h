@@ -62,6 +62,8 @@ class SvgGenerator : public QPaintDevice
     Q_PROPERTY(QString fileName READ fileName WRITE setFileName)
     Q_PROPERTY(QIODevice* outputDevice READ outputDevice WRITE setOutputDevice)
     Q_PROPERTY(int resolution READ resolution WRITE setResolution)
+    Q_PROPERTY(bool compact READ compact WRITE setCompact)
+    Q_PROPERTY(QString idPrefix READ idPrefix WRITE setIdPrefix)
 public:
     SvgGenerator();
     ~SvgGenerator();
@@ -88,6 +90,15 @@ public:
 
     void setResolution(int dpi);
     int resolution() const;
+
+    void setFragment(bool fragment);
+    bool fragment() const;
+    void appendFragment(const QString& svg);
+
+    void setCompact(bool compact);
+    bool compact() const;
+    void setIdPrefix(const QString& prefix);
+    QString idPrefix() const;
 protected:
     QPaintEngine *paintEngine() const;
     int metric(QPaintDevice::PaintDeviceMetric metric) const;
@@ -0,0 +1,280 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2013 Werner Schweer and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+//---------------------------------------------------------
+//    offline synthesizer benchmark
+//
+//    mscore -b synth[:soundfont] [file.mid]
+//
+//    renders a midi file (or a synthetic polyphony stress
+//    pattern if no file is given) through the master
+//    synthesizer as fast as possible and writes the
+//    result as JSON to stdout
+//---------------------------------------------------------
+
+#include "musescore.h"
+#include "libmscore/mscore.h"
+#include "synthesizer/msynthesizer.h"
+#include "synthesizer/synthesizer.h"
+#include "synthesizer/event.h"
+#include "effects/effect.h"
+#include "midi/midifile.h"
+
+namespace Ms {
+
+static const int BENCH_SAMPLERATE = 44100;
+static const int BENCH_FRAMES     = 512;
+static const int STRESS_SECONDS   = 20;
+
+//---------------------------------------------------------
+//   BenchEvent
+//    event at an absolute frame position
+//---------------------------------------------------------
+
+struct BenchEvent {
+      int frame;
+      PlayEvent event;
+      };
+
+//---------------------------------------------------------
+//   stressPattern
+//    16 channels, a new note every 10ms on every channel,
+//    held for two seconds: keeps a few thousand voices
+//    requested at once so that voice stealing kicks in
+//---------------------------------------------------------
+
+static std::vector<BenchEvent> stressPattern()
+      {
+      std::vector<BenchEvent> el;
+      for (int ch = 0; ch < 16; ++ch) {
+            PlayEvent e(ME_CONTROLLER, ch, CTRL_PROGRAM, (ch * 8) % 128);
+            el.push_back({ 0, e });
+            }
+      const int step = BENCH_SAMPLERATE / 100;
+      const int len  = BENCH_SAMPLERATE * 2;
+      const int end  = BENCH_SAMPLERATE * (STRESS_SECONDS - 2);
+      int n = 0;
+      for (int frame = step; frame < end; frame += step, ++n) {
+            for (int ch = 0; ch < 16; ++ch) {
+                  int pitch = 36 + (n * 7 + ch * 5) % 60;
+                  el.push_back({ frame,       PlayEvent(ME_NOTEON, ch, pitch, 100) });
+                  el.push_back({ frame + len, PlayEvent(ME_NOTEON, ch, pitch, 0)   });
+                  }
+            }
+      std::stable_sort(el.begin(), el.end(), [](const BenchEvent& a, const BenchEvent& b) {
+            return a.frame < b.frame;
+            });
+      return el;
+      }
+
+//---------------------------------------------------------
+//   midiFileEvents
+//    merge all tracks and convert ticks to frames using
+//    the tempo map of the file
+//---------------------------------------------------------
+
+static bool midiFileEvents(const QString& path, std::vector<BenchEvent>* el)
+      {
+      QFile fp(path);
+      if (!fp.open(QIODevice::ReadOnly)) {
+            qDebug("synthBenchmark: cannot open <%s>", qPrintable(path));
+            return false;
+            }
+      MidiFile mf;
+      try {
+            mf.read(&fp);
+            }
+      catch(QString errorText) {
+            qDebug("synthBenchmark: <%s>: %s", qPrintable(path), qPrintable(errorText));
+            return false;
+            }
+      std::multimap<int, MidiEvent> events;
+      for (const MidiTrack* t : mf.tracks())
+            events.insert(t->events().begin(), t->events().end());
+
+      double tempo     = 0.5;          // seconds per quarter note
+      double frameTime = 0.0;
+      int lastTick     = 0;
+      for (const auto& i : events) {
+            int tick = i.first;
+            frameTime += (tick - lastTick) * tempo / mf.division() * BENCH_SAMPLERATE;
+            lastTick = tick;
+            const MidiEvent& me = i.second;
+            int frame = int(frameTime);
+            switch (me.type()) {
+                  case ME_META:
+                        if (me.metaType() == META_TEMPO && me.len() >= 3) {
+                              const uchar* d = me.edata();
+                              tempo = ((d[0] << 16) | (d[1] << 8) | d[2]) / 1000000.0;
+                              }
+                        break;
+                  case ME_NOTEON:
+                        el->push_back({ frame, PlayEvent(ME_NOTEON, me.channel(), me.pitch(), me.velo()) });
+                        break;
+                  case ME_NOTEOFF:
+                        el->push_back({ frame, PlayEvent(ME_NOTEON, me.channel(), me.pitch(), 0) });
+                        break;
+                  case ME_PROGRAM:
+                        el->push_back({ frame, PlayEvent(ME_CONTROLLER, me.channel(), CTRL_PROGRAM, me.dataA()) });
+                        break;
+                  case ME_CONTROLLER:
+                        el->push_back({ frame, PlayEvent(ME_CONTROLLER, me.channel(), me.dataA(), me.dataB()) });
+                        break;
+                  default:
+                        break;
+                  }
+            }
+      return true;
+      }
+
+//---------------------------------------------------------
+//   jsonString
+//---------------------------------------------------------
+
+static QString jsonString(const QString& s)
+      {
+      QString r("\"");
+      for (const QChar& c : s) {
+            if (c == '"' || c == '\\')
+                  r += '\\';
+            r += c;
+            }
+      return r + "\"";
+      }
+
+//---------------------------------------------------------
+//   synthBenchmark
+//    spec is "fluid:file.sf2", "zerberus:file.sfz" or "aeolus"
+//---------------------------------------------------------
+
+bool synthBenchmark(const QString& spec, const QStringList& files)
+      {
+      QString synthName = spec.section(':', 0, 0).toLower();
+      QString soundFont = spec.section(':', 1);
+
+      MScore::sampleRate    = BENCH_SAMPLERATE;
+      MasterSynthesizer* ms = synthesizerFactory();
+      ms->setSampleRate(BENCH_SAMPLERATE);
+      ms->init();
+
+      int synthIdx = -1;
+      int idx = 0;
+      for (Synthesizer* s : ms->synthesizer()) {
+            if (QString(s->name()).toLower() == synthName)
+                  synthIdx = idx;
+            ++idx;
+            }
+      if (synthIdx == -1) {
+            qDebug("synthBenchmark: unknown synthesizer <%s>", qPrintable(synthName));
+            delete ms;
+            return false;
+            }
+      Synthesizer* synth = ms->synthesizer()[synthIdx];
+      if (!soundFont.isEmpty() && !synth->loadSoundFonts(QStringList(soundFont))) {
+            qDebug("synthBenchmark: cannot load <%s>", qPrintable(soundFont));
+            delete ms;
+            return false;
+            }
+
+      std::vector<BenchEvent> events;
+      QString source("stress");
+      if (files.isEmpty())
+            events = stressPattern();
+      else {
+            source = files[0];
+            if (!midiFileEvents(source, &events)) {
+                  delete ms;
+                  return false;
+                  }
+            }
+      int totalFrames = events.empty() ? 0 : events.back().frame + BENCH_SAMPLERATE * 2;
+      if (files.isEmpty())
+            totalFrames = BENCH_SAMPLERATE * STRESS_SECONDS;
+
+      // sounds generated in the background (aeolus ranks) must
+      // be in place before timing starts
+      float buffer[BENCH_FRAMES * 2];
+      synth->waitReady();
+      memset(buffer, 0, sizeof(buffer));
+      ms->process(BENCH_FRAMES, buffer);
+
+      ms->setProfiling(true);
+      float peakLevel = 0.0;
+      int peakVoices = 0;
+      auto ie        = events.cbegin();
+      QElapsedTimer timer;
+      timer.start();
+      for (int frame = 0; frame < totalFrames; frame += BENCH_FRAMES) {
+            memset(buffer, 0, sizeof(buffer));
+            int endFrame = frame + BENCH_FRAMES;
+            int pos = frame;
+            float* p = buffer;
+            for (; ie != events.cend() && ie->frame < endFrame; ++ie) {
+                  int n = qMax(ie->frame, pos) - pos;
+                  if (n) {
+                        ms->process(n, p);
+                        p   += n * 2;
+                        pos += n;
+                        }
+                  ms->play(NPlayEvent(ie->event), synthIdx);
+                  }
+            if (pos < endFrame)
+                  ms->process(endFrame - pos, p);
+            peakVoices = qMax(peakVoices, synth->activeVoiceCount());
+            for (int i = 0; i < BENCH_FRAMES * 2; ++i)
+                  peakLevel = qMax(peakLevel, qAbs(buffer[i]));
+            }
+      qint64 elapsed = timer.nsecsElapsed();
+
+      double audioTime = double(totalFrames) / BENCH_SAMPLERATE;
+      double cpuTime   = elapsed / 1e9;
+
+      QTextStream out(stdout);
+      out << "{\n";
+      out << "  \"synthesizer\": " << jsonString(synth->name()) << ",\n";
+      out << "  \"soundfont\": " << jsonString(soundFont) << ",\n";
+      out << "  \"source\": " << jsonString(source) << ",\n";
+      out << "  \"sampleRate\": " << BENCH_SAMPLERATE << ",\n";
+      out << "  \"audioSeconds\": " << audioTime << ",\n";
+      out << "  \"processSeconds\": " << cpuTime << ",\n";
+      out << "  \"realtimeFactor\": " << (cpuTime > 0.0 ? audioTime / cpuTime : 0.0) << ",\n";
+      out << "  \"events\": " << int(events.size()) << ",\n";
+      out << "  \"peakVoices\": " << peakVoices << ",\n";
+      out << "  \"peakLevel\": " << peakLevel << ",\n";
+      out << "  \"stolenVoices\": " << synth->stolenVoiceCount() << ",\n";
+      out << "  \"synthesizerSeconds\": {";
+      idx = 0;
+      for (Synthesizer* s : ms->synthesizer()) {
+            out << (idx ? ", " : " ") << jsonString(s->name()) << ": " << ms->synthesizerTime(idx) / 1e9;
+            ++idx;
+            }
+      out << " },\n";
+      out << "  \"effectSeconds\": {";
+      for (int ab = 0; ab < MasterSynthesizer::MAX_EFFECTS; ++ab) {
+            Effect* e = ms->effect(ab);
+            out << (ab ? ", " : " ") << jsonString(QString("%1:%2").arg(ab).arg(e ? e->name() : "NoEffect"))
+                << ": " << ms->effectTime(ab) / 1e9;
+            }
+      out << " }\n";
+      out << "}\n";
+      out.flush();
+
+      delete ms;
+      if (peakLevel == 0.0 && !events.empty()) {
+            qDebug("synthBenchmark: output is silent");
+            return false;
+            }
+      return true;
+      }
+
+}
+
@@ -95,6 +95,7 @@ SynthControl::SynthControl(QWidget* parent)
       connect(storeButton,  SIGNAL(clicked()),                SLOT(storeButtonClicked()));
       connect(recallButton, SIGNAL(clicked()),                SLOT(recallButtonClicked()));
       connect(gain,         SIGNAL(valueChanged(double,int)), SLOT(setDirty()));
+      connect(resetTelemetryButton, SIGNAL(clicked()),        SLOT(resetTelemetry()));
       }
 
 //---------------------------------------------------------
@@ -174,6 +175,27 @@ void SynthControl::setMeter(float l, float r, float left_peak, float right_peak)
       gain->setMeterVal(1, r, right_peak);
       }
 
+//---------------------------------------------------------
+//   setTelemetry
+//    called from the sequencer heartbeat
+//---------------------------------------------------------
+
+void SynthControl::setTelemetry(const SeqTelemetry& t)
+      {
+      if (tabWidget->currentWidget() == performanceTab)
+            telemetryLabel->setText(t.toString(synti));
+      }
+
+//---------------------------------------------------------
+//   resetTelemetry
+//---------------------------------------------------------
+
+void SynthControl::resetTelemetry()
+      {
+      if (seq)
+            seq->resetTelemetry();
+      }
+
 //---------------------------------------------------------
 //   stop
 //---------------------------------------------------------
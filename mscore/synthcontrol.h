@@ -26,6 +26,7 @@
 namespace Ms {
 
 class Score;
+struct SeqTelemetry;
 
 //---------------------------------------------------------
 //   SynthControl
@@ -50,6 +51,7 @@ class SynthControl : public QWidget, Ui::SynthControl {
       void storeButtonClicked();
       void recallButtonClicked();
       void setDirty();
+      void resetTelemetry();
 
    signals:
       void gainChanged(float);
@@ -62,6 +64,7 @@ class SynthControl : public QWidget, Ui::SynthControl {
    public:
       SynthControl(QWidget* parent);
       void setMeter(float, float, float, float);
+      void setTelemetry(const SeqTelemetry&);
       void stop();
       void setScore(Score* s) { _score = s; }
       };
@@ -254,9 +254,7 @@ void Workspace::write()
       xml.stag("rootfiles");
       xml.stag(QString("rootfile full-path=\"%1\"").arg(Xml::xmlString("workspace.xml")));
       xml.etag();
-      foreach (ImageStoreItem* ip, imageStore) {
-            if (!ip->isUsed(gscore))
-                  continue;
+      foreach(ImageStoreItem* ip, imageStore.usedItems(gscore)) {
             QString dstPath = QString("Pictures/") + ip->hashName();
             xml.tag("file", dstPath);
             }
@@ -268,9 +266,7 @@ void Workspace::write()
       f.addFile("META-INF/container.xml", cbuf.data());
 
       // save images
-      foreach(ImageStoreItem* ip, imageStore) {
-            if (!ip->isUsed(gscore))
-                  continue;
+      foreach(ImageStoreItem* ip, imageStore.usedItems(gscore)) {
             QString dstPath = QString("Pictures/") + ip->hashName();
             f.addFile(dstPath, ip->buffer());
             }
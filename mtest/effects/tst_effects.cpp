@@ -0,0 +1,204 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//  $Id:$
+//
+//  Copyright (C) 2014 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+#include "effects/zita1/zita.h"
+#include "aeolus/asection.h"
+
+using namespace Ms;
+
+static const int SAMPLERATE = 44100;
+static const int FRAMES     = SAMPLERATE * 4;
+
+//---------------------------------------------------------
+//   TestEffects
+//---------------------------------------------------------
+
+class TestEffects : public QObject
+      {
+      Q_OBJECT
+
+      QVector<float> input;
+
+      double nsPerFrame(bool reference, int period);
+
+   private slots:
+      void initTestCase();
+      void zitaReference_data();
+      void zitaReference();
+      void zitaBenchmark();
+      void diffuserReference();
+      void asectionReference();
+      };
+
+//---------------------------------------------------------
+//   initTestCase
+//    a few seconds of noise bursts, so that the reverb
+//    tail is exercised too
+//---------------------------------------------------------
+
+void TestEffects::initTestCase()
+      {
+      input.resize(FRAMES * 2);
+      qsrand(1);
+      for (int i = 0; i < FRAMES * 2; ++i) {
+            bool burst = ((i / 2) % SAMPLERATE) < SAMPLERATE / 10;
+            input[i]   = burst ? (qrand() / float(RAND_MAX) - 0.5f) : 0.0f;
+            }
+      }
+
+//---------------------------------------------------------
+//   zitaReference
+//    the block implementation must match the sample
+//    by sample reference implementation
+//---------------------------------------------------------
+
+void TestEffects::zitaReference_data()
+      {
+      QTest::addColumn<int>("period");
+      QTest::newRow("1")    << 1;
+      QTest::newRow("63")   << 63;
+      QTest::newRow("256")  << 256;
+      QTest::newRow("1000") << 1000;
+      }
+
+void TestEffects::zitaReference()
+      {
+      QFETCH(int, period);
+
+      ZitaReverb block;
+      ZitaReverb reference;
+      block.init(SAMPLERATE);
+      reference.init(SAMPLERATE);
+      block.setNValue(0, 0.08);     // longest pre delay
+      reference.setNValue(0, 0.08);
+
+      QVector<float> in(input);
+      QVector<float> out1(FRAMES * 2);
+      QVector<float> out2(FRAMES * 2);
+      for (int i = 0; i < FRAMES; i += period) {
+            int n = qMin(period, FRAMES - i);
+            block.process(n, in.data() + i * 2, out1.data() + i * 2);
+            reference.processReference(n, in.data() + i * 2, out2.data() + i * 2);
+            }
+      float maxDiff = 0.0;
+      for (int i = 0; i < FRAMES * 2; ++i)
+            maxDiff = qMax(maxDiff, qAbs(out1[i] - out2[i]));
+      QVERIFY(maxDiff < 1e-6);
+      }
+
+//---------------------------------------------------------
+//   nsPerFrame
+//---------------------------------------------------------
+
+double TestEffects::nsPerFrame(bool reference, int period)
+      {
+      ZitaReverb reverb;
+      reverb.init(SAMPLERATE);
+      QVector<float> in(input);
+      QVector<float> out(FRAMES * 2);
+
+      QElapsedTimer timer;
+      timer.start();
+      for (int i = 0; i + period <= FRAMES; i += period) {
+            if (reference)
+                  reverb.processReference(period, in.data() + i * 2, out.data() + i * 2);
+            else
+                  reverb.process(period, in.data() + i * 2, out.data() + i * 2);
+            }
+      return double(timer.nsecsElapsed()) / FRAMES;
+      }
+
+//---------------------------------------------------------
+//   zitaBenchmark
+//---------------------------------------------------------
+
+void TestEffects::zitaBenchmark()
+      {
+      for (int period : { 64, 512 }) {
+            double ref   = 1e9;
+            double block = 1e9;
+            for (int i = 0; i < 5; ++i) {       // best of five
+                  ref   = qMin(ref, nsPerFrame(true, period));
+                  block = qMin(block, nsPerFrame(false, period));
+                  }
+            qDebug("Zita1 period %4d: reference %6.1f ns/frame, block %6.1f ns/frame", period, ref, block);
+            }
+      }
+
+//---------------------------------------------------------
+//   diffuserReference
+//    the block diffuser must match the sample by sample
+//    diffuser, also across the wrap of its delay line
+//---------------------------------------------------------
+
+void TestEffects::diffuserReference()
+      {
+      Diffuser block;
+      Diffuser reference;
+      block.init(571, 0.5f);
+      reference.init(571, 0.5f);
+
+      QVector<float> out(input);
+      float maxDiff = 0.0;
+      for (int i = 0; i < FRAMES; i += PERIOD) {
+            block.process(PERIOD, out.data() + i);
+            for (int k = 0; k < PERIOD; ++k)
+                  maxDiff = qMax(maxDiff, qAbs(out[i + k] - reference.process(input[i + k])));
+            }
+      block.fini();
+      reference.fini();
+      QVERIFY(maxDiff < 1e-6);
+      }
+
+//---------------------------------------------------------
+//   asectionReference
+//    Asection::process() with block diffusers must match
+//    the sample by sample reference implementation
+//---------------------------------------------------------
+
+void TestEffects::asectionReference()
+      {
+      Asection block(SAMPLERATE);
+      Asection reference(SAMPLERATE);
+      block.set_size(0.075f);
+      reference.set_size(0.075f);
+
+      float maxDiff = 0.0;
+      for (int i = 0; i + PERIOD <= FRAMES; i += PERIOD) {
+            // fill the four channels as Division::process() does
+            float* q1 = block.get_wptr();
+            float* q2 = reference.get_wptr();
+            for (int c = 0; c < NCHANN; ++c) {
+                  for (int k = 0; k < PERIOD; ++k) {
+                        float v = input[(i + k) * 2 + (c & 1)] * (c < 2 ? 1.0f : 0.5f);
+                        q1[c * PERIOD * MIXLEN + k] += v;
+                        q2[c * PERIOD * MIXLEN + k] += v;
+                        }
+                  }
+            float out1[4][PERIOD];
+            float out2[4][PERIOD];
+            memset(out1, 0, sizeof(out1));
+            memset(out2, 0, sizeof(out2));
+            block.process(1.0f, out1[0], out1[1], out1[2], out1[3]);
+            reference.processReference(1.0f, out2[0], out2[1], out2[2], out2[3]);
+            for (int c = 0; c < 4; ++c) {
+                  for (int k = 0; k < PERIOD; ++k)
+                        maxDiff = qMax(maxDiff, qAbs(out1[c][k] - out2[c][k]));
+                  }
+            }
+      QVERIFY(maxDiff < 1e-6);
+      }
+
+QTEST_MAIN(TestEffects)
+#include "tst_effects.moc"
@@ -63,17 +63,26 @@ void TestImportMidi::initTestCase()
 
 //---------------------------------------------------------
 //   midifile
+//    tracks are prepared concurrently unless the thread
+//    pool is limited to one thread; both must give the
+//    reference score
 //---------------------------------------------------------
 
 void TestImportMidi::mf(const char* name)
       {
-      Score* score = new Score(mscore->baseStyle());
-      score->setName(name);
       QString midiname = QString(name) + ".mid";
       QString mscorename = QString(name) + ".mscx";
-      QCOMPARE(importMidi(score,  TESTROOT "/mtest/" + DIR + midiname), Score::FILE_NO_ERROR);
-      QVERIFY(saveCompareScore(score, mscorename, DIR + mscorename));
-      delete score;
+      int threads = QThreadPool::globalInstance()->maxThreadCount();
+      foreach (int n, QList<int>() << 1 << qMax(threads, 4)) {
+            QThreadPool::globalInstance()->setMaxThreadCount(n);
+            Score* score = new Score(mscore->baseStyle());
+            score->setName(name);
+            QCOMPARE(importMidi(score,  TESTROOT "/mtest/" + DIR + midiname), Score::FILE_NO_ERROR);
+            bool ok = saveCompareScore(score, mscorename, DIR + mscorename);
+            delete score;
+            QThreadPool::globalInstance()->setMaxThreadCount(threads);
+            QVERIFY(ok);
+            }
       }
 
 QTEST_MAIN(TestImportMidi)
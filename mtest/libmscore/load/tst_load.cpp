@@ -0,0 +1,148 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//  $Id:$
+//
+//  Copyright (C) 2013 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+#include "mtest/testutils.h"
+#include "libmscore/score.h"
+#include "libmscore/measure.h"
+#include "libmscore/segment.h"
+#include "libmscore/chord.h"
+#include "libmscore/xml.h"
+
+using namespace Ms;
+
+static const int MEASURES = 2000;
+static const int GROUPS   = 4;        // beamed groups of four 16th per measure
+
+//---------------------------------------------------------
+//   writeBeamMeasure
+//    every chord is beamed and every beam group is slurred
+//---------------------------------------------------------
+
+static void writeBeamMeasure(QTextStream& s, int m)
+      {
+      for (int g = 0; g < GROUPS; ++g) {
+            int id = m * GROUPS + g + 1;
+            s << "        <Beam id=\"" << id << "\">\n"
+                 "          </Beam>\n"
+                 "        <Slur id=\"" << id << "\">\n"
+                 "          </Slur>\n";
+            for (int n = 0; n < 4; ++n) {
+                  int pitch = 60 + (m + g + n) % 12;
+                  s << "        <Chord>\n"
+                       "          <durationType>16th</durationType>\n"
+                       "          <Beam>" << id << "</Beam>\n";
+                  if (n == 0)
+                        s << "          <Slur type=\"start\" number=\"" << id << "\"/>\n";
+                  else if (n == 3)
+                        s << "          <Slur type=\"stop\" number=\"" << id << "\"/>\n";
+                  s << "          <Note>\n"
+                       "            <pitch>" << pitch << "</pitch>\n"
+                       "            </Note>\n"
+                       "          </Chord>\n";
+                  }
+            }
+      }
+
+//---------------------------------------------------------
+//   TestLoad
+//---------------------------------------------------------
+
+class TestLoad : public QObject, public MTest
+      {
+      Q_OBJECT
+
+      QString beamScore;
+
+   private slots:
+      void initTestCase();
+      void tagTokens();
+      void loadBeams();
+      void benchmarkBeams();
+      };
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestLoad::initTestCase()
+      {
+      initMTest();
+      beamScore = QDir::current().absoluteFilePath("load-beams.mscx");
+      QVERIFY(writeGeneratedScore(beamScore, MEASURES, writeBeamMeasure));
+      }
+
+//---------------------------------------------------------
+//   tagTokens
+//    every name in XML_TAGS must map back to its token
+//---------------------------------------------------------
+
+void TestLoad::tagTokens()
+      {
+      QString s;
+#define CHECK_TAG(a)      s = #a; QVERIFY(xmlTag(QStringRef(&s)) == XmlTag::a);
+#define CHECK_TAG_N(a, b) s = b;  QVERIFY(xmlTag(QStringRef(&s)) == XmlTag::a##_);
+      XML_TAGS(CHECK_TAG, CHECK_TAG_N)
+#undef CHECK_TAG
+#undef CHECK_TAG_N
+      s = "Notes";
+      QVERIFY(xmlTag(QStringRef(&s)) == XmlTag::UNKNOWN);
+      s = "note";
+      QVERIFY(xmlTag(QStringRef(&s)) == XmlTag::UNKNOWN);
+      s = "";
+      QVERIFY(xmlTag(QStringRef(&s)) == XmlTag::UNKNOWN);
+      }
+
+//---------------------------------------------------------
+//   loadBeams
+//    all beam and slur references must be resolved
+//---------------------------------------------------------
+
+void TestLoad::loadBeams()
+      {
+      Score* score = readCreatedScore(beamScore);
+      QVERIFY(score);
+      int chords = 0;
+      int beamed = 0;
+      int slurs  = 0;
+      for (Segment* s = score->firstSegment(Segment::SegChordRest); s; s = s->next1(Segment::SegChordRest)) {
+            ChordRest* cr = static_cast<ChordRest*>(s->element(0));
+            if (!cr || cr->type() != Element::CHORD)
+                  continue;
+            ++chords;
+            if (cr->beam())
+                  ++beamed;
+            if (cr->spannerFor())
+                  ++slurs;
+            }
+      QCOMPARE(chords, MEASURES * GROUPS * 4);
+      QCOMPARE(beamed, chords);
+      QCOMPARE(slurs, MEASURES * GROUPS);
+      delete score;
+      }
+
+//---------------------------------------------------------
+//   benchmarkBeams
+//---------------------------------------------------------
+
+void TestLoad::benchmarkBeams()
+      {
+      QBENCHMARK {
+            Score* score = readCreatedScore(beamScore);
+            delete score;
+            }
+      }
+
+QTEST_MAIN(TestLoad)
+#include "tst_load.moc"
+
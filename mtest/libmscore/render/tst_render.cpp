@@ -0,0 +1,316 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//  $Id:$
+//
+//  Copyright (C) 2013 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+#include "mtest/testutils.h"
+#include "libmscore/score.h"
+#include "libmscore/page.h"
+#include "libmscore/element.h"
+#include "libmscore/sym.h"
+
+using namespace Ms;
+
+static const int PAGES = 200;       // one measure per page
+static const double DPI = 72.0;
+
+//---------------------------------------------------------
+//   writePageMeasure
+//    every measure ends with a page break
+//---------------------------------------------------------
+
+static void writePageMeasure(QTextStream& s, int m)
+      {
+      s << "        <LayoutBreak>\n"
+           "          <subtype>page</subtype>\n"
+           "          </LayoutBreak>\n";
+      for (int n = 0; n < 16; ++n) {
+            int pitch = 60 + (m + n) % 12;
+            s << "        <Chord>\n"
+                 "          <durationType>16th</durationType>\n"
+                 "          <Note>\n"
+                 "            <pitch>" << pitch << "</pitch>\n"
+                 "            </Note>\n"
+                 "          </Chord>\n";
+            }
+      }
+
+//---------------------------------------------------------
+//   TestRender
+//---------------------------------------------------------
+
+class TestRender : public QObject, public MTest
+      {
+      Q_OBJECT
+
+      Score* score;
+      QImage renderPage(int pageNumber);
+      QList<QImage> renderSerial();
+      QList<QImage> renderParallel();
+
+   private slots:
+      void initTestCase();
+      void cleanupTestCase();
+      void pageCount();
+      void displayList();
+      void displayListFollowsEdits();
+      void parallelMatchesSerial();
+      void glyphCacheMatchesText();
+      void benchmarkSerial();
+      void benchmarkSerialText();
+      void benchmarkParallel();
+      };
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestRender::initTestCase()
+      {
+      initMTest();
+      QString path = QDir::current().absoluteFilePath("render-pages.mscx");
+      QVERIFY(writeGeneratedScore(path, PAGES, writePageMeasure));
+      score = readCreatedScore(path);
+      QVERIFY(score);
+      score->doLayout();
+      }
+
+//---------------------------------------------------------
+//   cleanupTestCase
+//---------------------------------------------------------
+
+void TestRender::cleanupTestCase()
+      {
+      delete score;
+      }
+
+//---------------------------------------------------------
+//   renderPage
+//    same drawing as the png export
+//---------------------------------------------------------
+
+QImage TestRender::renderPage(int pageNumber)
+      {
+      Page* page = score->pages().at(pageNumber);
+      QRectF r   = page->abbox();
+      double mag = DPI / MScore::DPI;
+      QImage image(lrint(r.width() * mag), lrint(r.height() * mag), QImage::Format_ARGB32_Premultiplied);
+      image.fill(0xffffffff);
+      QPainter p(&image);
+      p.setRenderHint(QPainter::Antialiasing, true);
+      p.setRenderHint(QPainter::TextAntialiasing, true);
+      p.scale(mag, mag);
+      foreach(const Element* e, score->printElements(pageNumber)) {
+            if (!e->visible())
+                  continue;
+            QPointF pos(e->pagePos());
+            p.translate(pos);
+            e->draw(&p);
+            p.translate(-pos);
+            }
+      return image;
+      }
+
+//---------------------------------------------------------
+//   renderSerial
+//---------------------------------------------------------
+
+QList<QImage> TestRender::renderSerial()
+      {
+      QList<QImage> images;
+      for (int i = 0; i < score->pages().size(); ++i)
+            images.append(renderPage(i));
+      return images;
+      }
+
+//---------------------------------------------------------
+//   renderParallel
+//---------------------------------------------------------
+
+QList<QImage> TestRender::renderParallel()
+      {
+      QList<int> pl;
+      for (int i = 0; i < score->pages().size(); ++i)
+            pl.append(i);
+      QVector<QImage> images(pl.size());
+      QtConcurrent::blockingMap(pl, [this, &images](int& pageNumber) {
+            images[pageNumber] = renderPage(pageNumber);
+            });
+      return images.toList();
+      }
+
+//---------------------------------------------------------
+//   pageCount
+//---------------------------------------------------------
+
+void TestRender::pageCount()
+      {
+      QCOMPARE(score->pages().size(), PAGES);
+      }
+
+//---------------------------------------------------------
+//   displayList
+//    all elements of a page in paint order; rebuilt after
+//    layout
+//---------------------------------------------------------
+
+void TestRender::displayList()
+      {
+      foreach (Page* page, score->pages()) {
+            const QVector<const Element*>& dl = page->displayList();
+            QCOMPARE(dl.size(), page->elements().size());
+            for (int i = 1; i < dl.size(); ++i)
+                  QVERIFY(!elementLessThan(dl[i], dl[i - 1]));
+            }
+      score->doLayout();
+      Page* page = score->pages().front();
+      QCOMPARE(page->displayList().size(), page->elements().size());
+      }
+
+//---------------------------------------------------------
+//   displayListFollowsEdits
+//    an element moved by an edit without a relayout is
+//    painted at its new position
+//---------------------------------------------------------
+
+void TestRender::displayListFollowsEdits()
+      {
+      Page* page = score->pages().front();
+      Element* note = 0;
+      foreach (const Element* e, page->displayList()) {
+            if (e->type() == NOTE) {
+                  note = const_cast<Element*>(e);
+                  break;
+                  }
+            }
+      QVERIFY(note);
+      QRectF r   = page->abbox();
+      double mag = DPI / MScore::DPI;
+      QImage image(lrint(r.width() * mag), lrint(r.height() * mag), QImage::Format_ARGB32_Premultiplied);
+      QList<QImage> images;
+      for (int i = 0; i < 3; ++i) {
+            note->setUserOff(QPointF(0.0, i == 1 ? note->spatium() * 4.0 : 0.0));
+            image.fill(0xffffffff);
+            QPainter p(&image);
+            p.scale(mag, mag);
+            score->print(&p, 0);
+            p.end();
+            images.append(image.copy());
+            }
+      QVERIFY(images[1] != images[0]);
+      QVERIFY(images[2] == images[0]);
+      }
+
+//---------------------------------------------------------
+//   parallelMatchesSerial
+//    concurrent rendering must give the same pixels
+//---------------------------------------------------------
+
+void TestRender::parallelMatchesSerial()
+      {
+      if (!QFontDatabase::supportsThreadedFontRendering())
+            QSKIP("no threaded font rendering on this platform", SkipAll);
+      score->setPrinting(true);
+      QList<QImage> serial   = renderSerial();
+      QList<QImage> parallel = renderParallel();
+      score->setPrinting(false);
+      QCOMPARE(parallel.size(), serial.size());
+      for (int i = 0; i < serial.size(); ++i)
+            QVERIFY(parallel[i] == serial[i]);
+      }
+
+//---------------------------------------------------------
+//   glyphCacheMatchesText
+//    glyphs of the cached glyph runs must be placed where
+//    text layout places them, also for repeated symbols
+//---------------------------------------------------------
+
+void TestRender::glyphCacheMatchesText()
+      {
+      int checked = 0;
+      for (int i = 0; i < lastSym; ++i) {
+            const Sym& sym = symbols[0][i];
+            if (!sym.isValid() || sym.code() == -1
+               || !QRawFont::fromFont(sym.font()).supportsCharacter(uint(sym.code())))
+                  continue;
+            for (int n = 1; n <= 4; n += 3) {
+                  QString text;
+                  for (int k = 0; k < n; ++k)
+                        text += sym.toString();
+                  QTextLayout layout(text, sym.font());
+                  layout.beginLayout();
+                  layout.createLine();
+                  layout.endLayout();
+                  QVector<QPointF> expected;
+                  foreach (const QGlyphRun& run, layout.glyphRuns())
+                        expected += run.positions();
+                  QVector<QPointF> positions = sym.glyphRun(n).positions();
+                  QCOMPARE(positions.size(), expected.size());
+                  for (int k = 0; k < positions.size(); ++k) {
+                        QPointF d = (positions[k] - positions[0]) - (expected[k] - expected[0]);
+                        if (qAbs(d.x()) > 0.01 || qAbs(d.y()) > 0.01)
+                              QFAIL(qPrintable(QString("symbol %1 repeated %2 times: glyph %3 is off by %4")
+                                 .arg(Sym::id2name(SymId(i))).arg(n).arg(k).arg(d.x())));
+                        }
+                  ++checked;
+                  }
+            }
+      QVERIFY(checked > 0);
+      }
+
+//---------------------------------------------------------
+//   benchmarkSerial
+//---------------------------------------------------------
+
+void TestRender::benchmarkSerial()
+      {
+      score->setPrinting(true);
+      QBENCHMARK {
+            renderSerial();
+            }
+      score->setPrinting(false);
+      }
+
+//---------------------------------------------------------
+//   benchmarkSerialText
+//    symbols drawn as text, shaped on every draw
+//---------------------------------------------------------
+
+void TestRender::benchmarkSerialText()
+      {
+      score->setPrinting(true);
+      MScore::symbolGlyphCache = false;
+      QBENCHMARK {
+            renderSerial();
+            }
+      MScore::symbolGlyphCache = true;
+      score->setPrinting(false);
+      }
+
+//---------------------------------------------------------
+//   benchmarkParallel
+//---------------------------------------------------------
+
+void TestRender::benchmarkParallel()
+      {
+      if (!QFontDatabase::supportsThreadedFontRendering())
+            QSKIP("no threaded font rendering on this platform", SkipAll);
+      score->setPrinting(true);
+      QBENCHMARK {
+            renderParallel();
+            }
+      score->setPrinting(false);
+      }
+
+QTEST_MAIN(TestRender)
+#include "tst_render.moc"
+
@@ -0,0 +1,147 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//  $Id:$
+//
+//  Copyright (C) 2013 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+#include "libmscore/qzipreader_p.h"
+#include "libmscore/qzipwriter_p.h"
+
+#include <zlib.h>
+
+//---------------------------------------------------------
+//   TestZip
+//---------------------------------------------------------
+
+class TestZip : public QObject
+      {
+      Q_OBJECT
+
+      QByteArray large;       // several deflate chunks
+      QByteArray noise;       // does not compress
+      QByteArray writeArchive(QZipWriter::CompressionPolicy policy, int level);
+      void verifyArchive(const QByteArray& archive);
+
+   private slots:
+      void initTestCase();
+      void roundTrip_data();
+      void roundTrip();
+      void storeOnly();
+      void benchmarkWrite();
+      };
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestZip::initTestCase()
+      {
+      QTextStream s(&large);
+      for (int i = 0; i < 100000; ++i)
+            s << "<Note><pitch>" << 40 + i % 37 << "</pitch><tpc>" << i % 19 << "</tpc></Note>\n";
+      s.flush();
+      qsrand(42);
+      noise.resize(300 * 1024);
+      for (int i = 0; i < noise.size(); ++i)
+            noise[i] = char(qrand());
+      }
+
+//---------------------------------------------------------
+//   writeArchive
+//---------------------------------------------------------
+
+QByteArray TestZip::writeArchive(QZipWriter::CompressionPolicy policy, int level)
+      {
+      QBuffer buffer;
+      buffer.open(QIODevice::WriteOnly);
+      QZipWriter zip(&buffer);
+      zip.setCompressionPolicy(policy);
+      zip.setCompressionLevel(level);
+      zip.addDirectory("META-INF");
+      zip.addFile("META-INF/container.xml", QByteArray("<container/>"));
+      zip.addFile("empty", QByteArray());
+      zip.addFile("noise.bin", noise);
+      zip.addFile("score.mscx", large);
+      zip.close();
+      return buffer.data();
+      }
+
+//---------------------------------------------------------
+//   verifyArchive
+//---------------------------------------------------------
+
+void TestZip::verifyArchive(const QByteArray& archive)
+      {
+      QBuffer buffer;
+      buffer.setData(archive);
+      buffer.open(QIODevice::ReadOnly);
+      QZipReader zip(&buffer);
+      QCOMPARE(zip.status(), QZipReader::NoError);
+      QCOMPARE(zip.fileInfoList().size(), 5);
+      QCOMPARE(zip.fileData("META-INF/container.xml"), QByteArray("<container/>"));
+      QCOMPARE(zip.fileData("empty"), QByteArray());
+      QVERIFY(zip.fileData("noise.bin") == noise);
+      QVERIFY(zip.fileData("score.mscx") == large);
+      foreach (const QZipReader::FileInfo& fi, zip.fileInfoList()) {
+            if (fi.filePath == "score.mscx") {
+                  uint crc = crc32(crc32(0, 0, 0), (const uchar*)large.constData(), large.size());
+                  QCOMPARE(uint(fi.crc32), crc);
+                  }
+            }
+      }
+
+//---------------------------------------------------------
+//   roundTrip
+//    chunked parallel deflate must give a valid stream
+//    for every level
+//---------------------------------------------------------
+
+void TestZip::roundTrip_data()
+      {
+      QTest::addColumn<int>("level");
+      QTest::newRow("default") << -1;
+      QTest::newRow("fast")    << 1;
+      QTest::newRow("best")    << 9;
+      }
+
+void TestZip::roundTrip()
+      {
+      QFETCH(int, level);
+      QByteArray archive = writeArchive(QZipWriter::AlwaysCompress, level);
+      QVERIFY(archive.size() < large.size() / 4 + noise.size() * 2);
+      verifyArchive(archive);
+      }
+
+//---------------------------------------------------------
+//   storeOnly
+//---------------------------------------------------------
+
+void TestZip::storeOnly()
+      {
+      QByteArray archive = writeArchive(QZipWriter::NeverCompress, -1);
+      QVERIFY(archive.size() > large.size() + noise.size());
+      verifyArchive(archive);
+      }
+
+//---------------------------------------------------------
+//   benchmarkWrite
+//---------------------------------------------------------
+
+void TestZip::benchmarkWrite()
+      {
+      QBENCHMARK {
+            writeArchive(QZipWriter::AlwaysCompress, -1);
+            }
+      }
+
+QTEST_MAIN(TestZip)
+#include "tst_zip.moc"
+
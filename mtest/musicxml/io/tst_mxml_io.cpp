@@ -41,6 +41,8 @@ class TestMxmlIO : public QObject, public MTest
       void mxmlIoTestRef(const char* file);
       void mxmlReadTestCompr(const char* file);
       void mxmlReadWriteTestCompr(const char* file);
+      void mxmlParallelExportTest(Score* score, const char* file);
+      void mxmlParallelExportTest(const char* file);
 
 private slots:
       void initTestCase();
@@ -86,6 +88,7 @@ private slots:
       void keysig1() { mxmlIoTest("testKeysig1"); }
       void lines1() { mxmlIoTestRef("testLines1"); }
       void lines2() { mxmlIoTestRef("testLines2"); }
+      void lines3() { mxmlParallelExportTest("testLines3"); }
       void lyricsVoice2a() { mxmlIoTest("testLyricsVoice2a"); }
       void lyricsVoice2b() { mxmlIoTestRef("testLyricsVoice2b"); }
       void manualBreaks() { mxmlIoTest("testManualBreaks"); }
@@ -201,6 +204,7 @@ void TestMxmlIO::mxmlIoTest(const char* file)
       score->doLayout();
       QVERIFY(saveMusicXml(score, QString(file) + ".xml"));
       QVERIFY(saveCompareMusicXmlScore(score, QString(file) + ".xml", DIR + file + ".xml"));
+      mxmlParallelExportTest(score, file);
       delete score;
       }
 
@@ -220,6 +224,50 @@ void TestMxmlIO::mxmlIoTestRef(const char* file)
       score->doLayout();
       QVERIFY(saveMusicXml(score, QString(file) + ".xml"));
       QVERIFY(saveCompareMusicXmlScore(score, QString(file) + ".xml", DIR + file + "_ref.xml"));
+      mxmlParallelExportTest(score, file);
+      delete score;
+      }
+
+//---------------------------------------------------------
+//   mxmlParallelExportTest
+//   write the score with parts exported concurrently and with a single
+//   thread and verify both files are byte-identical
+//---------------------------------------------------------
+
+void TestMxmlIO::mxmlParallelExportTest(Score* score, const char* file)
+      {
+      QThreadPool* pool = QThreadPool::globalInstance();
+      int threads = pool->maxThreadCount();
+      pool->setMaxThreadCount(4);
+      bool parallelOk = saveMusicXml(score, QString(file) + "_parallel.xml");
+      pool->setMaxThreadCount(1);
+      bool serialOk = saveMusicXml(score, QString(file) + "_serial.xml");
+      pool->setMaxThreadCount(threads);
+      QVERIFY(parallelOk);
+      QVERIFY(serialOk);
+      QFile parallel(QString(file) + "_parallel.xml");
+      QFile serial(QString(file) + "_serial.xml");
+      QVERIFY(parallel.open(QIODevice::ReadOnly));
+      QVERIFY(serial.open(QIODevice::ReadOnly));
+      QVERIFY(parallel.readAll() == serial.readAll());
+      }
+
+//---------------------------------------------------------
+//   mxmlParallelExportTest
+//   read a MusicXML file with several parts and verify that exporting
+//   the parts concurrently and with a single thread gives the same file
+//---------------------------------------------------------
+
+void TestMxmlIO::mxmlParallelExportTest(const char* file)
+      {
+      MScore::debugMode = true;
+      preferences.musicxmlExportBreaks = MANUAL_BREAKS;
+      preferences.musicxmlImportBreaks = true;
+      Score* score = readScore(DIR + file + ".xml");
+      QVERIFY(score);
+      fixupScore(score);
+      score->doLayout();
+      mxmlParallelExportTest(score, file);
       delete score;
       }
 
@@ -0,0 +1,160 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//  $Id:$
+//
+//  Copyright (C) 2013 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+#include "omr/omr.h"
+#include "omr/pattern.h"
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestPattern
+//---------------------------------------------------------
+
+class TestPattern : public QObject
+      {
+      Q_OBJECT
+
+      Omr* omr;
+      QImage page;
+      void compareRow(int y, int px, int w, int h);
+
+   private slots:
+      void initTestCase();
+      void cleanupTestCase();
+      void matchRow_data();
+      void matchRow();
+      void benchmarkMatch();
+      void benchmarkMatchRow();
+      };
+
+//---------------------------------------------------------
+//   initTestCase
+//    a noisy 1 bit page with some filled ellipses
+//---------------------------------------------------------
+
+void TestPattern::initTestCase()
+      {
+      omr = new Omr(static_cast<Score*>(0));      // sets up Omr::bitsSetTable
+      page = QImage(1000, 120, QImage::Format_MonoLSB);
+      QVector<QRgb> ct(2);
+      ct[0] = qRgb(255, 255, 255);
+      ct[1] = qRgb(0, 0, 0);
+      page.setColorTable(ct);
+      page.fill(0);
+      qsrand(7);
+      for (int y = 0; y < page.height(); ++y) {
+            for (int x = 0; x < page.width(); ++x) {
+                  if ((qrand() % 11) == 0)
+                        page.setPixel(x, y, 1);
+                  }
+            }
+      QPainter p(&page);
+      p.setPen(Qt::NoPen);
+      p.setBrush(Qt::color1);
+      for (int x = 10; x < page.width(); x += 47)
+            p.drawEllipse(x, 40 + (x % 30), 21, 15);
+      }
+
+//---------------------------------------------------------
+//   cleanupTestCase
+//---------------------------------------------------------
+
+void TestPattern::cleanupTestCase()
+      {
+      delete omr;
+      }
+
+//---------------------------------------------------------
+//   compareRow
+//    matchRow must give the scores of Pattern::match for
+//    every position, also where the window leaves the page
+//---------------------------------------------------------
+
+void TestPattern::compareRow(int y, int px, int w, int h)
+      {
+      QImage* img = &page;
+      Pattern pattern(img, px, 40, w, h);
+      int x1 = 0;
+      int x2 = page.width() + 8;
+      QVector<double> scores(x2 - x1);
+      pattern.matchRow(img, x1, x2, y, scores.data());
+      for (int x = x1; x < x2; ++x) {
+            Pattern window(img, x, y, w, h);
+            double val = window.match(&pattern);
+            if (qAbs(val - scores[x - x1]) > 1e-9) {
+                  QString s = QString("x %1 y %2 size %3x%4: match %5 matchRow %6")
+                     .arg(x).arg(y).arg(w).arg(h).arg(val).arg(scores[x - x1]);
+                  QFAIL(qPrintable(s));
+                  }
+            }
+      }
+
+//---------------------------------------------------------
+//   matchRow
+//---------------------------------------------------------
+
+void TestPattern::matchRow_data()
+      {
+      QTest::addColumn<int>("y");
+      QTest::addColumn<int>("w");
+      QTest::addColumn<int>("h");
+      QTest::newRow("narrow")    << 40  << 21 << 16;
+      QTest::newRow("one word")  << 35  << 32 << 16;
+      QTest::newRow("two words") << 50  << 45 << 20;
+      QTest::newRow("wide")      << 30  << 70 << 12;
+      QTest::newRow("top")       << -6  << 21 << 16;
+      QTest::newRow("bottom")    << 110 << 21 << 16;
+      }
+
+void TestPattern::matchRow()
+      {
+      QFETCH(int, y);
+      QFETCH(int, w);
+      QFETCH(int, h);
+      compareRow(y, 57, w, h);
+      }
+
+//---------------------------------------------------------
+//   benchmarkMatch
+//    a Pattern copy and match for every position, as
+//    searchNotes did before
+//---------------------------------------------------------
+
+void TestPattern::benchmarkMatch()
+      {
+      Pattern pattern(&page, 57, 40, 21, 16);
+      QBENCHMARK {
+            for (int x = 0; x < page.width(); ++x) {
+                  Pattern window(&page, x, 45, 21, 16);
+                  window.match(&pattern);
+                  }
+            }
+      }
+
+//---------------------------------------------------------
+//   benchmarkMatchRow
+//---------------------------------------------------------
+
+void TestPattern::benchmarkMatchRow()
+      {
+      Pattern pattern(&page, 57, 40, 21, 16);
+      QVector<double> scores(page.width());
+      QBENCHMARK {
+            pattern.matchRow(&page, 0, page.width(), 45, scores.data());
+            }
+      }
+
+QTEST_MAIN(TestPattern)
+#include "tst_pattern.moc"
+
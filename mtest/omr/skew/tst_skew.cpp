@@ -0,0 +1,384 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//  $Id:$
+//
+//  Copyright (C) 2013 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+#include "mtest/testutils.h"
+#include "omr/omr.h"
+#include "omr/omrpage.h"
+
+using namespace Ms;
+
+static const int PAGE_W   = 2480;     // A4 at 300 dpi
+static const int PAGE_H   = 1400;
+static const int LINE_X1  = 200;
+static const int LINE_X2  = 2280;
+static const int SPATIUM  = 20;
+
+//---------------------------------------------------------
+//   TestSkew
+//---------------------------------------------------------
+
+class TestSkew : public QObject, public MTest
+      {
+      Q_OBJECT
+
+      Omr* omr;
+      QImage scan(double angle);
+      int maxRowCount(const QImage& img, int y1, int y2);
+      QImage deSkewReference(OmrPage& page);
+      double xproject2Reference(const OmrPage& page, int y1);
+      void compareXproject2(OmrPage& page);
+
+   private slots:
+      void initTestCase();
+      void cleanupTestCase();
+      void straight();
+      void deSkew_data();
+      void deSkew();
+      void deSkewReference_data();
+      void deSkewReference();
+      void benchmarkRead();
+      };
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestSkew::initTestCase()
+      {
+      initMTest();
+      omr = new Omr(static_cast<Score*>(0));
+      }
+
+//---------------------------------------------------------
+//   cleanupTestCase
+//---------------------------------------------------------
+
+void TestSkew::cleanupTestCase()
+      {
+      delete omr;
+      }
+
+//---------------------------------------------------------
+//   scan
+//    a 1 bit page with one system of two staves and some
+//    bar lines, rotated by angle degrees around the page
+//    center
+//---------------------------------------------------------
+
+QImage TestSkew::scan(double angle)
+      {
+      QImage img(PAGE_W, PAGE_H, QImage::Format_MonoLSB);
+      QVector<QRgb> ct(2);
+      ct[0] = qRgb(255, 255, 255);
+      ct[1] = qRgb(0, 0, 0);
+      img.setColorTable(ct);
+      img.fill(0);
+
+      QPainter p(&img);
+      p.translate(PAGE_W / 2, PAGE_H / 2);
+      p.rotate(angle);
+      p.translate(-PAGE_W / 2, -PAGE_H / 2);
+      p.setPen(Qt::NoPen);
+      p.setBrush(Qt::color1);
+      static const int staffTop[2] = { 500, 660 };
+      for (int staff = 0; staff < 2; ++staff) {
+            for (int line = 0; line < 5; ++line)
+                  p.drawRect(LINE_X1, staffTop[staff] + line * SPATIUM, LINE_X2 - LINE_X1, 2);
+            }
+      int y2 = staffTop[1] + 4 * SPATIUM + 2;
+      for (int x = LINE_X1; x <= LINE_X2 - 3; x += (LINE_X2 - LINE_X1 - 3) / 4)
+            p.drawRect(x, staffTop[0], 3, y2 - staffTop[0]);
+      p.end();
+      return img;
+      }
+
+//---------------------------------------------------------
+//   maxRowCount
+//    the largest number of set pixels in one row
+//---------------------------------------------------------
+
+int TestSkew::maxRowCount(const QImage& img, int y1, int y2)
+      {
+      int wl = img.bytesPerLine() / 4;
+      int max = 0;
+      for (int y = y1; y < y2; ++y) {
+            const uint* p = (const uint*)img.scanLine(y);
+            int n = 0;
+            for (int i = 0; i < wl; ++i)
+                  n += __builtin_popcount(p[i]);
+            max = qMax(max, n);
+            }
+      return max;
+      }
+
+//---------------------------------------------------------
+//   deSkewReference
+//    OmrPage::deSkew() as it mapped every pixel on its own
+//---------------------------------------------------------
+
+QImage TestSkew::deSkewReference(OmrPage& page)
+      {
+      QImage img = page.image().copy();
+      int wl    = page.wordsPerLine();
+      int h     = page.height();
+      uint* db  = (uint*)img.bits();
+      memset(db, 0, wl * h * sizeof(uint));
+
+      foreach(const QRect& r, page._slices) {
+            double rot = page.skew(r);
+            if (qAbs(rot) < 0.1) {
+                  memcpy(db + wl * r.y(), page.scanLine(r.y()), wl * r.height() * sizeof(uint));
+                  continue;
+                  }
+            QTransform t;
+            t.rotate(rot);
+            QTransform tt = QImage::trueMatrix(t, page.width(), r.height());
+
+            double m11 = tt.m11();
+            double m12 = tt.m12();
+            double m21 = tt.m21();
+            double m22 = tt.m22();
+            double dx  = tt.m31();
+            double dy  = tt.m32();
+
+            double m21y = r.y() * m21;
+            double m22y = r.y() * m22;
+            int y2 = r.y() + r.height();
+
+            for (int y = r.y(); y < y2; ++y) {
+                  const uint* s = page.scanLine(y);
+                  m21y += m21;
+                  m22y += m22;
+                  for (int x = 0; x < wl; ++x) {
+                        uint c = *s++;
+                        for (int xx = 0; xx < 32; ++xx) {
+                              if (!(c & (1u << xx)))
+                                    continue;
+                              int xs  = x * 32 + xx;
+                              int xd  = lrint(m11 * xs + m21y + dx);
+                              int yd  = lrint(m22y + m12 * xs + dy);
+                              int wxd = xd / 32;
+                              if ((xd >= 0) && (wxd < wl) && (yd >= 0) && (yd < h))
+                                    db[wl * yd + wxd] |= 1u << (xd % 32);
+                              }
+                        }
+                  }
+            }
+      return img;
+      }
+
+//---------------------------------------------------------
+//   xproject2Reference
+//    OmrPage::xproject2() as it tested every pixel on its
+//    own; the row below the last one counts as empty
+//---------------------------------------------------------
+
+double TestSkew::xproject2Reference(const OmrPage& page, int y1)
+      {
+      int wl          = page.wordsPerLine();
+      int h           = page.height();
+      const uint* db  = page.bits();
+      double val      = 0.0;
+
+      int w  = wl - page.cropL - page.cropR;
+      int x1 = (page.cropL + w/4)*32;
+      int x2 = x1 + (w/2 * 32);
+
+      int ddx = x2 - x1;
+      for (int dy = -12; dy < 12; ++dy) {
+            int onRun   = 0;
+            int offRun  = 0;
+            int on      = 0;
+            int off     = 0;
+            bool onFlag = false;
+            int incy    = (dy > 0) ? 1 : (dy < 0) ? -1 : 0;
+            int ddy     = dy < 0 ? -dy : dy;
+            int y       = y1;
+            if (y < 1)
+                  y = 0;
+            int err     = ddx / 2;
+            for (int x = x1; x < x2;) {
+                  const uint* d  = db + wl * y + (x / 32);
+                  if (d < db + wl)
+                        break;
+                  if (d >= db + (wl-1) * h)
+                        break;
+                  uint mask = 1u << (x % 32);
+                  bool bit = (*d & mask) || (*(d-wl) & mask) || ((y + 1 < h) && (*(d+wl) & mask));
+                  if (bit != onFlag) {
+                        if (!onFlag) {
+                              if (offRun > 20) {
+                                    off += offRun * offRun;
+                                    on  += onRun * onRun;
+                                    onRun  = 0;
+                                    offRun = 0;
+                                    }
+                              else {
+                                    onRun += offRun;
+                                    offRun = 0;
+                                    }
+                              }
+                        onFlag = bit;
+                        }
+                  (bit ? onRun : offRun)++;
+                  if (offRun > 100) {
+                        offRun = 0;
+                        off   = 1;
+                        on    = 0;
+                        onRun = 0;
+                        break;
+                        }
+                  err -= ddy;
+                  if (err < 0) {
+                        err += ddx;
+                        y   += incy;
+                        if (y < 1)
+                              y = 1;
+                        else if (y >= h)
+                              y = h-1;
+                        }
+                  ++x;
+                  }
+            if (offRun > 20)
+                  off += offRun * offRun;
+            else
+                  onRun += offRun;
+            on  += onRun * onRun;
+            if (off == 0)
+                  off = 1;
+            double nval = double(on) / double(off);
+            if (nval > val)
+                  val = nval;
+            }
+      return val;
+      }
+
+//---------------------------------------------------------
+//   compareXproject2
+//    for every row of the page
+//---------------------------------------------------------
+
+void TestSkew::compareXproject2(OmrPage& page)
+      {
+      for (int y = 0; y < page.height(); ++y) {
+            double val = page.xproject2(y);
+            double ref = xproject2Reference(page, y);
+            if (val != ref) {
+                  QString s = QString("y %1: xproject2 %2 reference %3").arg(y).arg(val).arg(ref);
+                  QFAIL(qPrintable(s));
+                  }
+            }
+      }
+
+//---------------------------------------------------------
+//   straight
+//    an unskewed page is not changed and is recognized
+//---------------------------------------------------------
+
+void TestSkew::straight()
+      {
+      QImage img = scan(0.0);
+      OmrPage page(omr);
+      page.setImage(img);
+      page.read(0);
+      QVERIFY(page.image() == img);
+      QVERIFY(qAbs(page.spatium() - SPATIUM) <= 1.0);
+      QCOMPARE(page.systems().size(), 1);
+      QCOMPARE(page.systems()[0].staves().size(), 2);
+      }
+
+//---------------------------------------------------------
+//   deSkew
+//    after reading, staff lines of a skewed page must be
+//    horizontal again, within the resolution of the skew
+//    estimation
+//---------------------------------------------------------
+
+void TestSkew::deSkew_data()
+      {
+      QTest::addColumn<double>("angle");
+      QTest::newRow("0.5")  << 0.5;
+      QTest::newRow("-0.5") << -0.5;
+      QTest::newRow("1.2")  << 1.2;
+      QTest::newRow("-1.2") << -1.2;
+      }
+
+void TestSkew::deSkew()
+      {
+      QFETCH(double, angle);
+      int lineLength = LINE_X2 - LINE_X1;
+      QImage img = scan(angle);
+      QVERIFY(maxRowCount(img, 0, PAGE_H) < lineLength / 4);
+
+      OmrPage page(omr);
+      page.setImage(img);
+      page.read(0);
+      QVERIFY(maxRowCount(page.image(), 0, PAGE_H) > lineLength / 2);
+      QVERIFY(qAbs(page.spatium() - SPATIUM) <= 1.0);
+      QCOMPARE(page.systems().size(), 1);
+      }
+
+//---------------------------------------------------------
+//   deSkewReference
+//    deSkew() and xproject2() must give exactly the
+//    results of the per pixel versions, for the skewed
+//    page and for the deskewed one
+//---------------------------------------------------------
+
+void TestSkew::deSkewReference_data()
+      {
+      QTest::addColumn<double>("angle");
+      QTest::newRow("0")    << 0.0;
+      QTest::newRow("0.3")  << 0.3;
+      QTest::newRow("-0.7") << -0.7;
+      QTest::newRow("1.2")  << 1.2;
+      QTest::newRow("-2.5") << -2.5;
+      }
+
+void TestSkew::deSkewReference()
+      {
+      QFETCH(double, angle);
+      OmrPage page(omr);
+      page.setImage(scan(angle));
+      page.crop();
+      page.slice();
+      compareXproject2(page);
+
+      QImage ref = deSkewReference(page);
+      page.deSkew();
+      QVERIFY(page.image() == ref);
+
+      page.crop();
+      page.slice();
+      compareXproject2(page);
+      }
+
+//---------------------------------------------------------
+//   benchmarkRead
+//    crop, slice, deskew and staff line search
+//---------------------------------------------------------
+
+void TestSkew::benchmarkRead()
+      {
+      QImage img = scan(0.7);
+      QBENCHMARK {
+            OmrPage page(omr);
+            page.setImage(img.copy());
+            page.read(0);
+            }
+      }
+
+QTEST_MAIN(TestSkew)
+#include "tst_skew.moc"
+
@@ -257,6 +257,58 @@ bool MTest::saveMusicXml(Score* score, const QString& saveName)
       return saveXml(score, saveName);
       }
 
+//---------------------------------------------------------
+//   writeGeneratedScore
+//    write a one staff piano score of the given number of
+//    measures in 4/4; writeMeasure writes the contents of
+//    measure m (0 based), the first measure starts with a
+//    G clef and the time signature
+//---------------------------------------------------------
+
+bool MTest::writeGeneratedScore(const QString& path, int measures, void (*writeMeasure)(QTextStream&, int))
+      {
+      QFile f(path);
+      if (!f.open(QIODevice::WriteOnly))
+            return false;
+      QTextStream s(&f);
+      s << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+           "<museScore version=\"1.24\">\n"
+           "  <Score>\n"
+           "    <Division>480</Division>\n"
+           "    <Part>\n"
+           "      <Staff id=\"1\">\n"
+           "        <type>0</type>\n"
+           "        </Staff>\n"
+           "      <trackName>Piano</trackName>\n"
+           "      <Instrument>\n"
+           "        <trackName>Piano</trackName>\n"
+           "        <Channel>\n"
+           "          </Channel>\n"
+           "        </Instrument>\n"
+           "      </Part>\n"
+           "    <Staff id=\"1\">\n";
+      for (int m = 0; m < measures; ++m) {
+            s << "      <Measure number=\"" << m + 1 << "\">\n";
+            if (m == 0) {
+                  s << "        <Clef>\n"
+                       "          <concertClefType>G</concertClefType>\n"
+                       "          <transposingClefType>G</transposingClefType>\n"
+                       "          </Clef>\n"
+                       "        <TimeSig>\n"
+                       "          <sigN>4</sigN>\n"
+                       "          <sigD>4</sigD>\n"
+                       "          </TimeSig>\n";
+                  }
+            writeMeasure(s, m);
+            s << "        </Measure>\n";
+            }
+      s << "      </Staff>\n"
+           "    </Score>\n"
+           "  </museScore>\n";
+      s.flush();
+      return f.error() == QFile::NoError;
+      }
+
 //---------------------------------------------------------
 //   initMTest
 //---------------------------------------------------------
@@ -40,6 +40,7 @@ class MTest {
       bool saveCompareScore(Ms::Score*, const QString& saveName, const QString& compareWith);
       bool saveCompareMusicXmlScore(Ms::Score*, const QString& saveName, const QString& compareWith);
       Ms::Element* writeReadElement(Ms::Element* element);
+      bool writeGeneratedScore(const QString& path, int measures, void (*writeMeasure)(QTextStream&, int));
       void initMTest();
       };
 }
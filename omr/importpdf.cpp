@@ -203,8 +203,10 @@ Score::FileError importPdf(Score* score, const QString& path)
       {
       Omr* omr = new Omr(path, score);
       if (!omr->readPdf()) {
+            // an opened document means recognition was canceled
+            Score::FileError rv = omr->pagesInDocument() ? Score::FILE_USER_ABORT : Score::FILE_BAD_FORMAT;
             delete omr;
-            return Score::FILE_BAD_FORMAT;
+            return rv;
             }
       score->setOmr(omr);
       qreal sp = omr->spatiumMM();
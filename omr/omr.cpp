@@ -27,6 +27,7 @@
 #include "ocr.h"
 #endif
 #include "utils.h"
+#include "mscore/globals.h"
 
 namespace Ms {
 
@@ -124,7 +125,8 @@ int Omr::pagesInDocument() const
 
 //---------------------------------------------------------
 //   readPdf
-//    return true on success
+//    return true on success, false if the file could
+//    not be read or recognition was canceled
 //---------------------------------------------------------
 
 bool Omr::readPdf()
@@ -150,34 +152,98 @@ bool Omr::readPdf()
             page->setImage(image);
             _pages.append(page);
             }
-      process();
-      return true;
+      return process();
+      }
+
+//---------------------------------------------------------
+//   parallelPageRecognition
+//    pages are recognized concurrently on the global thread
+//    pool when called from the gui thread; the pool size
+//    bounds the number of page buffers in flight
+//---------------------------------------------------------
+
+static bool parallelPageRecognition(int pages)
+      {
+      return pages > 1
+         && QThread::currentThread() == qApp->thread()
+         && QThreadPool::globalInstance()->maxThreadCount() > 1
+         && QFontDatabase::supportsThreadedFontRendering();
       }
 
 //---------------------------------------------------------
 //   process
+//    recognize all pages, showing page progress unless
+//    running without gui; return false if canceled
 //---------------------------------------------------------
 
-void Omr::process()
+bool Omr::process()
       {
+      int n = _pages.size();
+      bool canceled = false;
+
+      if (parallelPageRecognition(n)) {
+            QList<int> pl;
+            for (int i = 0; i < n; ++i)
+                  pl.append(i);
+            QFutureWatcher<void> watcher;
+            QProgressDialog* progress = 0;
+            if (!noGui) {
+                  progress = new QProgressDialog(QWidget::tr("Recognizing pages..."),
+                     QWidget::tr("Cancel"), 0, n);
+                  progress->setWindowModality(Qt::ApplicationModal);
+                  QObject::connect(&watcher, SIGNAL(finished()), progress, SLOT(reset()));
+                  QObject::connect(progress, SIGNAL(canceled()), &watcher, SLOT(cancel()));
+                  QObject::connect(&watcher, SIGNAL(progressRangeChanged(int,int)), progress, SLOT(setRange(int,int)));
+                  QObject::connect(&watcher, SIGNAL(progressValueChanged(int)), progress, SLOT(setValue(int)));
+                  }
+            watcher.setFuture(QtConcurrent::map(pl, [this](int& i) { _pages[i]->read(i); }));
+            if (progress)
+                  progress->exec();
+            watcher.waitForFinished();
+            canceled = watcher.isCanceled();
+            delete progress;
+            }
+      else {
+            QProgressDialog* progress = 0;
+            if (!noGui && n > 1) {
+                  progress = new QProgressDialog(QWidget::tr("Recognizing pages..."),
+                     QWidget::tr("Cancel"), 0, n);
+                  progress->setWindowModality(Qt::ApplicationModal);
+                  }
+            for (int i = 0; i < n; ++i) {
+                  if (progress) {
+                        progress->setValue(i);
+                        if (progress->wasCanceled()) {
+                              canceled = true;
+                              break;
+                              }
+                        }
+                  _pages[i]->read(i);
+                  }
+            delete progress;
+            }
+      if (canceled)
+            return false;
+
+      //
+      // aggregate page values once all pages are done
+      //
       double sp = 0;
       double w  = 0;
-
       int pages = 0;
-      int n = _pages.size();
       for (int i = 0; i < n; ++i) {
-            _pages[i]->read(i);
             if (_pages[i]->systems().size() > 0) {
                   sp += _pages[i]->spatium();
                   ++pages;
                   }
             w  += _pages[i]->width();
             }
-      _spatium = sp / pages;
-      w       /= n;
+      _spatium = pages ? sp / pages : 0.0;
+      w       /= n ? n : 1;
       _dpmm    = w / 210.0;            // PaperSize A4
 
 // printf("*** spatium: %f mm  dpmm: %f\n", spatiumMM(), _dpmm);
+      return true;
       }
 
 //---------------------------------------------------------
@@ -80,7 +80,7 @@ class Omr {
       double systemDistance() const;
       Score* score() const                 { return _score;     }
       const QString& path() const          { return _path;      }
-      void process();
+      bool process();
       };
 
 #else
@@ -99,11 +99,20 @@ void OmrPage::read(int /*pageNo*/)
             }
 
       //--------------------------------------------------
-      //    search bar lines
+      //    search bar lines and notes; systems are searched
+      //    concurrently only if the page itself is not read
+      //    by a worker thread
       //--------------------------------------------------
 
-      QFuture<void> bl = QtConcurrent::map(_systems, &OmrSystem::searchBarLines);
-      bl.waitForFinished();
+      if (QThread::currentThread() == qApp->thread()
+         && QFontDatabase::supportsThreadedFontRendering()) {
+            QFuture<void> bl = QtConcurrent::map(_systems, &OmrSystem::searchBarLines);
+            bl.waitForFinished();
+            }
+      else {
+            for (OmrSystem& system : _systems)
+                  system.searchBarLines();
+            }
       }
 
 //---------------------------------------------------------
@@ -498,6 +507,30 @@ void OmrPage::deSkew()
                         uint c = *s++;
                         if (c == 0)
                               continue;
+                        //
+                        // for small angles the destination of all 32
+                        // pixels of a word is usually one row and
+                        // contiguous; the mapping is monotone, so
+                        // checking the first and the last pixel is
+                        // enough to move the word as a whole
+                        //
+                        int xs0  = x * 32;
+                        int xs1  = xs0 + 31;
+                        int xd0  = lrint(m11 * xs0 + m21y + dx);
+                        int yd0  = lrint(m22y + m12 * xs0 + dy);
+                        int xd1  = lrint(m11 * xs1 + m21y + dx);
+                        int yd1  = lrint(m22y + m12 * xs1 + dy);
+                        if ((yd0 == yd1) && (xd1 - xd0 == 31) && (xd0 >= 0)) {
+                              int wxd = xd0 / 32;
+                              int sh  = xd0 % 32;
+                              if ((yd0 >= 0) && (yd0 < h) && (wxd < wl)) {
+                                    uint* d = db + wl * yd0 + wxd;
+                                    *d |= c << sh;
+                                    if (sh && (wxd + 1 < wl))
+                                          *(d+1) |= c >> (32 - sh);
+                                    }
+                              continue;
+                              }
                         uint mask = 1;
                         for (int xx = 0; xx < 32; ++xx) {
                               if (c & mask) {
@@ -544,23 +577,42 @@ int OmrPage::xproject(const uint* p, int wl)
       int w   = wl - cropL - cropR;
       int x1 = cropL + w/4;         // only look at part of page
       int x2 = x1 + w/2;
-      for (int x = cropL; x < x2; ++x) {
-            uint v = *p++;
-            run += Omr::bitsSetTable[v & 0xff]
-                + Omr::bitsSetTable[(v >> 8) & 0xff]
-                + Omr::bitsSetTable[(v >> 16) & 0xff]
-                + Omr::bitsSetTable[v >> 24];
-            }
+      for (int x = cropL; x < x2; ++x)
+            run += __builtin_popcount(*p++);
       return run;
       }
 
+//---------------------------------------------------------
+//   rowBits
+//    32 pixels starting at x of the rows above, at and
+//    below y or'ed together; r0 or r2 may be null
+//---------------------------------------------------------
+
+static inline uint rowBits(const uint* r0, const uint* r1, const uint* r2, int wl, int x)
+      {
+      int q = x / 32;
+      int s = x % 32;
+      uint v = r1[q] | (r0 ? r0[q] : 0) | (r2 ? r2[q] : 0);
+      v >>= s;
+      if (s && (q + 1 < wl)) {
+            uint n = r1[q+1] | (r0 ? r0[q+1] : 0) | (r2 ? r2[q+1] : 0);
+            v |= n << (32 - s);
+            }
+      return v;
+      }
+
 //---------------------------------------------------------
 //   xproject2
+//    rate how well a line starting at y1 follows a staff
+//    line for a range of slopes; runs along the line are
+//    found a word at a time, the line is split into
+//    stretches of constant y
 //---------------------------------------------------------
 
 double OmrPage::xproject2(int y1)
       {
       int wl          = wordsPerLine();
+      int h           = height();
       const uint* db  = bits();
       double val      = 0.0;
 
@@ -581,16 +633,38 @@ double OmrPage::xproject2(int y1)
             if (y < 1)
                   y = 0;
             int err     = ddx / 2;
-            for (int x = x1; x < x2;) {
-                  const uint* d  = db + wl * y + (x / 32);
-                  if (d < db + wl)
+            bool tooLongOff = false;
+            for (int x = x1; x < x2 && !tooLongOff;) {
+                  if (y == 0)
                         break;
-                  if (d >= db + (wl-1) * height()) //check that we are in the bounds.
+                  // stay inside of the image
+                  int xlim = ((wl - 1) * h - wl * y) * 32;
+                  if (x >= xlim)
                         break;
-                  bool bit = ((*d) & (0x1 << (x % 32)));
-                  bit = bit || ((*(d+wl)) & (0x1 << (x % 32)));
-                  bit = bit || ((*(d-wl)) & (0x1 << (x % 32)));
-                  if (bit != onFlag) {
+                  int n = qMin(x2, xlim) - x;
+                  if (ddy)
+                        n = qMin(n, err / ddy + 1);
+
+                  const uint* r1 = db + wl * y;
+                  const uint* r0 = r1 - wl;
+                  const uint* r2 = (y + 1 < h) ? r1 + wl : 0;
+                  int end = x + n;
+                  for (int xx = x; xx < end;) {
+                        int avail = qMin(32, end - xx);
+                        uint diff = rowBits(r0, r1, r2, wl, xx);
+                        if (onFlag)
+                              diff = ~diff;
+                        if (avail < 32)
+                              diff &= (1u << avail) - 1;
+                        int same = diff ? __builtin_ctz(diff) : avail;
+                        (onFlag ? onRun : offRun) += same;
+                        xx += same;
+                        if (offRun > 100) {
+                              tooLongOff = true;
+                              break;
+                              }
+                        if (!diff)
+                              continue;
                         if (!onFlag) {
                               //
                               // end of offrun:
@@ -606,26 +680,31 @@ double OmrPage::xproject2(int y1)
                                     offRun = 0;
                                     }
                               }
-                        onFlag = bit;
+                        onFlag = !onFlag;
+                        (onFlag ? onRun : offRun)++;
+                        ++xx;
+                        if (offRun > 100) {
+                              tooLongOff = true;
+                              break;
+                              }
                         }
-                  (bit ? onRun : offRun)++;
-                  if (offRun > 100) {
+                  if (tooLongOff) {
                         offRun = 0;
                         off   = 1;
                         on    = 0;
                         onRun = 0;
                         break;
                         }
-                  err -= ddy;
+                  x   += n;
+                  err -= n * ddy;
                   if (err < 0) {
                         err += ddx;
                         y   += incy;
                         if (y < 1)
                               y = 1;
-                        else if (y >= height())
-                              y = height()-1;
+                        else if (y >= h)
+                              y = h-1;
                         }
-                  ++x;
                   }
             if (offRun > 20)
                   off += offRun * offRun;
@@ -783,9 +862,10 @@ void OmrSystem::searchNotes(QList<OmrNote*>* noteList, Pattern* pattern,
       int xx1    = -1000;
       double val = 0.0;
 
+      QVector<double> scores(qMax(x2 - x1, 0));
+      pattern->matchRow(&_page->image(), x1, x2, y - hh/2, scores.data());
       for (int x = x1; x < x2; ++x) {
-            Pattern p(&_page->image(), x, y - hh/2, hw, hh);
-            double val1 = p.match(pattern);
+            double val1 = scores[x - x1];
             if (x > (xx1 + hw)) {
                   if (xx1 >= 0)
                         notePeaks.append(Peak(xx1, val));
@@ -23,6 +23,8 @@
 
 #include "libmscore/durationtype.h"
 
+class TestSkew;
+
 namespace Ms {
 
 class Omr;
@@ -123,6 +125,8 @@ class OmrPage {
       int xproject(const uint* p, int wl);
       void radonTransform(ulong* projection, int w, int n, const QRect&);
 
+      friend class ::TestSkew;      // compares deSkew() and xproject2() with per pixel versions
+
    public:
       OmrPage(Omr* _parent);
       void setImage(const QImage& i)     { _image = i; }
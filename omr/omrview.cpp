@@ -30,12 +30,26 @@
 
 namespace Ms {
 
+static const int TILE_POOL_SIZE = 64 * 1024;    // KB, minimum
+static const int MAX_TILE_LEVEL = 8;
+static const double MIN_MAG     = 0.05;
+
+//---------------------------------------------------------
+//   tileCost
+//    pool cost of a tile of level in KB
+//---------------------------------------------------------
+
+static int tileCost(int level)
+      {
+      return (TILE_W / level) * (TILE_H / level) * 4 / 1024;
+      }
+
 //---------------------------------------------------------
 //   OmrView
 //---------------------------------------------------------
 
 OmrView::OmrView(ScoreView* sv, QWidget* parent)
-   : QWidget(parent)
+   : QWidget(parent), tiles(TILE_POOL_SIZE)
       {
       setFocusPolicy(Qt::StrongFocus);
       setAttribute(Qt::WA_InputMethodEnabled);
@@ -52,6 +66,11 @@ OmrView::OmrView(ScoreView* sv, QWidget* parent)
       _showBarlines   = true;
       _showSlices     = true;
       _showStaves     = true;
+      maxTiles        = 0;
+      hTiles          = 0;
+      tileGeneration  = 0;
+      tilePassLevel   = 0;
+      connect(&tileWatcher, SIGNAL(finished()), SLOT(tileFinished()));
       }
 
 //---------------------------------------------------------
@@ -62,6 +81,10 @@ void OmrView::setOmr(Omr* s)
       {
       delete _omr;
       _omr    = s;
+      tiles.clear();
+      tileRequests.clear();
+      finishedTiles.clear();
+      ++tileGeneration;
       if (s == 0 || s->numPages() == 0) {
             maxTiles = 0;
             return;
@@ -74,41 +97,146 @@ void OmrView::setOmr(Omr* s)
       double mag           = _omr->spatium() / score->spatium();
       pageWidth            = lrint(pf->width()  * mag * MScore::DPI);
 
-      int htiles = ((pageWidth + TILE_W - 1) / TILE_W);
-      pageWidth  = htiles * TILE_W;
+      hTiles     = ((pageWidth + TILE_W - 1) / TILE_W);
+      pageWidth  = hTiles * TILE_W;
       int vtiles = (i.height() + TILE_H - 1) / TILE_H;
-      maxTiles   = n * htiles *  vtiles;
+      maxTiles   = n * hTiles *  vtiles;
+      resizeTilePool();
       }
 
 //---------------------------------------------------------
-//   initTile
+//   resizeTilePool
+//    the pool holds at least the visible tiles and the
+//    ring around them at the level which needs the most
+//    memory for this view size; a smaller pool drops
+//    visible tiles to make room for the next ones
 //---------------------------------------------------------
 
-void OmrView::initTile(Tile* t)
+void OmrView::resizeTilePool()
       {
-      int page1  = t->r.x() / pageWidth;
-      if (page1 < 0)
-            page1 = 0;
-      int n = _omr->numPages();
-      if (page1 >= n)
-            return;
+      int size = TILE_POOL_SIZE;
+      for (int level = 1; level <= MAX_TILE_LEVEL; level *= 2) {
+            // smallest mag drawing tiles of this level
+            double m = level == MAX_TILE_LEVEL ? MIN_MAG : 0.5 / level;
+            int tw   = int(width()  / (TILE_W * m)) + 3;   // partial tiles and ring
+            int th   = int(height() / (TILE_H * m)) + 3;
+            int n    = qMin(tw * th, maxTiles);
+            size     = qMax(size, n * tileCost(level));
+            }
+      tiles.setMaxCost(size);
+      }
+
+//---------------------------------------------------------
+//   resizeEvent
+//---------------------------------------------------------
+
+void OmrView::resizeEvent(QResizeEvent*)
+      {
+      resizeTilePool();
+      }
+
+//---------------------------------------------------------
+//   tileLevel
+//    scale down tiles as long as they are drawn at
+//    less than half their size
+//---------------------------------------------------------
+
+int OmrView::tileLevel() const
+      {
+      int level = 1;
+      while (level < MAX_TILE_LEVEL && mag() * level * 2 <= 1.0)
+            level *= 2;
+      return level;
+      }
+
+//---------------------------------------------------------
+//   convertTile
+//    cut out and scale a tile of a page image; runs in a
+//    worker thread on a shallow copy of the image
+//---------------------------------------------------------
+
+static OmrTile convertTile(QImage image, OmrTileKey key, int generation)
+      {
+      OmrTile t;
+      t.key        = key;
+      t.generation = generation;
+      int xoffset  = 0; // (pageWidth - i.width()) / 2;
+      QImage img   = image.copy(key.x * TILE_W - xoffset, key.y * TILE_H, TILE_W, TILE_H);
+      if (key.level > 1)
+            img = img.scaled(TILE_W / key.level, TILE_H / key.level, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+      t.image = img.convertToFormat(QImage::Format_RGB32);
+      return t;
+      }
+
+//---------------------------------------------------------
+//   tile
+//    the pooled pixmap of key; if it is not converted yet,
+//    any other level of the tile
+//---------------------------------------------------------
+
+const QPixmap* OmrView::tile(const OmrTileKey& key)
+      {
+      const QPixmap* pm = tiles.object(key);
+      if (pm)
+            return pm;
+      for (int level = 1; level <= MAX_TILE_LEVEL; level *= 2) {
+            if (level != key.level && (pm = tiles.object(OmrTileKey(key.page, key.x, key.y, level))))
+                  return pm;
+            }
+      return 0;
+      }
 
-      t->page     = _omr->page(page1);
-      t->pageNo   = page1;
+//---------------------------------------------------------
+//   needTile
+//    return true if key is neither in the pool nor being
+//    converted nor converted since the view moved
+//---------------------------------------------------------
 
-      const QImage& i = t->page->image();
-      int xoffset     = 0; // (pageWidth - i.width()) / 2;
-      int x           = t->r.x() - (t->pageNo * pageWidth) - xoffset;
-      t->pm           = QPixmap::fromImage(i.copy(x, t->r.y(), TILE_W, TILE_H));
+bool OmrView::needTile(const OmrTileKey& key) const
+      {
+      if (tiles.contains(key) || finishedTiles.contains(key))
+            return false;
+      return !(tileWatcher.isRunning() && key == runningTile);
       }
 
 //---------------------------------------------------------
-//   Tile
+//   startTile
+//    convert the next requested tile, one at a time
 //---------------------------------------------------------
 
-Tile::Tile()
-   : no(0), r(0, 0, TILE_W, TILE_H), pm(TILE_W, TILE_H)
+void OmrView::startTile()
       {
+      if (tileWatcher.isRunning())
+            return;
+      while (!tileRequests.isEmpty()) {
+            OmrTileKey key = tileRequests.takeFirst();
+            if (tiles.contains(key))
+                  continue;
+            const QImage& image = _omr->page(key.page)->image();
+            runningTile = key;
+            tileWatcher.setFuture(QtConcurrent::run(convertTile, image, key, tileGeneration));
+            return;
+            }
+      }
+
+//---------------------------------------------------------
+//   tileFinished
+//    upload the converted tile to a pixmap in the gui
+//    thread
+//---------------------------------------------------------
+
+void OmrView::tileFinished()
+      {
+      OmrTile t = tileWatcher.result();
+      if (_omr && t.generation == tileGeneration) {
+            QPixmap* pm = new QPixmap(QPixmap::fromImage(t.image));
+            tiles.insert(t.key, pm, tileCost(t.key.level));
+            finishedTiles.insert(t.key);
+            int x = (t.key.page * hTiles + t.key.x) * TILE_W;
+            QRect r(x, t.key.y * TILE_H, TILE_W, TILE_H);
+            update(_matrix.mapRect(r).adjusted(-1, -1, 1, 1));
+            }
+      startTile();
       }
 
 //---------------------------------------------------------
@@ -123,31 +251,16 @@ void OmrView::paintEvent(QPaintEvent* event)
       QPainter p(this);
       p.setTransform(_matrix);
 
-      QRect r(event->rect());
-
-      //
-      // remove unused tiles
-      //
-      QRect rr = _matrix.inverted().mapRect(QRectF(r)).toRect();
+      // tiles are requested for the whole view, but only
+      // drawn where exposed
+      QTransform imatrix(_matrix.inverted());
+      QRect er = imatrix.mapRect(QRectF(event->rect())).toRect();
+      er.adjust(-1, -1, 2, 2);
+      QRect rr = imatrix.mapRect(QRectF(rect())).toRect();
       rr.adjust(-1, -1, 2, 2);
 
-      QList<Tile*> nl;
-      foreach(Tile* t, usedTiles) {
-            if (t->r.intersects(rr))
-                  nl.append(t);
-            else
-                  freeTiles.append(t);
-            }
-#if QT_VERSION >= 0x040800
-      usedTiles.swap(nl);
-#else
-      QList<Tile*> tmp = nl;
-      nl = usedTiles;
-      usedTiles = tmp;
-#endif
-
       //
-      // add visible tiles
+      // draw visible tiles from the pool
       //
       Score* score    = _scoreView->score();
 
@@ -177,36 +290,64 @@ void OmrView::paintEvent(QPaintEvent* event)
       if (y2 > ny)
             y2 = ny;
 
+      int level = tileLevel();
+      QRect pass(x1, y1, x2 - x1, y2 - y1);
+      if (pass != tilePass || level != tilePassLevel) {
+            finishedTiles.clear();
+            tilePass      = pass;
+            tilePassLevel = level;
+            }
+      // tiles are only requested as long as all of them fit
+      // into the pool; a tile which was converted since the
+      // view moved is not requested again
+      int budget = tiles.maxCost();
+      int cost   = tileCost(level);
+      QList<OmrTileKey> requests;
+      int minPage = 9000;
+      int maxPage = 0;
       for (int y = y1; y < y2; ++y) {
             for (int x = x1; x < x2; ++x) {
                   int no = nx * y + x;
                   if (no < 0 || no >= maxTiles)
                         continue;
-                  int i;
-                  for (i = 0; i < usedTiles.size(); ++i) {
-                        if (usedTiles[i]->no == no)
-                              break;
-                        }
-                  if (i == usedTiles.size()) {
-                        // create new tile
-                        Tile* t = freeTiles.isEmpty() ? new Tile : freeTiles.pop();
-                        t->no = no;
-                        t->r  = QRect(x * TILE_W, y * TILE_H, TILE_W, TILE_H);
-                        initTile(t);
-                        usedTiles.append(t);
+                  OmrTileKey key(x / hTiles, x % hTiles, y, level);
+                  QRect tr(x * TILE_W, y * TILE_H, TILE_W, TILE_H);
+                  budget -= cost;
+                  if (budget >= 0 && needTile(key))
+                        requests.append(key);
+                  if (tr.intersects(er)) {
+                        const QPixmap* pm = tile(key);
+                        if (pm)
+                              p.drawPixmap(tr, *pm);
+                        else
+                              p.fillRect(tr, Qt::white);
                         }
+                  if (key.page < minPage)
+                        minPage = key.page;
+                  if (key.page > maxPage)
+                        maxPage = key.page;
                   }
             }
 
-      int minPage = 9000;
-      int maxPage = 0;
-      foreach(const Tile* t, usedTiles) {
-            p.drawPixmap(t->r, t->pm);
-            if (t->pageNo < minPage)
-                  minPage = t->pageNo;
-            if (t->pageNo > maxPage)
-                  maxPage = t->pageNo;
+      //
+      // prefetch the ring of tiles around the visible ones
+      //
+      for (int y = y1 - 1; y <= y2 && budget >= cost; ++y) {
+            for (int x = x1 - 1; x <= x2 && budget >= cost; ++x) {
+                  if (y >= y1 && y < y2 && x >= x1 && x < x2)
+                        continue;
+                  int no = nx * y + x;
+                  if (x < 0 || y < 0 || x >= nx || y >= ny || no >= maxTiles)
+                        continue;
+                  OmrTileKey key(x / hTiles, x % hTiles, y, level);
+                  budget -= cost;
+                  if (needTile(key))
+                        requests.append(key);
+                  }
             }
+      tileRequests = requests;
+      startTile();
+
       for (int pageNo = minPage; pageNo <= maxPage; ++pageNo) {
             OmrPage* page = _omr->page(pageNo);
             p.save();
@@ -323,8 +464,8 @@ void OmrView::zoom(int step, const QPoint& pos)
             }
       if (_scale > 16.0)
             _scale = 16.0;
-      else if (_scale < 0.05)
-            _scale = 0.05;
+      else if (_scale < MIN_MAG)
+            _scale = MIN_MAG;
       setMag(_scale);
 
       QPointF p2 = imatrix.map(QPointF(pos));
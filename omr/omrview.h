@@ -29,17 +29,37 @@ class ScoreView;
 class OmrPage;
 
 //---------------------------------------------------------
-//   Tile
+//   OmrTileKey
+//    tile x, y of page, scaled down by level
 //---------------------------------------------------------
 
-struct Tile {
-      int no;
-      QRect r;
-      QPixmap pm;
-      OmrPage* page;
-      int pageNo;
+struct OmrTileKey {
+      int page;
+      int x;
+      int y;
+      int level;        // 1, 2, 4 or 8
+
+      OmrTileKey() : page(0), x(0), y(0), level(1) {}
+      OmrTileKey(int p, int tx, int ty, int l) : page(p), x(tx), y(ty), level(l) {}
+      bool operator==(const OmrTileKey& k) const {
+            return page == k.page && x == k.x && y == k.y && level == k.level;
+            }
+      };
+
+inline uint qHash(const OmrTileKey& k)
+      {
+      return ((uint(k.page) * 31 + uint(k.x)) * 31 + uint(k.y)) * 31 + uint(k.level);
+      }
+
+//---------------------------------------------------------
+//   OmrTile
+//    a tile converted by the worker thread
+//---------------------------------------------------------
 
-      Tile();
+struct OmrTile {
+      OmrTileKey key;
+      QImage image;
+      int generation;
       };
 
 static const int TILE_H = 512;
@@ -54,9 +74,16 @@ class OmrView : public QWidget {
       Omr* _omr;
       ScoreView* _scoreView;
       int maxTiles;
-
-      QList<Tile*> usedTiles;
-      QStack<Tile*> freeTiles;
+      int hTiles;                         // tiles per page row
+
+      QCache<OmrTileKey, QPixmap> tiles;  // least recently used tiles are dropped first
+      QList<OmrTileKey> tileRequests;     // visible tiles first, then neighbours
+      QFutureWatcher<OmrTile> tileWatcher;
+      OmrTileKey runningTile;             // converted by tileWatcher
+      int tileGeneration;                 // results of an older generation are dropped
+      QSet<OmrTileKey> finishedTiles;     // converted since the view last moved
+      QRect tilePass;                     // tiles of the view when finishedTiles was cleared
+      int tilePassLevel;
       QPoint startDrag;
 
       QTransform _matrix;
@@ -77,11 +104,19 @@ class OmrView : public QWidget {
       virtual void mouseMoveEvent(QMouseEvent*);
       virtual void wheelEvent(QWheelEvent*);
       virtual void paintEvent(QPaintEvent*);
+      virtual void resizeEvent(QResizeEvent*);
       virtual void contextMenuEvent(QContextMenuEvent*);
 
       qreal mag() const { return _matrix.m11(); }
       void setMag(double mag);
-      void initTile(Tile* t);
+      int tileLevel() const;
+      void resizeTilePool();
+      const QPixmap* tile(const OmrTileKey&);
+      bool needTile(const OmrTileKey&) const;
+      void startTile();
+
+   private slots:
+      void tileFinished();
 
    public slots:
       void setScale(double);
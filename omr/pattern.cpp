@@ -63,6 +63,85 @@ double Pattern::match(const Pattern* a) const
       return 1.0 - (double(k) / (h() * w()));
       }
 
+//---------------------------------------------------------
+//   rowBits
+//    64 pixels of a 1 bit LSB scan line starting at pixel
+//    pos; pixels outside of 0..width-1 are zero
+//---------------------------------------------------------
+
+static inline quint64 rowBits(const uint* row, int width, int pos)
+      {
+      if (pos >= width || pos <= -64)
+            return 0;
+      int words = (width + 31) / 32;
+      int q     = pos >> 5;
+      int s     = pos & 31;
+      quint64 w0 = (q >= 0 && q < words) ? row[q] : 0;
+      quint64 w1 = (q + 1 >= 0 && q + 1 < words) ? row[q + 1] : 0;
+      quint64 v  = w0 | (w1 << 32);
+      if (s) {
+            quint64 w2 = (q + 2 >= 0 && q + 2 < words) ? row[q + 2] : 0;
+            v = (v >> s) | (w2 << (64 - s));
+            }
+      if (pos < 0)
+            v &= ~quint64(0) << -pos;
+      int valid = width - pos;
+      if (valid < 64)
+            v &= (quint64(1) << valid) - 1;
+      return v;
+      }
+
+//---------------------------------------------------------
+//   matchRow
+//    match the pattern against img at every x position in
+//    x1..x2-1 with top row y, working on the packed image
+//    rows in 64 bit words; scores[x - x1] is the same as
+//    match() of a Pattern copied from img at x, y
+//---------------------------------------------------------
+
+void Pattern::matchRow(const QImage* img, int x1, int x2, int y, double* scores) const
+      {
+      int pw     = w();
+      int ph     = h();
+      int chunks = (pw + 63) / 64;
+      int iw     = img->width();
+      int ih     = img->height();
+
+      QVector<quint64> pattern(ph * chunks);
+      for (int row = 0; row < ph; ++row) {
+            const uint* p = (const uint*)_image.scanLine(row);
+            for (int c = 0; c < chunks; ++c)
+                  pattern[row * chunks + c] = rowBits(p, pw, c * 64);
+            }
+      quint64 lastMask = (pw % 64) ? (quint64(1) << (pw % 64)) - 1 : ~quint64(0);
+
+      // match() counts the padding of the last 32 bit word
+      // as matching pixels
+      int overscan = (((pw + 31) / 32) * 32 - pw) * ph;
+      double n     = double(pw * ph);
+
+      for (int x = x1; x < x2; ++x) {
+            int k = 0;
+            const quint64* pp = pattern.constData();
+            for (int row = 0; row < ph; ++row) {
+                  int yy = y + row;
+                  if (yy < 0 || yy >= ih) {
+                        for (int c = 0; c < chunks; ++c)
+                              k += __builtin_popcountll(*pp++);
+                        continue;
+                        }
+                  const uint* ip = (const uint*)img->scanLine(yy);
+                  for (int c = 0; c < chunks; ++c) {
+                        quint64 v = rowBits(ip, iw, x + c * 64);
+                        if (c == chunks - 1)
+                              v &= lastMask;
+                        k += __builtin_popcountll(v ^ *pp++);
+                        }
+                  }
+            scores[x - x1] = 1.0 - (double(k - overscan) / n);
+            }
+      }
+
 //---------------------------------------------------------
 //   Pattern
 //    create a Pattern from symbol
@@ -41,6 +41,7 @@ class Pattern {
       Pattern(QImage*, int, int, int, int);
 
       double match(const Pattern*) const;
+      void matchRow(const QImage* img, int x1, int x2, int y, double* scores) const;
       void dump() const;
       const QImage* image() const { return &_image; }
       int w() const { return _image.width(); }
@@ -57,8 +57,11 @@ MasterSynthesizer::MasterSynthesizer()
       _synthesizer.reserve(4);
       _gain = 1.0;
       _masterTuning = 440.0;
-      for (int i = 0; i < MAX_EFFECTS; ++i)
+      _profiling = false;
+      for (int i = 0; i < MAX_EFFECTS; ++i) {
             _effect[i] = 0;
+            _effectTime[i] = 0;
+            }
       }
 
 //---------------------------------------------------------
@@ -201,6 +204,7 @@ Synthesizer* MasterSynthesizer::synthesizer(const QString& name)
 void MasterSynthesizer::registerSynthesizer(Synthesizer* s)
       {
       _synthesizer.push_back(s);
+      _synthTime.push_back(0);
       }
 
 //---------------------------------------------------------
@@ -273,25 +277,87 @@ void MasterSynthesizer::process(unsigned n, float* p)
             lock1 = false;
             return;
             }
+      if (_profiling)
+            processProfiled(n, p);
+      else {
+            for (Synthesizer* s : _synthesizer) {
+                  if (s->active())
+                        s->process(n, p, effect1Buffer, effect2Buffer);
+                  }
+            if (_effect[0] && _effect[1]) {
+                  memset(effect1Buffer, 0, n * sizeof(float) * 2);
+                  _effect[0]->process(n, p, effect1Buffer);
+                  _effect[1]->process(n, effect1Buffer, p);
+                  }
+            else if (_effect[0] || _effect[1]) {
+                  memcpy(effect1Buffer, p, n * sizeof(float) * 2);
+                  if (_effect[0])
+                        _effect[0]->process(n, effect1Buffer, p);
+                  else
+                        _effect[1]->process(n, effect1Buffer, p);
+                  }
+            }
+      for (unsigned i = 0; i < n * 2; ++i)
+            *p++ *= _gain;
+      lock1 = false;
+      }
+
+//---------------------------------------------------------
+//   processProfiled
+//    same as process() but accumulates the time spent
+//    in every synthesizer and effect
+//---------------------------------------------------------
+
+void MasterSynthesizer::processProfiled(unsigned n, float* p)
+      {
+      QElapsedTimer t;
+      int idx = 0;
       for (Synthesizer* s : _synthesizer) {
-            if (s->active())
+            if (s->active()) {
+                  t.start();
                   s->process(n, p, effect1Buffer, effect2Buffer);
+                  _synthTime[idx] += t.nsecsElapsed();
+                  }
+            ++idx;
             }
       if (_effect[0] && _effect[1]) {
             memset(effect1Buffer, 0, n * sizeof(float) * 2);
+            t.start();
             _effect[0]->process(n, p, effect1Buffer);
+            _effectTime[0] += t.nsecsElapsed();
+            t.start();
             _effect[1]->process(n, effect1Buffer, p);
+            _effectTime[1] += t.nsecsElapsed();
             }
       else if (_effect[0] || _effect[1]) {
+            int ab = _effect[0] ? 0 : 1;
             memcpy(effect1Buffer, p, n * sizeof(float) * 2);
-            if (_effect[0])
-                  _effect[0]->process(n, effect1Buffer, p);
-            else
-                  _effect[1]->process(n, effect1Buffer, p);
+            t.start();
+            _effect[ab]->process(n, effect1Buffer, p);
+            _effectTime[ab] += t.nsecsElapsed();
             }
-      for (unsigned i = 0; i < n * 2; ++i)
-            *p++ *= _gain;
-      lock1 = false;
+      }
+
+//---------------------------------------------------------
+//   setProfiling
+//---------------------------------------------------------
+
+void MasterSynthesizer::setProfiling(bool val)
+      {
+      _profiling = val;
+      resetProfile();
+      }
+
+//---------------------------------------------------------
+//   resetProfile
+//---------------------------------------------------------
+
+void MasterSynthesizer::resetProfile()
+      {
+      for (qint64& t : _synthTime)
+            t = 0;
+      for (int i = 0; i < MAX_EFFECTS; ++i)
+            _effectTime[i] = 0;
       }
 
 //---------------------------------------------------------
@@ -49,9 +49,14 @@ class MasterSynthesizer : public QObject {
 
       float _sampleRate;
 
+      bool _profiling;
+      std::vector<qint64> _synthTime;           // accumulated process() time in ns
+      qint64 _effectTime[MAX_EFFECTS];
+
       float effect1Buffer[MAX_BUFFERSIZE];
       float effect2Buffer[MAX_BUFFERSIZE];
       int indexOfEffect(int ab, const QString& name);
+      void processProfiled(unsigned, float*);
 
    public slots:
       void sfChanged() { emit soundFontChanged(); }
@@ -87,7 +92,7 @@ class MasterSynthesizer : public QObject {
 
       Synthesizer* synthesizer(const QString& name);
       const std::vector<Effect*>& effectList(int ab) const { return _effectList[ab]; }
-      const std::vector<Synthesizer*> synthesizer() const { return _synthesizer; }
+      const std::vector<Synthesizer*>& synthesizer() const { return _synthesizer; }
       void registerEffect(int ab, Effect*);
 
       void reset();
@@ -99,6 +104,12 @@ class MasterSynthesizer : public QObject {
       int indexOfEffect(int ab);
 
       float gain() const    { return _gain; }
+
+      void setProfiling(bool val);
+      bool profiling() const                  { return _profiling; }
+      void resetProfile();
+      qint64 synthesizerTime(int idx) const   { return _synthTime[idx];  }
+      qint64 effectTime(int ab) const         { return _effectTime[ab];  }
       };
 
 }
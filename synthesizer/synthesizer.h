@@ -69,6 +69,14 @@ class Synthesizer {
       virtual void allNotesOff(int /*channel*/) {}
 
       virtual SynthesizerGui* gui()  { return _gui; }
+
+      // block until sounds generated in the background can be
+      // played; they are in use after the next process() call
+      virtual void waitReady() {}
+
+      // statistics, used by benchmark and telemetry
+      virtual int activeVoiceCount() const { return 0; }
+      virtual int stolenVoiceCount() const { return 0; }
       };
 
 }
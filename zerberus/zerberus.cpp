@@ -96,6 +96,7 @@ void Zerberus::trigger(Channel* channel, int key, int velo, Trigger trigger)
       for (Zone* z : i->zones()) {
             if (z->match(channel, key, velo, trigger)) {
                   if (freeVoices.empty()) {
+                        ++_droppedVoices;
                         qDebug("Zerberus: out of voices...");
                         return;
                         }
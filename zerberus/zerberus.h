@@ -58,6 +58,7 @@ class VoiceFifo {
             return v;
             }
       bool empty() const { return n == 0; }
+      int size() const   { return n; }
       };
 
 //---------------------------------------------------------
@@ -77,6 +78,7 @@ class Zerberus : public QObject, public Ms::Synthesizer {
       Channel* _channel[MAX_CHANNEL];
 
       int allocatedVoices = 0;
+      int _droppedVoices  = 0;
       VoiceFifo freeVoices;
       Voice* activeVoices = 0;
       int _loadProgress = 0;
@@ -123,6 +125,8 @@ class Zerberus : public QObject, public Ms::Synthesizer {
       virtual QStringList soundFonts() const;
 
       virtual Ms::SynthesizerGui* gui();
+      virtual int activeVoiceCount() const { return MAX_VOICES - freeVoices.size(); }
+      virtual int stolenVoiceCount() const { return _droppedVoices; }
       static QFileInfoList sfzFiles();
       };
 